@@ -0,0 +1,218 @@
+/// @file
+/// Contains the handle registry that maps opaque integer handles to objects, checked by generation counters.
+
+#ifndef _HANDLEREGISTRY_H_
+#define _HANDLEREGISTRY_H_
+
+#include <Windows.h>
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+
+
+/// Number of slots of a handle registry, i.e. the maximum number of objects registered at the same time.
+#define HANDLEREGISTRY_SLOTS		1024
+
+
+/// Registry that maps opaque integer handles to objects.
+///
+/// A handle consists of a slot index (lower 16 bits) and the generation of the slot (upper 16 bits). The generation
+/// is incremented whenever an object is removed, so that handles of removed objects are detected as invalid, even if
+/// their slot has been reused meanwhile. Handle 0 is never valid.
+///
+/// Looking up a handle is lock-free: Slot state (generation, closing flag, and number of references) is a single
+/// atomic word. References returned by acquire() keep the object alive; remove() waits until all references have been
+/// released, so that the object can be deleted safely afterwards. The last reference released wakes it.
+///
+/// @tparam	T	Type of the registered objects.
+/// @tparam	N	Number of slots (max. 65535).
+template <class T, size_t N = HANDLEREGISTRY_SLOTS>
+class HandleRegistry
+{
+private:
+	/// Slot state: Generation (bits 63...32), closing flag (bit 31), and number of references (bits 30...0).
+	typedef uint64_t Word;
+
+	static const Word FLAG_CLOSING = 0x80000000ULL;
+	static const Word MASK_REFS = 0x7FFFFFFFULL;
+
+	typedef struct Slot
+	{
+		std::atomic<Word> State;
+		std::atomic<T*> Object;
+
+		/// Signaled when the last reference of a closing slot has been released (see remove()).
+		std::condition_variable Released;
+		std::mutex Mutex;
+
+		/// Releases a reference. Wakes remove() if it has been the last reference of a closing slot.
+		void release()
+		{
+			const Word state = --State;
+			if (!(state & FLAG_CLOSING) || (state & MASK_REFS)) return;
+
+			std::lock_guard<std::mutex> lock(Mutex);
+			Released.notify_all();
+		}
+	} Slot;
+
+	static uint16_t get_state_generation(const Word _state) { return static_cast<uint16_t>(_state >> 32); }
+	static uint32_t get_handle_index(const uint32_t _handle) { return _handle & 0xFFFF; }
+	static uint16_t get_handle_generation(const uint32_t _handle) { return static_cast<uint16_t>(_handle >> 16); }
+
+public:
+	/// Reference to a registered object. Keeps the object alive until released (by destruction).
+	class Ref
+	{
+	public:
+		Ref() : m_slot(NULL), m_object(NULL) {}
+		Ref(const Ref& _other) : m_slot(_other.m_slot), m_object(_other.m_object) { if (m_slot) m_slot->State++; }
+		~Ref() { release(); }
+
+		Ref& operator=(const Ref& _other)
+		{
+			if (this != &_other)
+			{
+				if (_other.m_slot) _other.m_slot->State++;
+				release();
+				m_slot = _other.m_slot;
+				m_object = _other.m_object;
+			}
+			return *this;
+		}
+
+		/// Gets the referenced object.
+		///
+		/// @return	The object, or NULL if the reference is invalid.
+		T * get() const { return m_object; }
+
+		T * operator->() const { return m_object; }
+
+		/// Checks if the reference is valid.
+		explicit operator bool() const { return m_object != NULL; }
+
+	private:
+		friend class HandleRegistry;
+
+		Ref(Slot * _slot, T * _object) : m_slot(_slot), m_object(_object) {}
+
+		void release()
+		{
+			if (m_slot) m_slot->release();
+			m_slot = NULL;
+			m_object = NULL;
+		}
+
+		Slot * m_slot;
+		T * m_object;
+	};
+
+	HandleRegistry()
+	{
+		for (size_t i = 0; i < N; i++)
+		{
+			m_slots[i].State = static_cast<Word>(1) << 32;
+			m_slots[i].Object = NULL;
+			m_free.push_back(N - 1 - i);
+		}
+	}
+
+	/// Registers an object.
+	///
+	/// @param [in]	_object	Object to be registered. Ownership stays with the caller.
+	///
+	/// @return	Handle of the object, or 0 if all slots are in use.
+	uint32_t insert(T * _object)
+	{
+		std::lock_guard<std::mutex> lock(mutex_free);
+
+		if (m_free.empty()) return 0;
+
+		size_t index = m_free.back();
+		m_free.pop_back();
+
+		Slot& slot = m_slots[index];
+		slot.Object = _object;
+
+		return (static_cast<uint32_t>(get_state_generation(slot.State.load())) << 16) | static_cast<uint32_t>(index);
+	}
+
+	/// Looks up a handle, and references its object. Lock-free.
+	///
+	/// @param	_handle	Handle of the object.
+	///
+	/// @return	Reference to the object. Invalid, if the handle is unknown, outdated, or being removed.
+	Ref acquire(const uint32_t _handle)
+	{
+		if (get_handle_index(_handle) >= N) return Ref();
+
+		Slot& slot = m_slots[get_handle_index(_handle)];
+
+		Word state = slot.State.load();
+		do
+		{
+			if (get_state_generation(state) != get_handle_generation(_handle) || (state & FLAG_CLOSING)) return Ref();
+		} while (!slot.State.compare_exchange_weak(state, state + 1));
+
+		T * object = slot.Object.load();
+		if (!object)
+		{
+			slot.release();
+			return Ref();
+		}
+
+		return Ref(&slot, object);
+	}
+
+	/// Unregisters an object. New lookups of the handle fail immediately; the call blocks until all references of the
+	/// object have been released.
+	///
+	/// @remarks	Must not be called while holding a reference of the same handle.
+	///
+	/// @param	_handle	Handle of the object.
+	///
+	/// @return	The object, which can be deleted now, or NULL if the handle is unknown or outdated.
+	T * remove(const uint32_t _handle)
+	{
+		if (get_handle_index(_handle) >= N) return NULL;
+
+		Slot& slot = m_slots[get_handle_index(_handle)];
+
+		// Mark as closing, so that no new references are given out
+		Word state = slot.State.load();
+		do
+		{
+			if (get_state_generation(state) != get_handle_generation(_handle) || (state & FLAG_CLOSING) || !slot.Object.load()) return NULL;
+		} while (!slot.State.compare_exchange_weak(state, state | FLAG_CLOSING));
+
+		// Wait for calls in progress. Checked under the mutex, so that the wakeup of the last release is not missed.
+		{
+			std::unique_lock<std::mutex> lock(slot.Mutex);
+			slot.Released.wait(lock, [&slot] { return !(slot.State.load() & MASK_REFS); });
+		}
+
+		T * object = slot.Object.exchange(NULL);
+
+		// Next generation, skipping 0 so that handle 0 stays invalid
+		uint16_t generation = get_state_generation(slot.State.load()) + 1;
+		if (!generation) generation = 1;
+		slot.State = static_cast<Word>(generation) << 32;
+
+		std::lock_guard<std::mutex> lock(mutex_free);
+		m_free.push_back(get_handle_index(_handle));
+
+		return object;
+	}
+
+private:
+	Slot m_slots[N];
+
+	/// Indices of the free slots.
+	std::vector<size_t> m_free;
+	/// Mutex to protect the free slots. Only used for inserting and removing.
+	std::mutex mutex_free;
+};
+
+#endif /* _HANDLEREGISTRY_H_ */
@@ -0,0 +1,108 @@
+#include "Sequencer.h"
+
+#include <math.h>
+
+
+/// Conversion of [1/min] into [rad/s].
+#define RPM_TO_RADS		(2.0 * 3.14159265358979323846 / 60.0)
+
+
+
+SequencerPlan::SequencerPlan(const DOUBLE _max_accel, const DOUBLE _max_jerk) :
+	m_max_accel(_max_accel),
+	m_max_jerk(_max_jerk)
+{
+}
+
+
+SequencerPlan::~SequencerPlan()
+{
+}
+
+
+void SequencerPlan::compile(const DOUBLE _speeds[], const DOUBLE _accels[], const UINT32 _delays[], const size_t _len)
+{
+	STACK;
+
+	m_steps.clear();
+
+	if (_len == 0 || _len > SEQUENCER_MAX_STEPS)
+		throw SISProtocol::ExceptionGeneric(-1, sformat("Sequence length %u is out of range (1 ... %d).", (UINT32)_len, SEQUENCER_MAX_STEPS));
+
+	// Jerks are computed in one pass without branches, so that the loop is vectorized by the compiler
+	std::vector<DOUBLE> denominators(_len);
+	std::vector<DOUBLE> jerks(_len);
+	for (size_t i = 0; i < _len; i++)
+	{
+		DOUBLE dv = fabs(_speeds[i] - (i ? _speeds[i - 1] : 0)) * RPM_TO_RADS;
+		denominators[i] = _accels[i] * (_delays[i] / 100.0) - dv;
+		jerks[i] = (_accels[i] * _accels[i]) / denominators[i];
+	}
+
+	// Checks, all violations are reported at once
+	std::string failed;
+	for (size_t i = 0; i < _len; i++)
+	{
+		if (_accels[i] <= 0 || _accels[i] > m_max_accel)
+			failed.append(sformat("Step %u: Acceleration %.3f rad/s^2 out of range (0 ... %.3f). ", (UINT32)i + 1, _accels[i], m_max_accel));
+		else if (_delays[i] == 0)
+			failed.append(sformat("Step %u: Delay must be greater than 0 cs. ", (UINT32)i + 1));
+		else if (denominators[i] <= 0)
+			failed.append(sformat("Step %u: Speed %.3f 1/min cannot be reached within %u cs at %.3f rad/s^2. ", (UINT32)i + 1, _speeds[i], _delays[i], _accels[i]));
+		else if (jerks[i] > m_max_jerk)
+			failed.append(sformat("Step %u: Jerk %.3f rad/s^3 exceeds the maximum of %.3f. ", (UINT32)i + 1, jerks[i], m_max_jerk));
+	}
+
+	if (!failed.empty())
+		throw SISProtocol::ExceptionGeneric(-1, sformat("Sequence is infeasible: %s", failed.c_str()));
+
+	m_steps.resize(_len);
+	for (size_t i = 0; i < _len; i++)
+	{
+		m_steps[i].Speed = _speeds[i];
+		m_steps[i].Accel = _accels[i];
+		m_steps[i].Jerk = jerks[i];
+		m_steps[i].Delay = _delays[i];
+		m_steps[i].Mode = stde::sgn<DOUBLE>(_speeds[i]) == 1 ? SEQUENCER_MODE_CW : SEQUENCER_MODE_CCW;
+	}
+}
+
+
+PLCHandshakeStats plc_handshake(SISProtocol * _sis, const USHORT _register, const UINT32 _value, const UINT8 _bit, const bool _state, const UINT32 _timeout, const UINT32 _interval)
+{
+	STACK;
+
+	PLCHandshakeStats stats = { 0 };
+
+	LARGE_INTEGER frequency, t0, t1, t2;
+	QueryPerformanceFrequency(&frequency);
+	double us = 1e6 / frequency.QuadPart;
+
+	QueryPerformanceCounter(&t0);
+	_sis->write_parameter(TGM::SercosParamP, _register, _value);
+	QueryPerformanceCounter(&t1);
+	stats.WriteTime = (t1.QuadPart - t0.QuadPart) * us;
+
+	ULONGLONG deadline = GetTickCount64() + _timeout;
+	for (;;)
+	{
+		UINT32 status;
+
+		QueryPerformanceCounter(&t0);
+		_sis->read_parameter(TGM::SercosParamP, 1410, status);
+		QueryPerformanceCounter(&t2);
+
+		stats.Polls++;
+		double poll = (t2.QuadPart - t0.QuadPart) * us;
+		if (poll > stats.PollMax) stats.PollMax = poll;
+		stats.Latency = (t2.QuadPart - t1.QuadPart) * us;
+
+		if (((status >> _bit) & 1) == (UINT32)_state) return stats;
+
+		if (GetTickCount64() >= deadline)
+			throw SISProtocol::ExceptionGeneric(-1, sformat("PLC handshake timed out: Bit %u of P-0-1410 was not %s within %u ms after writing %u to P-0-%04u (%u reads).",
+				_bit, _state ? "set" : "reset", _timeout, _value, _register, stats.Polls));
+
+		if (_interval) Sleep(_interval);
+	}
+}
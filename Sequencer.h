@@ -0,0 +1,131 @@
+/// @file
+/// Contains the plan compiler for the "Sequencer" drive mode.
+
+#ifndef _SEQUENCER_H_
+#define _SEQUENCER_H_
+
+#include <Windows.h>
+#include <vector>
+#include <string>
+
+#include "debug.h"
+#include "helpers.h"
+#include "SISProtocol.h"
+
+
+/// Maximum number of steps of a sequence. The positioning block lists (P-0-4006 ... P-0-4063) hold 64 elements,
+/// whereas the first element of the mode list (P-0-4019) is occupied by the start mode.
+#define SEQUENCER_MAX_STEPS		63
+
+/// Number of sequence banks for double-buffered operation (see sequencer_write_bank()).
+#define SEQUENCER_BANKS			2
+/// Maximum number of steps per sequence bank. Bank b occupies the list elements b*SEQUENCER_BANK_STEPS+1 ... 
+/// (b+1)*SEQUENCER_BANK_STEPS.
+#define SEQUENCER_BANK_STEPS	(SEQUENCER_MAX_STEPS / SEQUENCER_BANKS)
+
+/// Positioning block mode (P-0-4019) for clockwise rotation.
+#define SEQUENCER_MODE_CW		0b10000100
+/// Positioning block mode (P-0-4019) for counter-clockwise rotation.
+#define SEQUENCER_MODE_CCW		0b10001000
+
+
+/// Default deadline of a PLC handshake in [ms].
+#define SEQUENCER_HANDSHAKE_TIMEOUT		3000
+
+/// Bits of the PLC status register (P-0-1410).
+#define SEQUENCER_STAT_SEQFINISHED		0
+#define SEQUENCER_STAT_CAMTICK			1
+#define SEQUENCER_STAT_DRIVESTOPPED		2
+#define SEQUENCER_STAT_DRIVESTARTED		3
+#define SEQUENCER_STAT_ERROR_T_PARAM	4
+#define SEQUENCER_STAT_RESULT_READ_OK	5
+#define SEQUENCER_STAT_RESULT_SEQ_OK	6
+#define SEQUENCER_STAT_ERROR_T_CAM		7
+
+
+#pragma pack(push,1)
+/// Timing statistics of a PLC handshake (see plc_handshake()). All times in [us].
+typedef struct PLCHandshakeStats
+{
+	/// Number of status reads (P-0-1410).
+	uint32_t Polls;
+	/// Duration of writing the register.
+	double_t WriteTime;
+	/// Time from the register being written until the status bit has been read back. The bit has been set by the PLC
+	/// within the last PollMax of this time at the latest.
+	double_t Latency;
+	/// Longest single status read, i.e. the resolution of Latency.
+	double_t PollMax;
+} PLCHandshakeStats;
+#pragma pack(pop)
+
+
+/// Handshake with the PLC: Writes a global register, and waits for a bit of the PLC status register (P-0-1410).
+///
+/// @param [in]	_sis	 	SIS protocol to be used.
+/// @param [in]	_register	Global register to be written (e.g. 1371 for G1, P-0-1371).
+/// @param [in]	_value   	Value to be written into the register.
+/// @param [in]	_bit	 	Bit of P-0-1410 to be waited for (see SEQUENCER_STAT_*).
+/// @param [in]	_state   	(Optional) State of the bit to be waited for.
+/// @param [in]	_timeout 	(Optional) Deadline in [ms], counted from the register being written.
+/// @param [in]	_interval	(Optional) Interval between status reads in [ms]. 0 reads back-to-back, which gives the
+/// 						lowest latency.
+///
+/// @return	Timing statistics of the handshake.
+///
+/// @exception	SISProtocol::ExceptionGeneric	Thrown if the bit has not reached the state within the deadline.
+PLCHandshakeStats plc_handshake(SISProtocol * _sis, const USHORT _register, const UINT32 _value, const UINT8 _bit, const bool _state = true, const UINT32 _timeout = SEQUENCER_HANDSHAKE_TIMEOUT, const UINT32 _interval = 0);
+
+
+/// Plan compiler for the "Sequencer" drive mode.
+///
+/// Computes the jerk of each step from speed, acceleration and delay, and checks the plan against the limits of the
+/// drive (S-0-0138, S-0-0349) and the list sizes. Compiling does not need any communication with the drive, so that
+/// infeasible plans are rejected before anything is uploaded.
+///
+/// The jerk of a step is the one that reaches the speed of the step within its delay:
+/// @f[
+/// r_i = \frac{a_i^2}{a_i (t_i - t_{i-1}) - |v_i - v_{i-1}|}
+/// @f]
+/// whereas the sequence starts from standstill (@f$v_0 = 0@f$).
+class SequencerPlan
+{
+public:
+	/// Step of the sequence, ready to be uploaded.
+	typedef struct Step
+	{
+		/// Speed in [1/min]. Sign represents the rotation direction.
+		DOUBLE Speed;
+		/// Acceleration in [rad/s^2].
+		DOUBLE Accel;
+		/// Jerk in [rad/s^3].
+		DOUBLE Jerk;
+		/// Delay until the next step in [cs].
+		UINT32 Delay;
+		/// Positioning block mode (P-0-4019): SEQUENCER_MODE_CW, or SEQUENCER_MODE_CCW.
+		UINT32 Mode;
+	} Step;
+
+	/// Constructor.
+	///
+	/// @param	_max_accel	Maximum acceleration in [rad/s^2], as set by S-0-0138.
+	/// @param	_max_jerk 	Maximum jerk in [rad/s^3], as set by S-0-0349.
+	SequencerPlan(const DOUBLE _max_accel, const DOUBLE _max_jerk);
+	/// Destructor.
+	virtual ~SequencerPlan();
+
+	void compile(const DOUBLE _speeds[], const DOUBLE _accels[], const UINT32 _delays[], const size_t _len);
+
+	/// Gets the steps of the last successful compile().
+	///
+	/// @return	The steps.
+	const std::vector<Step>& get_steps() const { return m_steps; }
+
+private:
+	DOUBLE m_max_accel;
+	DOUBLE m_max_jerk;
+
+	std::vector<Step> m_steps;
+};
+
+#endif /* _SEQUENCER_H_ */
@@ -3,25 +3,74 @@
 
 #include "Wrapper.h"
 
-
-DLLEXPORT SISProtocol * DLLCALLCONV init()
+#include <memory>
+#include <set>
+
+
+/// Open API references (see init()).
+static HandleRegistry<SISProtocol> protocols;
+/// Reference to an open SISProtocol, which keeps it alive during a call.
+typedef HandleRegistry<SISProtocol>::Ref SISRef;
+
+/// Commands started by the *_async() functions (see execute_command_async()).
+static HandleRegistry<SISCommand> commands;
+/// Reference to a command, which keeps it alive during a call.
+typedef HandleRegistry<SISCommand>::Ref SISCommandRef;
+
+
+/// Pending batches of parameter writes (see batch_begin()) per API reference.
+static std::map<SISHandle, SISParamSession*> batches;
+/// Mutex to protect the batches.
+static std::mutex mutex_batches;
+/// Running drive monitors (see events_start()) per API reference.
+static std::map<SISHandle, SISMonitor*> monitors;
+/// Mutex to protect the monitors.
+static std::mutex mutex_monitors;
+/// Reactor that samples all attached references (see reactor_attach()). Exists while links are attached.
+static SISReactor * reactor = NULL;
+/// Mutex to protect the reactor.
+static std::mutex mutex_reactor;
+/// Running connection supervisors (see supervisor_start()) per API reference.
+static std::map<SISHandle, SISSupervisor*> supervisors;
+/// Mutex to protect the supervisors.
+static std::mutex mutex_supervisors;
+/// Open speed setpoint channels (see speedcontrol_channel_open()) per API reference.
+static std::map<SISHandle, std::shared_ptr<SISSpeedChannel>> channels;
+/// Mutex to protect the channels.
+static std::mutex mutex_channels;
+/// Running speed profile streamers (see speedcontrol_stream_start()) per API reference.
+static std::map<SISHandle, SISSpeedStreamer*> streamers;
+/// Mutex to protect the streamers.
+static std::mutex mutex_streamers;
+/// Timing of the last trigger (see sequencer_softtrigger()) per API reference.
+static std::map<SISHandle, PLCHandshakeStats> triggers;
+/// Mutex to protect the trigger timings.
+static std::mutex mutex_triggers;
+
+
+DLLEXPORT SISHandle DLLCALLCONV init()
 {
 	SISProtocol * protocol = new SISProtocol();
-	return protocol;
+
+	SISHandle handle = protocols.insert(protocol);
+	if (!handle) delete protocol;
+
+	return handle;
 }
 
 
-DLLEXPORT int32_t DLLCALLCONV open(SISProtocol* ID_ref, const wchar_t* ID_comport, uint32_t ID_combaudrate, ErrHandle ID_err)
+DLLEXPORT int32_t DLLCALLCONV open(SISHandle ID_ref, const wchar_t* ID_comport, uint32_t ID_combaudrate, ErrHandle ID_err)
 {
-	if (!dynamic_cast<SISProtocol*>(ID_ref)) 
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
 		// Return error for wrong reference
 		return set_error(
-			ID_err, sformat("Reference pointing to invalid location '%p'.", ID_ref),
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
 			Err_Invalid_Pointer);
 
 	try
 	{
-		ID_ref->open(ID_comport);
+		sis->open(ID_comport, ID_combaudrate);
 		return Err_NoError;
 	}
 	catch (SISProtocol::ExceptionGeneric &ex)
@@ -35,45 +84,164 @@ DLLEXPORT int32_t DLLCALLCONV open(SISProtocol* ID_ref, const wchar_t* ID_compor
 }
 
 
-DLLEXPORT int32_t DLLCALLCONV close(SISProtocol* ID_ref, ErrHandle ID_err)
+DLLEXPORT int32_t DLLCALLCONV close(SISHandle ID_ref, ErrHandle ID_err)
 {
-	if (!dynamic_cast<SISProtocol*>(ID_ref))
+	// Unregister first, so that further calls with this reference fail. Waits for calls in progress.
+	SISProtocol * protocol = protocols.remove(ID_ref);
+	if (!protocol)
 		// Return error for wrong reference
 		return set_error(
-			ID_err, sformat("Reference pointing to invalid location '%p'.", ID_ref),
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
 			Err_Invalid_Pointer);
 
-	try
+	int32_t result = Err_NoError;
+
+	// Detach from the reactor before the port is closed
+	detach_reactor(protocol);
+
+	// Stop supervising before the port is closed, so that it is not reopened
 	{
-		ID_ref->close();
+		std::lock_guard<std::mutex> lock(mutex_supervisors);
+		delete supervisors[ID_ref];
+		supervisors.erase(ID_ref);
+	}
 
-		delete ID_ref;
-		ID_ref = NULL;
-		return Err_NoError;
+	// Stop monitoring before the port is closed. Released without holding the lock, since callbacks may poll meanwhile.
+	{
+		SISMonitor * monitor = NULL;
+		{
+			std::lock_guard<std::mutex> lock(mutex_monitors);
+
+			std::map<SISHandle, SISMonitor*>::iterator it = monitors.find(ID_ref);
+			if (it != monitors.end())
+			{
+				monitor = it->second;
+				monitors.erase(it);
+			}
+		}
+
+		if (monitor) monitor->release();
+	}
+
+	// Stop streaming before the port is closed
+	{
+		std::lock_guard<std::mutex> lock(mutex_streamers);
+		delete streamers[ID_ref];
+		streamers.erase(ID_ref);
+	}
+
+	try
+	{
+		protocol->close();
 	}
 	catch (SISProtocol::ExceptionGeneric &ex)
 	{
-		return set_error(ID_err, char2str(ex.what()), Err_Block_Close);
+		result = set_error(ID_err, char2str(ex.what()), Err_Block_Close);
 	}
 	catch (CSerial::ExceptionGeneric &ex)
 	{
-		return set_error(ID_err, char2str(ex.what()), Err_Block_Close);
+		result = set_error(ID_err, char2str(ex.what()), Err_Block_Close);
+	}
+
+	// Discard pending batch
+	{
+		std::lock_guard<std::mutex> lock(mutex_batches);
+		delete batches[ID_ref];
+		batches.erase(ID_ref);
+	}
+
+	// Close speed setpoint channel
+	{
+		std::lock_guard<std::mutex> lock(mutex_channels);
+		channels.erase(ID_ref);
+	}
+
+	// Discard trigger timing
+	{
+		std::lock_guard<std::mutex> lock(mutex_triggers);
+		triggers.erase(ID_ref);
+	}
+
+	// The reference is released even if closing the port failed, since it cannot be used anymore
+	delete protocol;
+	return result;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV supervisor_start(SISHandle ID_ref, uint32_t ID_interval, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	if (!ID_interval)
+		return set_error(ID_err, "Keepalive interval must be greater than 0 ms.", Err_Block_OpenByCOM);
+
+	try
+	{
+		std::lock_guard<std::mutex> lock(mutex_supervisors);
+
+		if (supervisors.count(ID_ref))
+			return set_error(ID_err, "Supervising already started. Call supervisor_stop() first.", Err_Block_OpenByCOM);
+
+		SISSupervisor * supervisor = new SISSupervisor(sis.get());
+		supervisors[ID_ref] = supervisor;
+		supervisor->start(ID_interval);
+
+		return Err_NoError;
+	}
+	catch (std::exception &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_OpenByCOM);
+	}
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV supervisor_stop(SISHandle ID_ref, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	// Supervisor is taken over, so that other references are not blocked while the keepalive is joined
+	SISSupervisor * supervisor = NULL;
+	{
+		std::lock_guard<std::mutex> lock(mutex_supervisors);
+
+		std::map<SISHandle, SISSupervisor*>::iterator it = supervisors.find(ID_ref);
+		if (it == supervisors.end()) return Err_NoError;
+
+		supervisor = it->second;
+		supervisors.erase(it);
 	}
+
+	delete supervisor;
+
+	return Err_NoError;
 }
 
 
-DLLEXPORT int32_t DLLCALLCONV sequencer_activate(SISProtocol * ID_ref, ErrHandle ID_err)
+DLLEXPORT int32_t DLLCALLCONV sequencer_activate(SISHandle ID_ref, ErrHandle ID_err)
 {
-	if (!dynamic_cast<SISProtocol*>(ID_ref))
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
 		// Return error for wrong reference
 		return set_error(
-			ID_err, sformat("Reference pointing to invalid location '%p'.", ID_ref),
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
 			Err_Invalid_Pointer);
 
+	invalidate_channel(ID_ref);
+
 	try
 	{
 		// Change mode
-		change_opmode(ID_ref, DRIVEMODE_SEQUENCER);
+		change_opmode(sis.get(), DRIVEMODE_SEQUENCER);
 		
 		return Err_NoError;
 	}
@@ -88,30 +256,31 @@ DLLEXPORT int32_t DLLCALLCONV sequencer_activate(SISProtocol * ID_ref, ErrHandle
 }
 
 
-DLLEXPORT int32_t DLLCALLCONV sequencer_init(SISProtocol * ID_ref, double_t ID_max_accel, double_t ID_max_jerk, ErrHandle ID_err)
+DLLEXPORT int32_t DLLCALLCONV sequencer_init(SISHandle ID_ref, double_t ID_max_accel, double_t ID_max_jerk, ErrHandle ID_err)
 {
-	if (!dynamic_cast<SISProtocol*>(ID_ref))
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
 		// Return error for wrong reference
 		return set_error(
-			ID_err, sformat("Reference pointing to invalid location '%p'.", ID_ref),
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
 			Err_Invalid_Pointer);
 
 	try
 	{
 		// Set required units (preferred scaling, rotary scaling, [rpm])
-		change_units(ID_ref);
+		change_units(sis.get());
 
 		// Max Acceleration (S-0-0138)
-		ID_ref->write_parameter(TGM::SercosParamS, 138, ID_max_accel);
+		sis->write_parameter(TGM::SercosParamS, 138, ID_max_accel);
 
 		// Max Jerk (S-0-0349)
-		ID_ref->write_parameter(TGM::SercosParamS, 349, ID_max_jerk);
+		sis->write_parameter(TGM::SercosParamS, 349, ID_max_jerk);
 
 		// SPS Global Register G1 (P-0-1371) - Reset Read Trigger
-		ID_ref->write_parameter(TGM::SercosParamP, 1371, static_cast<uint32_t>(0));
+		sis->write_parameter(TGM::SercosParamP, 1371, static_cast<uint32_t>(0));
 
 		// SPS Global Register G2 (P-0-1372) - Reset Sequencer Trigger
-		ID_ref->write_parameter(TGM::SercosParamP, 1372, static_cast<uint32_t>(0));
+		sis->write_parameter(TGM::SercosParamP, 1372, static_cast<uint32_t>(0));
 
 		return Err_NoError;
 	}
@@ -126,50 +295,23 @@ DLLEXPORT int32_t DLLCALLCONV sequencer_init(SISProtocol * ID_ref, double_t ID_m
 }
 
 
-DLLEXPORT int32_t DLLCALLCONV sequencer_write(SISProtocol * ID_ref, double_t ID_speeds[], double_t ID_accels[], double_t ID_jerks[], uint32_t ID_delays[], const uint16_t ID_set_length, ErrHandle ID_err)
+DLLEXPORT int32_t DLLCALLCONV sequencer_write(SISHandle ID_ref, double_t ID_speeds[], double_t ID_accels[], double_t ID_jerks[], uint32_t ID_delays[], const uint16_t ID_set_length, ErrHandle ID_err)
 {
-	if (!dynamic_cast<SISProtocol*>(ID_ref))
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
 		// Return error for wrong reference
 		return set_error(
-			ID_err, sformat("Reference pointing to invalid location '%p'.", ID_ref),
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
 			Err_Invalid_Pointer);
 
 	try
 	{
-		ID_ref->write_listelm(TGM::SercosParamP, 4019, 1, static_cast<uint32_t>(0b10000100));
+		sis->write_listelm(TGM::SercosParamP, 4019, 1, static_cast<uint32_t>(SEQUENCER_MODE_CW));
 
-		for (uint16_t i = 0; i < ID_set_length; i++)
-		{
-			// Speed in min^-1 (P-0-4007)
-			ID_ref->write_listelm(TGM::SercosParamP, 4007, i + 1, abs(ID_speeds[i]));
-															   
-			// Acceleration in rad/s^2 (P-0-4008)			   
-			ID_ref->write_listelm(TGM::SercosParamP, 4008, i + 1, ID_accels[i]);
-															   
-			// Deceleration in rad/s^2 (P-0-4063)			   
-			ID_ref->write_listelm(TGM::SercosParamP, 4063, i + 1, ID_accels[i]);
-															   
-			// Jerk in rad/s^3 (P-0-4009)					   
-			ID_ref->write_listelm(TGM::SercosParamP, 4009, i + 1, ID_jerks[i]);
-															   
-			// Mode (P-0-4019)							
-			ID_ref->write_listelm(TGM::SercosParamP, 4019, i + 2, static_cast<uint32_t>(stde::sgn<double_t>(ID_speeds[i]) == 1 ? 0b10000100 : 0b10001000));
-															   
-			// Pos (P-0-4006)								   
-			ID_ref->write_listelm(TGM::SercosParamP, 4006, i + 1, static_cast<uint64_t>(0));
-															   
-			// Wait (P-0-4018)								   
-			ID_ref->write_listelm(TGM::SercosParamP, 4018, i + 1, static_cast<uint64_t>(0));
-															   
-			// Delay (P-0-4063)								   
-			ID_ref->write_listelm(TGM::SercosParamP, 4063, i + 1, static_cast<uint64_t>(0));
-															   
-			// Timers in cs (P-0-1389)						   
-			ID_ref->write_listelm(TGM::SercosParamP, 1389, i + 1, ID_delays[i]);
-		}
+		write_sequence(sis.get(), 0, ID_speeds, ID_accels, ID_jerks, ID_delays, ID_set_length, false);
 
 		// Time triggers for cam (P-0-1370)
-		ID_ref->write_parameter(TGM::SercosParamP, 1370, static_cast<uint32_t>(ID_set_length));
+		sis->write_parameter(TGM::SercosParamP, 1370, static_cast<uint32_t>(ID_set_length));
 
 		return Err_NoError;
 	}
@@ -184,59 +326,123 @@ DLLEXPORT int32_t DLLCALLCONV sequencer_write(SISProtocol * ID_ref, double_t ID_
 }
 
 
-DLLEXPORT int32_t DLLCALLCONV sequencer_softtrigger(SISProtocol * ID_ref, ErrHandle ID_err)
+DLLEXPORT int32_t DLLCALLCONV sequencer_write_bank(SISHandle ID_ref, uint8_t ID_bank, double_t ID_speeds[], double_t ID_accels[], double_t ID_jerks[], uint32_t ID_delays[], const uint16_t ID_set_length, ErrHandle ID_err)
 {
-	if (!dynamic_cast<SISProtocol*>(ID_ref))
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
 		// Return error for wrong reference
 		return set_error(
-			ID_err, sformat("Reference pointing to invalid location '%p'.", ID_ref),
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
 			Err_Invalid_Pointer);
 
+	if (ID_bank >= SEQUENCER_BANKS)
+		return set_error(ID_err, sformat("Sequence bank %u does not exist (0 ... %d).", ID_bank, SEQUENCER_BANKS - 1), Err_Block_SeqWrite);
+
+	if (ID_set_length == 0 || ID_set_length > SEQUENCER_BANK_STEPS)
+		return set_error(ID_err, sformat("Sequence length %u is out of range (1 ... %d).", ID_set_length, SEQUENCER_BANK_STEPS), Err_Block_SeqWrite);
+
 	try
 	{
-		uint32_t qb0stat;
-		int iterations;
+		// Lists keep the elements of the other bank, which might be running meanwhile
+		write_sequence(sis.get(), ID_bank * SEQUENCER_BANK_STEPS, ID_speeds, ID_accels, ID_jerks, ID_delays, ID_set_length, true);
 
-		// FEED DATA:
+		// Step count of the bank (P-0-1374, P-0-1375)
+		sis->write_parameter(TGM::SercosParamP, 1374 + ID_bank, static_cast<uint32_t>(ID_set_length));
 
-		// SPS Global Register G1 (P-0-1371) - Reset Read Trigger
-		ID_ref->write_parameter(TGM::SercosParamP, 1371, static_cast<uint64_t>(0));
+		return Err_NoError;
+	}
+	catch (SISProtocol::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_SeqWrite);
+	}
+	catch (CSerial::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_SeqWrite);
+	}
+}
 
-		// SPS Global Register G2 (P-0-1372) - Reset Sequencer Trigger
-		ID_ref->write_parameter(TGM::SercosParamP, 1372, static_cast<uint64_t>(0));
 
-		// READ CUSTOM DATA ...
+DLLEXPORT int32_t DLLCALLCONV sequencer_select_bank(SISHandle ID_ref, uint8_t ID_bank, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	if (ID_bank >= SEQUENCER_BANKS)
+		return set_error(ID_err, sformat("Sequence bank %u does not exist (0 ... %d).", ID_bank, SEQUENCER_BANKS - 1), Err_Block_SeqWrite);
 
-		iterations = 0;
-		do
-		{
-			// Check status (P-0-1410)
-			ID_ref->read_parameter(TGM::SercosParamP, 1410, qb0stat);
+	try
+	{
+		// SPS Global Register G3 (P-0-1373) - Bank to be started by the next trigger
+		sis->write_parameter(TGM::SercosParamP, 1373, static_cast<uint32_t>(ID_bank));
+
+		return Err_NoError;
+	}
+	catch (SISProtocol::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_SeqWrite);
+	}
+	catch (CSerial::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_SeqWrite);
+	}
+}
 
-			if (iterations > 300) return set_error(ID_err, "RESULT_READ_OK was not set. Input parameters cannot be accepted.", Err_Block_SeqWrite);
-		} while (qb0stat & 0b100000 >> 5);
 
-		// SPS Global Register G1 (P-0-1371) - Set Read Trigger
-		ID_ref->write_parameter(TGM::SercosParamP, 1371, static_cast<uint64_t>(1));
-					
+DLLEXPORT int32_t DLLCALLCONV sequencer_compile(double_t ID_speeds[], double_t ID_accels[], uint32_t ID_delays[], const uint16_t ID_set_length, double_t ID_max_accel, double_t ID_max_jerk, double_t ID_jerks[], ErrHandle ID_err)
+{
+	if (!ID_speeds || !ID_accels || !ID_delays || !ID_jerks)
+		return set_error(ID_err, "Sequence lists must not be NULL.", Err_Block_SeqCompile);
 
-		// TRIGGER:
+	try
+	{
+		SequencerPlan plan(ID_max_accel, ID_max_jerk);
+		plan.compile(ID_speeds, ID_accels, ID_delays, ID_set_length);
 
-		// SPS Global Register G2 (P-0-1372) - Reset Sequencer Trigger
-		ID_ref->write_parameter(TGM::SercosParamP, 1372, static_cast<uint64_t>(0));
+		const std::vector<SequencerPlan::Step>& steps = plan.get_steps();
+		for (size_t i = 0; i < steps.size(); i++) ID_jerks[i] = steps[i].Jerk;
+
+		return Err_NoError;
+	}
+	catch (SISProtocol::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_SeqCompile);
+	}
+}
 
-		// SPS Global Register G2 (P-0-1372) - Set Sequencer Trigger
-		ID_ref->write_parameter(TGM::SercosParamP, 1372, static_cast<uint64_t>(1));
 
-		
-		iterations = 0;
-		do
-		{
-			// Check status (P-0-1410)
-			ID_ref->read_parameter(TGM::SercosParamP, 1410, qb0stat);
+DLLEXPORT int32_t DLLCALLCONV sequencer_softtrigger(SISHandle ID_ref, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	try
+	{
+		// FEED DATA:
+
+		// SPS Global Register G1 (P-0-1371) - Reset Read Trigger, and wait for RESULT_READ_OK of the last trigger to drop
+		plc_handshake(sis.get(), 1371, 0, SEQUENCER_STAT_RESULT_READ_OK, false);
+
+		// SPS Global Register G2 (P-0-1372) - Reset Sequencer Trigger, and wait for bDriveStarted of the last trigger to drop
+		plc_handshake(sis.get(), 1372, 0, SEQUENCER_STAT_DRIVESTARTED, false);
+
+		// SPS Global Register G1 (P-0-1371) - Set Read Trigger, and wait for RESULT_READ_OK
+		plc_handshake(sis.get(), 1371, 1, SEQUENCER_STAT_RESULT_READ_OK);
+
+		// TRIGGER:
+
+		// SPS Global Register G2 (P-0-1372) - Set Sequencer Trigger, and wait for bDriveStarted
+		PLCHandshakeStats stats = plc_handshake(sis.get(), 1372, 1, SEQUENCER_STAT_DRIVESTARTED);
 
-			if (iterations > 300) return set_error(ID_err, "bDriveStarted was not set. Input parameters cannot be accepted.", Err_Block_SeqWrite);
-		} while (qb0stat & 0b1000 >> 3);
+		std::lock_guard<std::mutex> lock(mutex_triggers);
+		triggers[ID_ref] = stats;
 
 		return Err_NoError;
 	}
@@ -250,33 +456,30 @@ DLLEXPORT int32_t DLLCALLCONV sequencer_softtrigger(SISProtocol * ID_ref, ErrHan
 	}
 }
 
-DLLEXPORT int32_t DLLCALLCONV sequencer_hardtrigger(SISProtocol * ID_ref, ErrHandle ID_err)
+DLLEXPORT int32_t DLLCALLCONV sequencer_hardtrigger(SISHandle ID_ref, ErrHandle ID_err)
 {
-	if (!dynamic_cast<SISProtocol*>(ID_ref))
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
 		// Return error for wrong reference
 		return set_error(
-			ID_err, sformat("Reference pointing to invalid location '%p'.", ID_ref),
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
 			Err_Invalid_Pointer);
 
 	try
 	{
-		uint32_t qb0stat;
-
 		// FEED DATA:
 
-		// SPS Global Register G1 (P-0-1371) - Reset Read Trigger
-		ID_ref->write_parameter(TGM::SercosParamP, 1371, static_cast<uint64_t>(0));
+		// SPS Global Register G1 (P-0-1371) - Reset Read Trigger, and wait for RESULT_READ_OK of the last trigger to drop
+		plc_handshake(sis.get(), 1371, 0, SEQUENCER_STAT_RESULT_READ_OK, false);
 
 		// SPS Global Register G2 (P-0-1372) - Reset Sequencer Trigger
-		ID_ref->write_parameter(TGM::SercosParamP, 1372, static_cast<uint64_t>(0));
+		sis->write_parameter(TGM::SercosParamP, 1372, static_cast<uint64_t>(0));
 
-		/// READ CUSTOM DATA
+		// SPS Global Register G1 (P-0-1371) - Set Read Trigger, and wait for RESULT_READ_OK
+		PLCHandshakeStats stats = plc_handshake(sis.get(), 1371, 1, SEQUENCER_STAT_RESULT_READ_OK);
 
-		// SPS Global Register G1 (P-0-1371) - Set Read Trigger
-		ID_ref->write_parameter(TGM::SercosParamP, 1371, static_cast<uint64_t>(1));
-
-		// Check status (P-0-1410)
-		ID_ref->read_parameter(TGM::SercosParamP, 1410, qb0stat); // TODO: Check RESULT_READ_OK bit (0b100000)
+		std::lock_guard<std::mutex> lock(mutex_triggers);
+		triggers[ID_ref] = stats;
 
 		return Err_NoError;
 	}
@@ -291,21 +494,22 @@ DLLEXPORT int32_t DLLCALLCONV sequencer_hardtrigger(SISProtocol * ID_ref, ErrHan
 }
 
 
-DLLEXPORT int32_t DLLCALLCONV sequencer_getstatus(SISProtocol * ID_ref, uint16_t * ID_status, ErrHandle ID_err)
+DLLEXPORT int32_t DLLCALLCONV sequencer_handshake(SISHandle ID_ref, uint16_t ID_register, uint32_t ID_value, uint8_t ID_bit, uint8_t ID_state, uint32_t ID_timeout, uint32_t ID_interval, PLCHandshakeStats * ID_stats, ErrHandle ID_err)
 {
-	if (!dynamic_cast<SISProtocol*>(ID_ref))
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
 		// Return error for wrong reference
 		return set_error(
-			ID_err, sformat("Reference pointing to invalid location '%p'.", ID_ref),
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
 			Err_Invalid_Pointer);
 
+	if (ID_bit > 31)
+		return set_error(ID_err, sformat("Bit %u of P-0-1410 does not exist (0 ... 31).", ID_bit), Err_Block_SeqWrite);
+
 	try
 	{
-		uint32_t plc_status;
-		// PLC register / Status value (P-0-1410)
-		ID_ref->read_parameter(TGM::SercosParamP, 1410, plc_status);
-
-		*ID_status = static_cast<uint16_t>(plc_status & 0xFFFF);
+		PLCHandshakeStats stats = plc_handshake(sis.get(), ID_register, ID_value, ID_bit, ID_state != 0, ID_timeout, ID_interval);
+		if (ID_stats) *ID_stats = stats;
 
 		return Err_NoError;
 	}
@@ -320,18 +524,63 @@ DLLEXPORT int32_t DLLCALLCONV sequencer_getstatus(SISProtocol * ID_ref, uint16_t
 }
 
 
-DLLEXPORT int32_t DLLCALLCONV speedcontrol_activate(SISProtocol * ID_ref, ErrHandle ID_err)
+DLLEXPORT int32_t DLLCALLCONV sequencer_gettriggertiming(SISHandle ID_ref, PLCHandshakeStats * ID_stats, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	if (!ID_stats)
+		return set_error(ID_err, "Statistics pointing to invalid location.", Err_Invalid_Pointer);
+
+	std::lock_guard<std::mutex> lock(mutex_triggers);
+	auto trigger = triggers.find(ID_ref);
+	if (trigger == triggers.end())
+		return set_error(ID_err, "No trigger has been executed yet.", Err_Block_SeqWrite);
+
+	*ID_stats = trigger->second;
+	return Err_NoError;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV sequencer_getstatus(SISHandle ID_ref, uint16_t * ID_status, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	uint32_t plc_status;
+	// PLC register / Status value (P-0-1410)
+	SISResult result = sis->try_read_parameter(TGM::SercosParamP, 1410, plc_status);
+	if (!result.ok()) return set_result(ID_err, result, Err_Block_SeqWrite);
+
+	*ID_status = static_cast<uint16_t>(plc_status & 0xFFFF);
+
+	return Err_NoError;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV speedcontrol_activate(SISHandle ID_ref, ErrHandle ID_err)
 {
-	if (!dynamic_cast<SISProtocol*>(ID_ref))
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
 		// Return error for wrong reference
 		return set_error(
-			ID_err, sformat("Reference pointing to invalid location '%p'.", ID_ref),
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
 			Err_Invalid_Pointer);
 
+	invalidate_channel(ID_ref);
+
 	try
 	{
 		// Change mode
-		change_opmode(ID_ref, DRIVEMODE_SPEEDCONTROL);
+		change_opmode(sis.get(), DRIVEMODE_SPEEDCONTROL);
 
 		return Err_NoError;
 	}
@@ -346,24 +595,27 @@ DLLEXPORT int32_t DLLCALLCONV speedcontrol_activate(SISProtocol * ID_ref, ErrHan
 }
 
 
-DLLEXPORT int32_t DLLCALLCONV speedcontrol_init(SISProtocol * ID_ref, double_t ID_max_accel, double_t ID_max_jerk, ErrHandle ID_err)
+DLLEXPORT int32_t DLLCALLCONV speedcontrol_init(SISHandle ID_ref, double_t ID_max_accel, double_t ID_max_jerk, ErrHandle ID_err)
 {
-	if (!dynamic_cast<SISProtocol*>(ID_ref))
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
 		// Return error for wrong reference
 		return set_error(
-			ID_err, sformat("Reference pointing to invalid location '%p'.", ID_ref),
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
 			Err_Invalid_Pointer);
 
+	invalidate_channel(ID_ref);
+
 	try
 	{
 		// Set required units (preferred scaling, rotary scaling, [rpm])
-		change_units(ID_ref);
+		change_units(sis.get());
 
 		// Max Acceleration (S-0-0138)
-		ID_ref->write_parameter(TGM::SercosParamS, 138, ID_max_accel);
+		sis->write_parameter(TGM::SercosParamS, 138, ID_max_accel);
 
 		// Max Jerk (S-0-0349)
-		ID_ref->write_parameter(TGM::SercosParamS, 349, ID_max_jerk);
+		sis->write_parameter(TGM::SercosParamS, 349, ID_max_jerk);
 
 		return Err_NoError;
 	}
@@ -378,209 +630,281 @@ DLLEXPORT int32_t DLLCALLCONV speedcontrol_init(SISProtocol * ID_ref, double_t I
 }
 
 
-DLLEXPORT int32_t DLLCALLCONV speedcontrol_write(SISProtocol * ID_ref, double_t ID_speed, double_t ID_accel, ErrHandle ID_err)
+DLLEXPORT int32_t DLLCALLCONV speedcontrol_write(SISHandle ID_ref, double_t ID_speed, double_t ID_accel, ErrHandle ID_err)
 {
-	if (!dynamic_cast<SISProtocol*>(ID_ref))
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
 		// Return error for wrong reference
 		return set_error(
-			ID_err, sformat("Reference pointing to invalid location '%p'.", ID_ref),
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
 			Err_Invalid_Pointer);
 
-	try
-	{
-		// Rotation direction - Positive ID_speed: Clockwise rotation, Negative ID_speed: Counter-clockwise rotation
-		uint32_t rotmode = static_cast<uint32_t>((stde::sgn<double_t>(ID_speed) == 1 ? 0 : 1) << 10);
-		// Control Mode (P-0-1200)
-		ID_ref->write_parameter(TGM::SercosParamP, 1200, rotmode);
+	invalidate_channel(ID_ref);
 
-		// Acceleration in rad/s^2 (P-0-1203)
-		ID_ref->write_parameter(TGM::SercosParamP, 1203, ID_accel);
+	// Setpoints overtake polls and bulk transfers waiting for the link
+	SISPriorityScope priority(SISPriority_Setpoint);
 
-		// Speed in rpm (S-0-0036)
-		ID_ref->write_parameter(TGM::SercosParamS, 36, abs(ID_speed));
+	// Rotation direction - Positive ID_speed: Clockwise rotation, Negative ID_speed: Counter-clockwise rotation
+	uint32_t rotmode = static_cast<uint32_t>((stde::sgn<double_t>(ID_speed) == 1 ? 0 : 1) << 10);
+	// Control Mode (P-0-1200)
+	SISResult result = sis->try_write_parameter(TGM::SercosParamP, 1200, rotmode);
 
-		return Err_NoError;
-	}
-	catch (SISProtocol::ExceptionGeneric &ex)
-	{
-		return set_error(ID_err, char2str(ex.what()), Err_Block_VelCWrite);
-	}
-	catch (CSerial::ExceptionGeneric &ex)
-	{
-		return set_error(ID_err, char2str(ex.what()), Err_Block_VelCWrite);
-	}
+	// Acceleration in rad/s^2 (P-0-1203)
+	if (result.ok()) result = sis->try_write_parameter(TGM::SercosParamP, 1203, ID_accel);
+
+	// Speed in rpm (S-0-0036)
+	if (result.ok()) result = sis->try_write_parameter(TGM::SercosParamS, 36, abs(ID_speed));
+
+	return set_result(ID_err, result, Err_Block_VelCWrite);
 }
 
 
-DLLEXPORT int32_t DLLCALLCONV set_stdenvironment(SISProtocol * ID_ref, ErrHandle ID_err)
+DLLEXPORT int32_t DLLCALLCONV speedcontrol_channel_open(SISHandle ID_ref, ErrHandle ID_err)
 {
-	if (!dynamic_cast<SISProtocol*>(ID_ref))
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
 		// Return error for wrong reference
 		return set_error(
-			ID_err, sformat("Reference pointing to invalid location '%p'.", ID_ref),
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
 			Err_Invalid_Pointer);
 
 	try
 	{
-		change_units(ID_ref);
-		change_language(ID_ref);
+		std::shared_ptr<SISSpeedChannel> channel = std::make_shared<SISSpeedChannel>(sis.get());
+
+		std::lock_guard<std::mutex> lock(mutex_channels);
+		channels[ID_ref] = channel;
 
 		return Err_NoError;
 	}
 	catch (SISProtocol::ExceptionGeneric &ex)
 	{
-		return set_error(ID_err, char2str(ex.what()), Err_Block_GetStatus);
+		return set_error(ID_err, char2str(ex.what()), Err_Block_VelCInit);
 	}
 	catch (CSerial::ExceptionGeneric &ex)
 	{
-		return set_error(ID_err, char2str(ex.what()), Err_Block_GetStatus);
+		return set_error(ID_err, char2str(ex.what()), Err_Block_VelCInit);
 	}
 }
 
 
-DLLEXPORT int32_t DLLCALLCONV get_drivemode(SISProtocol * ID_ref, uint32_t * ID_drvmode, ErrHandle ID_err)
+DLLEXPORT int32_t DLLCALLCONV speedcontrol_channel_write(SISHandle ID_ref, double_t ID_speed, double_t ID_accel, ErrHandle ID_err)
 {
-	if (!dynamic_cast<SISProtocol*>(ID_ref))
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
 		// Return error for wrong reference
 		return set_error(
-			ID_err, sformat("Reference pointing to invalid location '%p'.", ID_ref),
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
 			Err_Invalid_Pointer);
 
-	try
+	// Channel is shared, so that other references are not blocked while writing
+	std::shared_ptr<SISSpeedChannel> channel;
 	{
-		uint64_t curdrvmode;
-		// Primary Operation Mode (S-0-0032)
-		ID_ref->read_parameter(TGM::SercosParamS, 32, curdrvmode);
+		std::lock_guard<std::mutex> lock(mutex_channels);
 
-		switch (curdrvmode)
-		{
-		case DRIVEMODE_SEQUENCER: // Drive Mode: Sequencer
-			*ID_drvmode = 1;
-			break;
-		case DRIVEMODE_SPEEDCONTROL: // Drive Mode: Speed Control
-			*ID_drvmode = 2;
-			break;
-		default: // Drive Mode not supported
-			*ID_drvmode = 0;
-			break;
-		}
+		std::map<SISHandle, std::shared_ptr<SISSpeedChannel>>::iterator it = channels.find(ID_ref);
+		if (it == channels.end())
+			return set_error(ID_err, "No speed setpoint channel opened. Call speedcontrol_channel_open() first.", Err_Block_VelCWrite);
+
+		channel = it->second;
+	}
+
+	try
+	{
+		channel->write(ID_speed, ID_accel);
 
 		return Err_NoError;
 	}
 	catch (SISProtocol::ExceptionGeneric &ex)
 	{
-		return set_error(ID_err, char2str(ex.what()), Err_Block_GetStatus);
+		return set_error(ID_err, char2str(ex.what()), Err_Block_VelCWrite);
 	}
 	catch (CSerial::ExceptionGeneric &ex)
 	{
-		return set_error(ID_err, char2str(ex.what()), Err_Block_GetStatus);
+		return set_error(ID_err, char2str(ex.what()), Err_Block_VelCWrite);
 	}
 }
 
 
-DLLEXPORT int32_t DLLCALLCONV get_opstate(SISProtocol * ID_ref, uint8_t * ID_opstate, ErrHandle ID_err)
+DLLEXPORT int32_t DLLCALLCONV speedcontrol_channel_close(SISHandle ID_ref, ErrHandle ID_err)
 {
-	if (!dynamic_cast<SISProtocol*>(ID_ref))
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
 		// Return error for wrong reference
 		return set_error(
-			ID_err, sformat("Reference pointing to invalid location '%p'.", ID_ref),
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
 			Err_Invalid_Pointer);
 
-	try
+	std::lock_guard<std::mutex> lock(mutex_channels);
+	channels.erase(ID_ref);
+
+	return Err_NoError;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV speedcontrol_stream_start(SISHandle ID_ref, uint32_t ID_period, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	invalidate_channel(ID_ref);
+
+	// Placeholder reserves the reference while the streamer is started, so that concurrent starts fail
 	{
-		uint64_t curopstate;
-		// Device control: Status word (P-0-0115)
-		ID_ref->read_parameter(TGM::SercosParamP, 115, curopstate);
+		std::lock_guard<std::mutex> lock(mutex_streamers);
 
-		OPSTATE opstate(static_cast<uint16_t>(curopstate));
-		*ID_opstate = opstate.Value;
+		if (streamers.count(ID_ref))
+			return set_error(ID_err, "Streaming already started. Call speedcontrol_stream_stop() first.", Err_Block_VelCInit);
 
-		return Err_NoError;
+		streamers[ID_ref] = NULL;
+	}
+
+	SISSpeedStreamer * streamer = new SISSpeedStreamer(sis.get());
+	int32_t ret = Err_NoError;
+	try
+	{
+		streamer->start(ID_period);
 	}
 	catch (SISProtocol::ExceptionGeneric &ex)
 	{
-		return set_error(ID_err, char2str(ex.what()), Err_Block_GetStatus);
+		ret = set_error(ID_err, char2str(ex.what()), Err_Block_VelCInit);
 	}
 	catch (CSerial::ExceptionGeneric &ex)
 	{
-		return set_error(ID_err, char2str(ex.what()), Err_Block_GetStatus);
+		ret = set_error(ID_err, char2str(ex.what()), Err_Block_VelCInit);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_streamers);
+
+		// Placeholder is gone if stopped or closed meanwhile
+		std::map<SISHandle, SISSpeedStreamer*>::iterator it = streamers.find(ID_ref);
+		bool reserved = (it != streamers.end() && !it->second);
+
+		if (reserved && ret == Err_NoError)
+		{
+			it->second = streamer;
+			return Err_NoError;
+		}
+
+		if (reserved)
+			streamers.erase(it);
+		else if (ret == Err_NoError)
+			ret = set_error(ID_err, "Streaming has been stopped while starting.", Err_Block_VelCInit);
 	}
+
+	delete streamer;
+
+	return ret;
 }
 
 
-DLLEXPORT int32_t DLLCALLCONV get_speed(SISProtocol * ID_ref, double_t * ID_speed, ErrHandle ID_err)
+DLLEXPORT int32_t DLLCALLCONV speedcontrol_stream_enqueue(SISHandle ID_ref, uint32_t ID_times[], double_t ID_speeds[], double_t ID_accels[], const uint16_t ID_set_length, ErrHandle ID_err)
 {
-	if (!dynamic_cast<SISProtocol*>(ID_ref))
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
 		// Return error for wrong reference
 		return set_error(
-			ID_err, sformat("Reference pointing to invalid location '%p'.", ID_ref),
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
 			Err_Invalid_Pointer);
 
+	std::lock_guard<std::mutex> lock(mutex_streamers);
+
+	std::map<SISHandle, SISSpeedStreamer*>::iterator it = streamers.find(ID_ref);
+	if (it == streamers.end() || !it->second)
+		return set_error(ID_err, "No streaming started. Call speedcontrol_stream_start() first.", Err_Block_VelCWrite);
+
 	try
 	{
-		double_t speed;
-		// Velocity feedback Value (S-0-0040)
-		ID_ref->read_parameter(TGM::SercosParamS, 40, speed);
-
-		*ID_speed = speed;
+		for (uint16_t i = 0; i < ID_set_length; i++)
+			it->second->enqueue(ID_times[i], ID_speeds[i], ID_accels[i]);
 
 		return Err_NoError;
 	}
 	catch (SISProtocol::ExceptionGeneric &ex)
 	{
-		return set_error(ID_err, char2str(ex.what()), Err_Block_GetStatus);
-	}
-	catch (CSerial::ExceptionGeneric &ex)
-	{
-		return set_error(ID_err, char2str(ex.what()), Err_Block_GetStatus);
+		return set_error(ID_err, char2str(ex.what()), Err_Block_VelCWrite);
 	}
 }
 
 
-DLLEXPORT int32_t DLLCALLCONV get_diagnostic_msg(SISProtocol * ID_ref, char * ID_diagnostic_msg, ErrHandle ID_err)
+DLLEXPORT int32_t DLLCALLCONV speedcontrol_stream_getstats(SISHandle ID_ref, SISStreamStats * ID_stats, ErrHandle ID_err)
 {
-	if (!dynamic_cast<SISProtocol*>(ID_ref))
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
 		// Return error for wrong reference
 		return set_error(
-			ID_err, sformat("Reference pointing to invalid location '%p'.", ID_ref),
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
 			Err_Invalid_Pointer);
 
-	try
-	{
-		char msg[TGM_SIZEMAX_PAYLOAD];
-		// Diagnostic message (S-0-0095)
-		ID_ref->read_parameter(TGM::SercosParamS, 95, msg);
+	if (!ID_stats)
+		return set_error(ID_err, "Statistics pointing to invalid location.", Err_Invalid_Pointer);
 
-		strncpy_s(ID_diagnostic_msg, TGM_SIZEMAX_PAYLOAD - 4, msg + 4, TGM_SIZEMAX_PAYLOAD - 4);
+	std::lock_guard<std::mutex> lock(mutex_streamers);
 
-		return Err_NoError;
-	}
-	catch (SISProtocol::ExceptionGeneric &ex)
-	{
-		return set_error(ID_err, char2str(ex.what()), Err_Block_GetStatus);
-	}
-	catch (CSerial::ExceptionGeneric &ex)
+	std::map<SISHandle, SISSpeedStreamer*>::iterator it = streamers.find(ID_ref);
+	if (it == streamers.end() || !it->second)
+		return set_error(ID_err, "No streaming started. Call speedcontrol_stream_start() first.", Err_Block_VelCWrite);
+
+	std::string error;
+	*ID_stats = it->second->get_stats(error);
+
+	if (!error.empty())
+		return set_error(ID_err, sformat("Streaming stopped: %s", error.c_str()), Err_Block_VelCWrite);
+
+	return Err_NoError;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV speedcontrol_stream_stop(SISHandle ID_ref, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	invalidate_channel(ID_ref);
+
+	// Streamer is taken over, so that other references are not blocked while the streaming thread is joined
+	SISSpeedStreamer * streamer = NULL;
 	{
-		return set_error(ID_err, char2str(ex.what()), Err_Block_GetStatus);
+		std::lock_guard<std::mutex> lock(mutex_streamers);
+
+		std::map<SISHandle, SISSpeedStreamer*>::iterator it = streamers.find(ID_ref);
+		if (it == streamers.end()) return Err_NoError;
+
+		// Placeholder of a start in progress: The starting call discards its streamer
+		streamer = it->second;
+		streamers.erase(it);
 	}
+
+	delete streamer;
+
+	return Err_NoError;
 }
 
 
-DLLEXPORT int32_t DLLCALLCONV get_diagnostic_num(SISProtocol * ID_ref, uint32_t * ID_diagnostic_num, ErrHandle ID_err)
+DLLEXPORT int32_t DLLCALLCONV set_stdenvironment(SISHandle ID_ref, ErrHandle ID_err)
 {
-	if (!dynamic_cast<SISProtocol*>(ID_ref))
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
 		// Return error for wrong reference
 		return set_error(
-			ID_err, sformat("Reference pointing to invalid location '%p'.", ID_ref),
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
 			Err_Invalid_Pointer);
 
+	invalidate_channel(ID_ref);
+
 	try
 	{
-		UINT32 num;
-		// Diagnostic number (S-0-0390)
-		ID_ref->read_parameter(TGM::SercosParamS, 390, num);
-
-		*ID_diagnostic_num = num;
+		change_units(sis.get());
+		change_language(sis.get());
 
 		return Err_NoError;
 	}
@@ -595,33 +919,1181 @@ DLLEXPORT int32_t DLLCALLCONV get_diagnostic_num(SISProtocol * ID_ref, uint32_t
 }
 
 
-DLLEXPORT int32_t DLLCALLCONV clear_error(SISProtocol * ID_ref, ErrHandle ID_err)
+DLLEXPORT int32_t DLLCALLCONV get_drivemode(SISHandle ID_ref, uint32_t * ID_drvmode, ErrHandle ID_err)
 {
-	if (!dynamic_cast<SISProtocol*>(ID_ref))
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
 		// Return error for wrong reference
 		return set_error(
-			ID_err, sformat("Reference pointing to invalid location '%p'.", ID_ref),
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
 			Err_Invalid_Pointer);
 
+	uint64_t curdrvmode;
+	// Primary Operation Mode (S-0-0032)
+	SISResult result = sis->try_read_parameter(TGM::SercosParamS, 32, curdrvmode);
+	if (!result.ok()) return set_result(ID_err, result, Err_Block_GetStatus);
+
+	switch (curdrvmode)
+	{
+	case DRIVEMODE_SEQUENCER: // Drive Mode: Sequencer
+		*ID_drvmode = 1;
+		break;
+	case DRIVEMODE_SPEEDCONTROL: // Drive Mode: Speed Control
+		*ID_drvmode = 2;
+		break;
+	default: // Drive Mode not supported
+		*ID_drvmode = 0;
+		break;
+	}
+
+	return Err_NoError;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV get_opstate(SISHandle ID_ref, uint8_t * ID_opstate, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	uint64_t curopstate;
+	// Device control: Status word (P-0-0115)
+	SISResult result = sis->try_read_parameter(TGM::SercosParamP, 115, curopstate);
+	if (!result.ok()) return set_result(ID_err, result, Err_Block_GetStatus);
+
+	OPSTATE opstate(static_cast<uint16_t>(curopstate));
+	*ID_opstate = opstate.Value;
+
+	return Err_NoError;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV get_speed(SISHandle ID_ref, double_t * ID_speed, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	double_t speed;
+	// Velocity feedback Value (S-0-0040)
+	SISResult result = sis->try_read_parameter(TGM::SercosParamS, 40, speed);
+	if (!result.ok()) return set_result(ID_err, result, Err_Block_GetStatus);
+
+	*ID_speed = speed;
+
+	return Err_NoError;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV get_diagnostic_msg(SISHandle ID_ref, char * ID_diagnostic_msg, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	try
+	{
+		UINT32 num;
+		std::string msg;
+		// Diagnostic message (S-0-0095), re-read only if diagnostic number (S-0-0390) has changed
+		sis->read_diagnostic(num, msg);
+
+		strncpy_s(ID_diagnostic_msg, TGM_SIZEMAX_PAYLOAD - 4, msg.c_str(), TGM_SIZEMAX_PAYLOAD - 4);
+
+		return Err_NoError;
+	}
+	catch (SISProtocol::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_GetStatus);
+	}
+	catch (CSerial::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_GetStatus);
+	}
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV get_diagnostic_num(SISHandle ID_ref, uint32_t * ID_diagnostic_num, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	try
+	{
+		// Diagnostic number (S-0-0390)
+		*ID_diagnostic_num = sis->read_diagnostic_num();
+
+		return Err_NoError;
+	}
+	catch (SISProtocol::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_GetStatus);
+	}
+	catch (CSerial::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_GetStatus);
+	}
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV clear_error(SISHandle ID_ref, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	invalidate_channel(ID_ref);
+
+	try
+	{
+		// Clear error (S-0-0099) // Command C0500
+		sis->execute_command(TGM::SercosParamS, 99);
+
+		return Err_NoError;
+	}
+	catch (SISProtocol::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_GetStatus);
+	}
+	catch (CSerial::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_GetStatus);
+	}
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV get_link_timing(SISHandle ID_ref, SISLinkTiming * ID_timing, uint8_t ID_reset, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	if (!ID_timing)
+		return set_error(ID_err, "Timing pointing to invalid location.", Err_Invalid_Pointer);
+
+	*ID_timing = sis->get_link_timing(ID_reset != 0);
+
+	return Err_NoError;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV get_link_health(SISHandle ID_ref, SISLinkHealth * ID_health, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	if (!ID_health)
+		return set_error(ID_err, "Health pointing to invalid location.", Err_Invalid_Pointer);
+
+	*ID_health = sis->get_link_health();
+
+	return Err_NoError;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV get_link_stats(SISHandle ID_ref, SISLinkStats * ID_stats, uint8_t ID_reset, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	if (!ID_stats)
+		return set_error(ID_err, "Statistics pointing to invalid location.", Err_Invalid_Pointer);
+
+	*ID_stats = sis->get_link_stats(ID_reset != 0);
+
+	return Err_NoError;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV plan_link_budget(SISHandle ID_ref, SISCyclicTask ID_tasks[], uint16_t ID_len, double_t ID_limit, uint8_t ID_sequential, SISLinkBudget * ID_budget, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	if (!ID_tasks)
+		return set_error(ID_err, "Tasks pointing to invalid location.", Err_Invalid_Pointer);
+
+	try
+	{
+		// Data lengths from the (cached) parameter attributes
+		for (uint16_t i = 0; i < ID_len; i++)
+		{
+			if (ID_tasks[i].DataLen) continue;
+
+			TGM::SercosParamVar paramvar = ID_tasks[i].ParamVar ? TGM::SercosParamP : TGM::SercosParamS;
+			ID_tasks[i].DataLen = static_cast<uint8_t>(sis->get_scaling(paramvar, ID_tasks[i].ParamNum).get_datalen());
+		}
+
+		SISLinkPlanner planner(sis->get_baudrate(), ID_sequential != 0);
+		SISLinkBudget budget = planner.plan(ID_tasks, ID_len, ID_limit);
+
+		if (ID_budget) *ID_budget = budget;
+
+		return Err_NoError;
+	}
+	catch (SISProtocol::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_GetStatus);
+	}
+	catch (CSerial::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_GetStatus);
+	}
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV execute_command_async(SISHandle ID_ref, uint8_t ID_paramvar, uint16_t ID_paramnum, SISCommandHandle * ID_cmd, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	if (!ID_cmd)
+		return set_error(ID_err, "Command handle pointing to invalid location.", Err_Invalid_Pointer);
+
+	invalidate_channel(ID_ref);
+
+	try
+	{
+		TGM::SercosParamVar paramvar = ID_paramvar ? TGM::SercosParamP : TGM::SercosParamS;
+
+		SISCommand * cmd = new SISCommand([ID_ref, paramvar, ID_paramnum](SISCommand& cmd)
+		{
+			// Looked up again by the job, so that the reference stays alive while the command is running
+			SISRef sis = protocols.acquire(ID_ref);
+			if (!sis) throw SISProtocol::ExceptionGeneric(-1, sformat("Reference '%u' has been closed.", ID_ref));
+
+			sis->execute_command(paramvar, ID_paramnum, &cmd);
+		});
+
+		return register_command(cmd, ID_cmd, ID_err);
+	}
+	catch (std::exception &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Command);
+	}
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV clear_error_async(SISHandle ID_ref, SISCommandHandle * ID_cmd, ErrHandle ID_err)
+{
+	// Clear error (S-0-0099) // Command C0500
+	return execute_command_async(ID_ref, TGM::SercosParamS, 99, ID_cmd, ID_err);
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV sequencer_activate_async(SISHandle ID_ref, SISCommandHandle * ID_cmd, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	if (!ID_cmd)
+		return set_error(ID_err, "Command handle pointing to invalid location.", Err_Invalid_Pointer);
+
+	invalidate_channel(ID_ref);
+
+	try
+	{
+		SISCommand * cmd = new SISCommand([ID_ref](SISCommand& cmd)
+		{
+			SISRef sis = protocols.acquire(ID_ref);
+			if (!sis) throw SISProtocol::ExceptionGeneric(-1, sformat("Reference '%u' has been closed.", ID_ref));
+
+			change_opmode(sis.get(), DRIVEMODE_SEQUENCER, &cmd);
+		});
+
+		return register_command(cmd, ID_cmd, ID_err);
+	}
+	catch (std::exception &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Command);
+	}
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV speedcontrol_activate_async(SISHandle ID_ref, SISCommandHandle * ID_cmd, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	if (!ID_cmd)
+		return set_error(ID_err, "Command handle pointing to invalid location.", Err_Invalid_Pointer);
+
+	invalidate_channel(ID_ref);
+
+	try
+	{
+		SISCommand * cmd = new SISCommand([ID_ref](SISCommand& cmd)
+		{
+			SISRef sis = protocols.acquire(ID_ref);
+			if (!sis) throw SISProtocol::ExceptionGeneric(-1, sformat("Reference '%u' has been closed.", ID_ref));
+
+			change_opmode(sis.get(), DRIVEMODE_SPEEDCONTROL, &cmd);
+		});
+
+		return register_command(cmd, ID_cmd, ID_err);
+	}
+	catch (std::exception &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Command);
+	}
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV command_getstate(SISCommandHandle ID_cmd, uint8_t * ID_state, ErrHandle ID_err)
+{
+	SISCommandRef cmd = commands.acquire(ID_cmd);
+	if (!cmd)
+		// Return error for wrong handle
+		return set_error(
+			ID_err, sformat("Command handle '%u' is invalid or has been released.", ID_cmd),
+			Err_Invalid_Pointer);
+
+	SISCommand::ECommandState state = cmd->get_state();
+	*ID_state = static_cast<uint8_t>(state);
+
+	if (state == SISCommand::ECommandFailed)
+		return set_error(ID_err, cmd->get_message(), Err_Block_Command);
+
+	return Err_NoError;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV command_wait(SISCommandHandle ID_cmd, uint32_t ID_timeout, uint8_t * ID_state, ErrHandle ID_err)
+{
+	SISCommandRef cmd = commands.acquire(ID_cmd);
+	if (!cmd)
+		// Return error for wrong handle
+		return set_error(
+			ID_err, sformat("Command handle '%u' is invalid or has been released.", ID_cmd),
+			Err_Invalid_Pointer);
+
+	SISCommand::ECommandState state = cmd->wait(ID_timeout);
+	*ID_state = static_cast<uint8_t>(state);
+
+	if (state == SISCommand::ECommandFailed)
+		return set_error(ID_err, cmd->get_message(), Err_Block_Command);
+
+	return Err_NoError;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV command_cancel(SISCommandHandle ID_cmd, ErrHandle ID_err)
+{
+	SISCommandRef cmd = commands.acquire(ID_cmd);
+	if (!cmd)
+		// Return error for wrong handle
+		return set_error(
+			ID_err, sformat("Command handle '%u' is invalid or has been released.", ID_cmd),
+			Err_Invalid_Pointer);
+
+	cmd->cancel();
+
+	return Err_NoError;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV command_release(SISCommandHandle ID_cmd, ErrHandle ID_err)
+{
+	// Handle is invalidated first. Calls in progress with the handle are waited for.
+	SISCommand * cmd = commands.remove(ID_cmd);
+	if (!cmd)
+		// Return error for wrong handle
+		return set_error(
+			ID_err, sformat("Command handle '%u' is invalid or has been released.", ID_cmd),
+			Err_Invalid_Pointer);
+
+	delete cmd;
+
+	return Err_NoError;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV batch_begin(SISHandle ID_ref, uint8_t ID_paramlevel, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	std::lock_guard<std::mutex> lock(mutex_batches);
+
+	// A pending batch that has not been committed is discarded
+	delete batches[ID_ref];
+	batches[ID_ref] = new SISParamSession(sis.get(), ID_paramlevel != 0);
+
+	return Err_NoError;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV batch_write_param(SISHandle ID_ref, uint8_t ID_paramvar, uint16_t ID_paramnum, double_t ID_value, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	std::lock_guard<std::mutex> lock(mutex_batches);
+
+	std::map<SISHandle, SISParamSession*>::iterator it = batches.find(ID_ref);
+	if (it == batches.end() || !it->second)
+		return set_error(ID_err, "No batch started. Call batch_begin() first.", Err_Block_Batch);
+
+	it->second->write_parameter(ID_paramvar ? TGM::SercosParamP : TGM::SercosParamS, ID_paramnum, static_cast<DOUBLE>(ID_value));
+
+	return Err_NoError;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV batch_write_listelm(SISHandle ID_ref, uint8_t ID_paramvar, uint16_t ID_paramnum, uint16_t ID_elm_pos, double_t ID_value, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	std::lock_guard<std::mutex> lock(mutex_batches);
+
+	std::map<SISHandle, SISParamSession*>::iterator it = batches.find(ID_ref);
+	if (it == batches.end() || !it->second)
+		return set_error(ID_err, "No batch started. Call batch_begin() first.", Err_Block_Batch);
+
+	it->second->write_listelm(ID_paramvar ? TGM::SercosParamP : TGM::SercosParamS, ID_paramnum, ID_elm_pos, static_cast<DOUBLE>(ID_value));
+
+	return Err_NoError;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV batch_commit(SISHandle ID_ref, uint16_t * ID_results, uint32_t ID_results_len, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	invalidate_channel(ID_ref);
+
+	// Batch is taken over, so that other references are not blocked while committing
+	SISParamSession * session;
+	{
+		std::lock_guard<std::mutex> lock(mutex_batches);
+
+		std::map<SISHandle, SISParamSession*>::iterator it = batches.find(ID_ref);
+		if (it == batches.end() || !it->second)
+			return set_error(ID_err, "No batch started. Call batch_begin() first.", Err_Block_Batch);
+
+		session = it->second;
+		batches.erase(it);
+	}
+
+	int32_t ret = Err_NoError;
+	try
+	{
+		session->commit();
+	}
+	catch (SISProtocol::ExceptionGeneric &ex)
+	{
+		ret = set_error(ID_err, char2str(ex.what()), Err_Block_Batch);
+	}
+	catch (CSerial::ExceptionGeneric &ex)
+	{
+		ret = set_error(ID_err, char2str(ex.what()), Err_Block_Batch);
+	}
+
+	// Per-item results
+	const std::vector<USHORT>& results = session->get_results();
+	if (ID_results)
+		for (size_t i = 0; i < std::min<size_t>(results.size(), ID_results_len); i++)
+			ID_results[i] = results[i];
+
+	delete session;
+
+	return ret;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV read_params(SISHandle ID_ref, uint8_t ID_paramvars[], uint16_t ID_paramnums[], double_t ID_values[], uint16_t ID_errors[], const uint16_t ID_len, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	if (!ID_paramvars || !ID_paramnums || !ID_values)
+		return set_error(ID_err, "Parameter arrays pointing to invalid location.", Err_Invalid_Pointer);
+
+	try
+	{
+		std::vector<TGM::SercosParamVar> paramvars(ID_len);
+		for (uint16_t i = 0; i < ID_len; i++) paramvars[i] = ID_paramvars[i] ? TGM::SercosParamP : TGM::SercosParamS;
+
+		std::vector<USHORT> errors(ID_len);
+		sis->read_parameters(paramvars.data(), ID_paramnums, ID_values, errors.data(), ID_len);
+
+		// Per-item results
+		std::string failed;
+		for (uint16_t i = 0; i < ID_len; i++)
+		{
+			if (ID_errors) ID_errors[i] = errors[i];
+			if (errors[i]) failed.append(sformat("%c-0-%04u: 0x%04X. ", ID_paramvars[i] ? 'P' : 'S', ID_paramnums[i], errors[i]));
+		}
+
+		if (!failed.empty())
+			return set_error(ID_err, sformat("Reading parameters failed: %s", failed.c_str()), Err_Block_Batch);
+
+		return Err_NoError;
+	}
+	catch (SISProtocol::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Batch);
+	}
+	catch (CSerial::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Batch);
+	}
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV read_params_int(SISHandle ID_ref, uint8_t ID_paramvars[], uint16_t ID_paramnums[], uint64_t ID_values[], uint16_t ID_errors[], const uint16_t ID_len, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	if (!ID_paramvars || !ID_paramnums || !ID_values)
+		return set_error(ID_err, "Parameter arrays pointing to invalid location.", Err_Invalid_Pointer);
+
+	try
+	{
+		std::vector<TGM::SercosParamVar> paramvars(ID_len);
+		for (uint16_t i = 0; i < ID_len; i++) paramvars[i] = ID_paramvars[i] ? TGM::SercosParamP : TGM::SercosParamS;
+
+		std::vector<USHORT> errors(ID_len);
+		sis->read_parameters(paramvars.data(), ID_paramnums, reinterpret_cast<UINT64*>(ID_values), errors.data(), ID_len);
+
+		// Per-item results
+		std::string failed;
+		for (uint16_t i = 0; i < ID_len; i++)
+		{
+			if (ID_errors) ID_errors[i] = errors[i];
+			if (errors[i]) failed.append(sformat("%c-0-%04u: 0x%04X. ", ID_paramvars[i] ? 'P' : 'S', ID_paramnums[i], errors[i]));
+		}
+
+		if (!failed.empty())
+			return set_error(ID_err, sformat("Reading parameters failed: %s", failed.c_str()), Err_Block_Batch);
+
+		return Err_NoError;
+	}
+	catch (SISProtocol::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Batch);
+	}
+	catch (CSerial::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Batch);
+	}
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV write_params(SISHandle ID_ref, uint8_t ID_paramvars[], uint16_t ID_paramnums[], double_t ID_values[], uint16_t ID_errors[], const uint16_t ID_len, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	if (!ID_paramvars || !ID_paramnums || !ID_values)
+		return set_error(ID_err, "Parameter arrays pointing to invalid location.", Err_Invalid_Pointer);
+
+	invalidate_channel(ID_ref);
+
+	// Unlike batch_begin(), the writes are applied in the current communication phase
+	SISParamSession session(sis.get(), false);
+	for (uint16_t i = 0; i < ID_len; i++)
+		session.write_parameter(ID_paramvars[i] ? TGM::SercosParamP : TGM::SercosParamS, ID_paramnums[i], static_cast<DOUBLE>(ID_values[i]));
+
+	int32_t ret = Err_NoError;
+	try
+	{
+		session.commit();
+	}
+	catch (SISProtocol::ExceptionGeneric &ex)
+	{
+		ret = set_error(ID_err, char2str(ex.what()), Err_Block_Batch);
+	}
+	catch (CSerial::ExceptionGeneric &ex)
+	{
+		ret = set_error(ID_err, char2str(ex.what()), Err_Block_Batch);
+	}
+
+	// Per-item results
+	const std::vector<USHORT>& results = session.get_results();
+	if (ID_errors)
+		for (size_t i = 0; i < std::min<size_t>(results.size(), ID_len); i++)
+			ID_errors[i] = results[i];
+
+	return ret;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV write_params_int(SISHandle ID_ref, uint8_t ID_paramvars[], uint16_t ID_paramnums[], uint64_t ID_values[], uint16_t ID_errors[], const uint16_t ID_len, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	if (!ID_paramvars || !ID_paramnums || !ID_values)
+		return set_error(ID_err, "Parameter arrays pointing to invalid location.", Err_Invalid_Pointer);
+
+	invalidate_channel(ID_ref);
+
+	// Unlike batch_begin(), the writes are applied in the current communication phase
+	SISParamSession session(sis.get(), false);
+	for (uint16_t i = 0; i < ID_len; i++)
+		session.write_parameter_raw(ID_paramvars[i] ? TGM::SercosParamP : TGM::SercosParamS, ID_paramnums[i], ID_values[i]);
+
+	int32_t ret = Err_NoError;
+	try
+	{
+		session.commit();
+	}
+	catch (SISProtocol::ExceptionGeneric &ex)
+	{
+		ret = set_error(ID_err, char2str(ex.what()), Err_Block_Batch);
+	}
+	catch (CSerial::ExceptionGeneric &ex)
+	{
+		ret = set_error(ID_err, char2str(ex.what()), Err_Block_Batch);
+	}
+
+	// Per-item results
+	const std::vector<USHORT>& results = session.get_results();
+	if (ID_errors)
+		for (size_t i = 0; i < std::min<size_t>(results.size(), ID_len); i++)
+			ID_errors[i] = results[i];
+
+	return ret;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV events_start(SISHandle ID_ref, uint32_t ID_interval, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	if (!ID_interval)
+		return set_error(ID_err, "Sampling interval must be greater than 0 ms.", Err_Block_Events);
+
+	try
+	{
+		std::lock_guard<std::mutex> lock(mutex_monitors);
+
+		if (monitors.count(ID_ref))
+			return set_error(ID_err, "Monitoring already started. Call events_stop() first.", Err_Block_Events);
+
+		SISMonitor * monitor = new SISMonitor(sis.get());
+		monitors[ID_ref] = monitor;
+		monitor->start(ID_interval);
+
+		return Err_NoError;
+	}
+	catch (std::exception &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Events);
+	}
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV events_stop(SISHandle ID_ref, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	// Monitor is taken over, so that other references are not blocked while the sampler is joined
+	SISMonitor * monitor = NULL;
+	{
+		std::lock_guard<std::mutex> lock(mutex_monitors);
+
+		std::map<SISHandle, SISMonitor*>::iterator it = monitors.find(ID_ref);
+		if (it == monitors.end()) return Err_NoError;
+
+		monitor = it->second;
+		monitors.erase(it);
+	}
+
+	// Deferred if called from within a callback of this monitor
+	monitor->release();
+
+	return Err_NoError;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV events_register(SISHandle ID_ref, SISEventCallback ID_callback, void * ID_user, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	if (!ID_callback)
+		return set_error(ID_err, "Callback pointing to invalid location.", Err_Invalid_Pointer);
+
+	std::lock_guard<std::mutex> lock(mutex_monitors);
+
+	std::map<SISHandle, SISMonitor*>::iterator it = monitors.find(ID_ref);
+	if (it == monitors.end() || !it->second)
+		return set_error(ID_err, "No monitoring started. Call events_start() first.", Err_Block_Events);
+
+	it->second->register_callback(ID_callback, ID_user);
+
+	return Err_NoError;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV events_poll(SISHandle ID_ref, SISEvent * ID_event, uint8_t * ID_available, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	if (!ID_event || !ID_available)
+		return set_error(ID_err, "Event pointing to invalid location.", Err_Invalid_Pointer);
+
+	std::lock_guard<std::mutex> lock(mutex_monitors);
+
+	std::map<SISHandle, SISMonitor*>::iterator it = monitors.find(ID_ref);
+	if (it == monitors.end() || !it->second)
+		return set_error(ID_err, "No monitoring started. Call events_start() first.", Err_Block_Events);
+
+	*ID_available = it->second->poll(*ID_event) ? 1 : 0;
+
+	return Err_NoError;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV reactor_attach(SISHandle ID_ref, const SISReactorParam ID_params[], const uint16_t ID_len, uint32_t ID_interval, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	if (!ID_params)
+		return set_error(ID_err, "Parameters pointing to invalid location.", Err_Invalid_Pointer);
+
+	std::lock_guard<std::mutex> lock(mutex_reactor);
+
 	try
 	{
-		// Clear error (S-0-0099) // Command C0500
-		ID_ref->execute_command(TGM::SercosParamS, 99);
+		if (!reactor) reactor = new SISReactor();
+
+		reactor->attach(sis.get(), std::vector<SISReactorParam>(ID_params, ID_params + ID_len), ID_interval);
 
 		return Err_NoError;
 	}
 	catch (SISProtocol::ExceptionGeneric &ex)
 	{
-		return set_error(ID_err, char2str(ex.what()), Err_Block_GetStatus);
+		if (reactor && !reactor->get_count()) { delete reactor; reactor = NULL; }
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Events);
 	}
 	catch (CSerial::ExceptionGeneric &ex)
 	{
-		return set_error(ID_err, char2str(ex.what()), Err_Block_GetStatus);
+		if (reactor && !reactor->get_count()) { delete reactor; reactor = NULL; }
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Events);
+	}
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV reactor_detach(SISHandle ID_ref, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	detach_reactor(sis.get());
+
+	return Err_NoError;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV reactor_read(SISHandle ID_ref, SISReactorSample ID_samples[], const uint16_t ID_len, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	if (!ID_samples)
+		return set_error(ID_err, "Samples pointing to invalid location.", Err_Invalid_Pointer);
+
+	std::lock_guard<std::mutex> lock(mutex_reactor);
+
+	if (!reactor)
+		return set_error(ID_err, "No link attached. Call reactor_attach() first.", Err_Block_Events);
+
+	try
+	{
+		reactor->read(sis.get(), ID_samples, ID_len);
+
+		return Err_NoError;
+	}
+	catch (SISProtocol::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Events);
+	}
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV scope_configure(SISHandle ID_ref, SISScopeConfig * ID_config, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	if (!ID_config)
+		return set_error(ID_err, "Configuration pointing to invalid location.", Err_Invalid_Pointer);
+
+	try
+	{
+		SISScope(sis.get()).configure(*ID_config);
+
+		return Err_NoError;
+	}
+	catch (SISProtocol::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Scope);
+	}
+	catch (CSerial::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Scope);
+	}
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV scope_arm(SISHandle ID_ref, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	try
+	{
+		SISScope(sis.get()).arm();
+
+		return Err_NoError;
+	}
+	catch (SISProtocol::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Scope);
+	}
+	catch (CSerial::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Scope);
+	}
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV scope_wait(SISHandle ID_ref, uint32_t ID_timeout, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	try
+	{
+		SISScope(sis.get()).wait(ID_timeout);
+
+		return Err_NoError;
+	}
+	catch (SISProtocol::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Scope);
+	}
+	catch (CSerial::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Scope);
+	}
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV scope_download(SISHandle ID_ref, uint8_t ID_channel, double_t ID_values[], uint32_t ID_len, uint32_t * ID_count, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	if (!ID_values || !ID_count)
+		return set_error(ID_err, "Samples pointing to invalid location.", Err_Invalid_Pointer);
+
+	try
+	{
+		*ID_count = static_cast<uint32_t>(SISScope(sis.get()).download(ID_channel, ID_values, ID_len));
+
+		return Err_NoError;
+	}
+	catch (SISProtocol::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Scope);
+	}
+	catch (CSerial::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Scope);
+	}
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV backup_parameters(SISHandle ID_ref, const wchar_t * ID_path, uint16_t ID_idnlist, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	if (!ID_path)
+		return set_error(ID_err, "Path pointing to invalid location.", Err_Invalid_Pointer);
+
+	try
+	{
+		backup_drive(sis.get(), ID_path, ID_idnlist);
+
+		return Err_NoError;
+	}
+	catch (SISProtocol::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Batch);
+	}
+	catch (CSerial::ExceptionGeneric &ex)
+	{
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Batch);
+	}
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV backup_parameters_parallel(SISHandle ID_refs[], const wchar_t * ID_paths[], uint16_t ID_len, uint16_t ID_idnlist, int32_t ID_results[], ErrHandle ID_err)
+{
+	if (!ID_refs || !ID_paths)
+		return set_error(ID_err, "References or paths pointing to invalid location.", Err_Invalid_Pointer);
+
+	// Backups of the same drive would interfere on the link
+	std::set<SISHandle> refs;
+	for (uint16_t i = 0; i < ID_len; i++)
+		if (!refs.insert(ID_refs[i]).second)
+			return set_error(ID_err, sformat("Reference '%u' is given more than once.", ID_refs[i]), Err_Block_Batch);
+
+	// One thread per drive. References are held until all backups have finished.
+	std::vector<int32_t> results(ID_len, Err_NoError);
+	std::vector<std::string> errors(ID_len);
+	std::vector<std::thread> workers;
+	for (uint16_t i = 0; i < ID_len; i++)
+	{
+		workers.push_back(std::thread([&, i]()
+		{
+			SISRef sis = protocols.acquire(ID_refs[i]);
+			if (!sis || !ID_paths[i])
+			{
+				results[i] = get_error_code(Err_Invalid_Pointer);
+				errors[i] = "Invalid reference or path.";
+				return;
+			}
+
+			try
+			{
+				backup_drive(sis.get(), ID_paths[i], ID_idnlist);
+			}
+			catch (SISProtocol::ExceptionGeneric &ex)
+			{
+				results[i] = get_error_code(Err_Block_Batch);
+				errors[i] = char2str(ex.what());
+			}
+			catch (CSerial::ExceptionGeneric &ex)
+			{
+				results[i] = get_error_code(Err_Block_Batch);
+				errors[i] = char2str(ex.what());
+			}
+		}));
+	}
+
+	for (size_t i = 0; i < workers.size(); i++)
+		workers[i].join();
+
+	std::string failed;
+	for (uint16_t i = 0; i < ID_len; i++)
+	{
+		if (ID_results) ID_results[i] = results[i];
+		if (results[i] != Err_NoError) failed.append(sformat("Reference '%u': %s ", ID_refs[i], errors[i].c_str()));
+	}
+
+	if (!failed.empty())
+		return set_error(ID_err, sformat("Backup failed: %s", failed.c_str()), Err_Block_Batch);
+
+	return Err_NoError;
+}
+
+
+DLLEXPORT int32_t DLLCALLCONV restore_parameters(SISHandle ID_ref, const wchar_t * ID_path, SISRestoreStats * ID_stats, ErrHandle ID_err)
+{
+	SISRef sis = protocols.acquire(ID_ref);
+	if (!sis)
+		// Return error for wrong reference
+		return set_error(
+			ID_err, sformat("Reference '%u' is invalid or has been closed.", ID_ref),
+			Err_Invalid_Pointer);
+
+	invalidate_channel(ID_ref);
+
+	if (!ID_path)
+		return set_error(ID_err, "Path pointing to invalid location.", Err_Invalid_Pointer);
+
+	SISRestoreStats stats = { 0, 0, 0 };
+
+	try
+	{
+		SISBackup backup;
+		backup.load(ID_path);
+		backup.restore(sis.get(), stats);
+
+		if (ID_stats) *ID_stats = stats;
+
+		return Err_NoError;
+	}
+	catch (SISProtocol::ExceptionGeneric &ex)
+	{
+		if (ID_stats) *ID_stats = stats;
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Batch);
+	}
+	catch (CSerial::ExceptionGeneric &ex)
+	{
+		if (ID_stats) *ID_stats = stats;
+		return set_error(ID_err, char2str(ex.what()), Err_Block_Batch);
+	}
+}
+
+void write_sequence(SISProtocol * ID_ref, const uint16_t offset, double_t speeds[], double_t accels[], double_t jerks[], uint32_t delays[], const uint16_t length, const bool retain)
+{
+	for (uint16_t i = 0; i < length; i++)
+	{
+		// Speed in min^-1 (P-0-4007)
+		ID_ref->write_listelm(TGM::SercosParamP, 4007, offset + i + 1, abs(speeds[i]), retain);
+
+		// Acceleration in rad/s^2 (P-0-4008)
+		ID_ref->write_listelm(TGM::SercosParamP, 4008, offset + i + 1, accels[i], retain);
+
+		// Deceleration in rad/s^2 (P-0-4063)
+		ID_ref->write_listelm(TGM::SercosParamP, 4063, offset + i + 1, accels[i], retain);
+
+		// Jerk in rad/s^3 (P-0-4009)
+		ID_ref->write_listelm(TGM::SercosParamP, 4009, offset + i + 1, jerks[i], retain);
+
+		// Mode (P-0-4019)
+		ID_ref->write_listelm(TGM::SercosParamP, 4019, offset + i + 2, static_cast<uint32_t>(stde::sgn<double_t>(speeds[i]) == 1 ? SEQUENCER_MODE_CW : SEQUENCER_MODE_CCW), retain);
+
+		// Pos (P-0-4006)
+		ID_ref->write_listelm(TGM::SercosParamP, 4006, offset + i + 1, static_cast<uint64_t>(0), retain);
+
+		// Wait (P-0-4018)
+		ID_ref->write_listelm(TGM::SercosParamP, 4018, offset + i + 1, static_cast<uint64_t>(0), retain);
+
+		// Timers in cs (P-0-1389)
+		ID_ref->write_listelm(TGM::SercosParamP, 1389, offset + i + 1, delays[i], retain);
 	}
 }
 
 
-void change_opmode(SISProtocol * ID_ref, const uint64_t opmode)
+void change_opmode(SISProtocol * ID_ref, const uint64_t opmode, SISCommand * ID_cmd)
 {
 	uint64_t curopmode;
 	// Primary Operation Mode (S-0-0032)
@@ -631,15 +2103,76 @@ void change_opmode(SISProtocol * ID_ref, const uint64_t opmode)
 	// Thus, operation change should be mainly triggered if required only
 	if (curopmode != opmode)
 	{
-		// Enter parameterization level 1 (S-0-0420) // Command C0400
-		ID_ref->execute_command(TGM::SercosParamS, 420);
+		// Primary Operation Mode (S-0-0032), written within parameterization level 1 (C0400 ... C0200)
+		SISParamSession session(ID_ref);
+		session.write_parameter(TGM::SercosParamS, 32, opmode);
+		session.commit(ID_cmd);
+	}
+}
+
+
+void backup_drive(SISProtocol * ID_ref, const wchar_t * path, const uint16_t idnlist)
+{
+	SISBackup backup;
+	backup.read(ID_ref, idnlist);
+	backup.save(path);
+}
+
+
+void detach_reactor(SISProtocol * ID_ref)
+{
+	std::lock_guard<std::mutex> lock(mutex_reactor);
+
+	if (!reactor || !reactor->detach(ID_ref)) return;
+
+	// Reactor thread is stopped with the last link
+	if (!reactor->get_count())
+	{
+		delete reactor;
+		reactor = NULL;
+	}
+}
+
+
+int32_t set_result(ErrHandle ID_err, const SISResult& result, const int32_t block)
+{
+	if (result.ok()) return Err_NoError;
+
+	// Message is formatted here, and not before
+	return set_error(ID_err, result.get_message(), block);
+}
+
 
-		// Primary Operation Mode (S-0-0032)
-		ID_ref->write_parameter(TGM::SercosParamS, 32, opmode);
+void invalidate_channel(SISHandle ID_ref)
+{
+	std::shared_ptr<SISSpeedChannel> channel;
+	{
+		std::lock_guard<std::mutex> lock(mutex_channels);
 
-		// Leave parameterization level 1 (S-0-0422) // Command C0200
-		ID_ref->execute_command(TGM::SercosParamS, 422);
+		std::map<SISHandle, std::shared_ptr<SISSpeedChannel>>::iterator it = channels.find(ID_ref);
+		if (it != channels.end()) channel = it->second;
 	}
+
+	if (channel) channel->invalidate();
+
+	// Running streamer writes by its own channel. Streamer is held under the lock, since it is deleted after its erase.
+	std::lock_guard<std::mutex> lock(mutex_streamers);
+
+	std::map<SISHandle, SISSpeedStreamer*>::iterator it = streamers.find(ID_ref);
+	if (it != streamers.end() && it->second) it->second->invalidate();
+}
+
+
+int32_t register_command(SISCommand * cmd, SISCommandHandle * ID_cmd, ErrHandle ID_err)
+{
+	*ID_cmd = commands.insert(cmd);
+	if (*ID_cmd) return Err_NoError;
+
+	// Command is not reachable by a handle. Thus, it is aborted.
+	cmd->cancel();
+	delete cmd;
+
+	return set_error(ID_err, sformat("No command handle left. Up to %u commands can be started at the same time.", HANDLEREGISTRY_SLOTS), Err_Block_Command);
 }
 
 
@@ -674,4 +2207,7 @@ inline void change_language(SISProtocol * ID_ref, const uint8_t lang_code)
 	// * 3: Spanish
 	// * 4: Italian
 	ID_ref->write_parameter(TGM::SercosParamS, 265, (UINT32)lang_code);
+
+	// Cached diagnostic message is language dependent
+	ID_ref->invalidate_diagnostic();
 }
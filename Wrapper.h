@@ -10,6 +10,17 @@
 #include <Windows.h>
 
 #include "SISProtocol.h"
+#include "SISParamSession.h"
+#include "SISMonitor.h"
+#include "SISSupervisor.h"
+#include "SISSpeedChannel.h"
+#include "SISSpeedStreamer.h"
+#include "SISScope.h"
+#include "SISBackup.h"
+#include "SISLinkPlanner.h"
+#include "SISReactor.h"
+#include "Sequencer.h"
+#include "HandleRegistry.h"
 #include "RS232.h"
 #include "errors.h"
 #include "debug.h"
@@ -182,6 +193,16 @@ extern "C" {  /*  using a C++ compiler  */
 	/// automatically handled using extern "C".
 	typedef struct SISProtocol SISProtocol;
 
+	/// API reference. Opaque handle that is validated by every call, so that closed or unknown references are
+	/// rejected safely.
+	typedef uint32_t SISHandle;
+
+	/// Faking the actual SISCommand class to a struct so that the C compiler can handle compilation of this file.
+	typedef struct SISCommand SISCommand;
+
+	/// Command handle (see execute_command_async()). Opaque handle that is validated by every call, like SISHandle.
+	typedef uint32_t SISCommandHandle;
+
 
 #pragma region API Fundamentals
 
@@ -204,12 +225,20 @@ extern "C" {  /*  using a C++ compiler  */
 	/// 			indraref = indralib.init()
 	/// 			@endcode.
 	///
-	/// @return	API reference. Pointer can be casted and treated as UINT32 (see examples).
-	DLLEXPORT SISProtocol* DLLCALLCONV init();
+	/// @return	API reference, or 0 if too many references are open (see HANDLEREGISTRY_SLOTS). The reference is an
+	/// 		opaque handle, which becomes invalid by close().
+	DLLEXPORT SISHandle DLLCALLCONV init();
 
 	/// Opens the communication port to the Indradrive device.
 	/// 
-	/// @attention Baudrate selection is not support. Default of 19200 Bits/s is used.
+	/// The port is opened with 19200 Bits/s, which is the default of the device. Nothing is sent to the device then. If
+	/// another baud rate is requested, the device and the port are switched to it afterwards. Since the device might
+	/// still run with a baud rate of a previous session, the other baud rates are tried as well; thus, opening takes up
+	/// to several seconds if no device responds.
+	///
+	/// Instead of a COM port, a serial-to-Ethernet gateway can be given by URL: "tcp://host:port" for a raw TCP
+	/// socket, whose line has to be configured to the requested baud rate, 8 data bits, no parity and 1 stop bit on the
+	/// gateway; or "rfc2217://host:port" for gateways with Telnet Com Port Control, whose line is set like a COM port.
 	///
 	/// @remarks	This function is exported to the Indradrive API DLL.
 	///
@@ -226,13 +255,15 @@ extern "C" {  /*  using a C++ compiler  */
 	/// 			result = indralib.open(indraref, b"COM1", 19200, ctypes.byref(indra_error))
 	/// 			@endcode.
 	///
-	/// @param [in]		ID_ref		  	API reference. Pointer can be casted in from UINT32.
-	/// @param [in]		ID_comport	  	(Optional) Communication port. Default: L"COM1".
-	/// @param [in]		ID_combaudrate	(Optional) Communication baudrate in [Bits/s]. Default: 19200 Bits/s.
+	/// @param [in]		ID_ref		  	API reference (see init()).
+	/// @param [in]		ID_comport	  	(Optional) Communication port, e.g. L"COM1", or URL of a gateway, e.g.
+	/// 								L"rfc2217://192.168.0.10:4001". Default: L"COM1".
+	/// @param [in]		ID_combaudrate	(Optional) Communication baudrate in [Bits/s]: 9600, 19200, 38400, 57600, or
+	/// 								115200. Default: 19200 Bits/s.
 	/// @param [out]	ID_err		  	(Optional) Error handle.
 	///
 	/// @return	Error handle return code (ErrHandle()).
-	DLLEXPORT int32_t DLLCALLCONV open(SISProtocol* ID_ref, const wchar_t* ID_comport = L"COM1", uint32_t ID_combaudrate = 19200, ErrHandle ID_err = ErrHandle());
+	DLLEXPORT int32_t DLLCALLCONV open(SISHandle ID_ref, const wchar_t* ID_comport = L"COM1", uint32_t ID_combaudrate = 19200, ErrHandle ID_err = ErrHandle());
 
 	/// Closes the communication port at the Indradrive device.
 	///
@@ -251,11 +282,64 @@ extern "C" {  /*  using a C++ compiler  */
 	/// 			result = indralib.close(indraref, ctypes.byref(indra_error))
 	/// 			@endcode.
 	///
-	/// @param [in]		ID_ref	API reference. Pointer can be casted in from UINT32.
+	/// @param [in]		ID_ref	API reference (see init()).
+	/// @param [out]	ID_err	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV close(SISHandle ID_ref, ErrHandle ID_err = ErrHandle());
+
+	/// Starts supervising the connection, so that a lost link is restored without involvement of the application.
+	/// 
+	/// If an exchange fails due to a lost link (e.g. the USB-serial adapter has been unplugged briefly), the port is
+	/// reopened with the port and baud rate of open(), and the baud rate is renegotiated. The failed exchange is
+	/// replayed if it is idempotent, i.e. the call succeeds. A timeout is taken as link loss only if a probe fails as
+	/// well. Reopening is given up after SIS_RECONNECT_TIMEOUT, and calls of other threads fail meanwhile instead of
+	/// waiting. While the application does not communicate, a keepalive read detects lost links.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Use get_link_health() to observe link losses and reconnects.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int supervisor_start(int ID_ref, UInt32 ID_interval, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			result = indralib.supervisor_start(indraref, 500, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	  	API reference (see init()). Has to be opened (see open()).
+	/// @param [in]		ID_interval	(Optional) Keepalive interval in [ms]. Default: 500.
+	/// @param [out]	ID_err	  	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV supervisor_start(SISHandle ID_ref, uint32_t ID_interval = SISSUPERVISOR_INTERVAL_DEFAULT, ErrHandle ID_err = ErrHandle());
+
+	/// Stops supervising the connection. Failed exchanges are reported to the application again.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Supervising is stopped by close() as well.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int supervisor_stop(int ID_ref, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			result = indralib.supervisor_stop(indraref, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	API reference (see init()).
 	/// @param [out]	ID_err	(Optional) Error handle.
 	///
 	/// @return	Error handle return code (ErrHandle()).
-	DLLEXPORT int32_t DLLCALLCONV close(SISProtocol* ID_ref, ErrHandle ID_err = ErrHandle());
+	DLLEXPORT int32_t DLLCALLCONV supervisor_stop(SISHandle ID_ref, ErrHandle ID_err = ErrHandle());
 
 #pragma endregion API Fundamentals
 
@@ -280,11 +364,11 @@ extern "C" {  /*  using a C++ compiler  */
 	/// 			private static extern int sequencer_activate(int ID_ref, ref ErrHandle ID_err);
 	/// 			@endcode.
 	///
-	/// @param [in]		ID_ref	API reference. Pointer can be casted in from UINT32.
+	/// @param [in]		ID_ref	API reference (see init()).
 	/// @param [out]	ID_err	(Optional) Error handle.
 	///
 	/// @return	Error handle return code (ErrHandle()).
-	DLLEXPORT int32_t DLLCALLCONV sequencer_activate(SISProtocol* ID_ref, ErrHandle ID_err = ErrHandle());
+	DLLEXPORT int32_t DLLCALLCONV sequencer_activate(SISHandle ID_ref, ErrHandle ID_err = ErrHandle());
 
 	/// Initializes limits and sets the right scaling/unit factors for operation of "Sequencer" drive mode.
 	///
@@ -298,13 +382,13 @@ extern "C" {  /*  using a C++ compiler  */
 	/// 			private static extern int sequencer_init(int ID_ref, Double ID_max_accel, Double ID_max_jerk, ref ErrHandle ID_err);
 	/// 			@endcode.
 	///
-	/// @param [in]		ID_ref			API reference. Pointer can be casted in from UINT32.
+	/// @param [in]		ID_ref			API reference (see init()).
 	/// @param [in]		ID_max_accel	(Optional) Maximum allowed acceleration in [rad/s^2]. Default: 10000 rad/s^2.
 	/// @param [in]		ID_max_jerk 	(Optional) Maximum allowed jerk in [rad/s^3]. Default: 1000 rad/s^3.
 	/// @param [out]	ID_err			(Optional) Error handle.
 	///
 	/// @return	Error handle return code (ErrHandle()).
-	DLLEXPORT int32_t DLLCALLCONV sequencer_init(SISProtocol* ID_ref, double_t ID_max_accel = 10000, double_t ID_max_jerk = 1000, ErrHandle ID_err = ErrHandle());
+	DLLEXPORT int32_t DLLCALLCONV sequencer_init(SISHandle ID_ref, double_t ID_max_accel = 10000, double_t ID_max_jerk = 1000, ErrHandle ID_err = ErrHandle());
 
 	/// Writes the whole run sequence into the device.
 	/// 
@@ -324,7 +408,7 @@ extern "C" {  /*  using a C++ compiler  */
 	/// 			private static extern int sequencer_write(int ID_ref, Double[] ID_speeds, Double[] ID_accels, Double[] ID_jerks, UInt32[] ID_delays, UInt16 ID_set_length, ref ErrHandle ID_err);
 	/// 			@endcode.
 	///
-	/// @param [in]		ID_ref		 	API reference. Pointer can be casted in from UINT32.
+	/// @param [in]		ID_ref		 	API reference (see init()).
 	/// @param [in]		ID_speeds	 	Sequencer speed list in [1/min]. Rotation directions are defined by the sign of
 	/// 								each element:
 	/// 								* Positive sign: Clockwise direction  
@@ -336,10 +420,115 @@ extern "C" {  /*  using a C++ compiler  */
 	/// @param [out]	ID_err		 	(Optional) Error handle.
 	///
 	/// @return	Error handle return code (ErrHandle()).
-	DLLEXPORT int32_t DLLCALLCONV sequencer_write(SISProtocol* ID_ref, double_t ID_speeds[], double_t ID_accels[], double_t ID_jerks[], uint32_t ID_delays[], const uint16_t ID_set_length, ErrHandle ID_err = ErrHandle());
+	DLLEXPORT int32_t DLLCALLCONV sequencer_write(SISHandle ID_ref, double_t ID_speeds[], double_t ID_accels[], double_t ID_jerks[], uint32_t ID_delays[], const uint16_t ID_set_length, ErrHandle ID_err = ErrHandle());
+
+	/// Writes a run sequence into one of the sequence banks, while the sequence of the other bank may be running.
+	///
+	/// Double-buffered operation splits the positioning block lists into SEQUENCER_BANKS banks of SEQUENCER_BANK_STEPS
+	/// steps each. The next sequence is uploaded into the idle bank, selected by sequencer_select_bank(), and started by
+	/// the next trigger without any upload gap. Bank 0 shares its list elements with sequencer_write().
+	///
+	/// @attention	Double-buffered operation requires the PLC routine to cooperate:
+	/// 			* On the trigger edge, the PLC latches the bank to be run from global register G3 (P-0-1373).
+	/// 			* The PLC runs the positioning blocks of that bank, i.e. starting at element
+	/// 			  bank*SEQUENCER_BANK_STEPS+1, with the step count of G4 (P-0-1374) for bank 0, or G5 (P-0-1375)
+	/// 			  for bank 1.
+	/// 			* Changes of G3 while a sequence is running apply to the next trigger only.
+	/// 			Without such a PLC routine, only bank 0 is operated, and its length still has to be set by
+	/// 			sequencer_write().
+	///
+	/// @remarks	Writing into the bank that is currently running corrupts the running sequence. Alternate between
+	/// 			the banks.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int sequencer_write_bank(int ID_ref, Byte ID_bank, Double[] ID_speeds, Double[] ID_accels, Double[] ID_jerks, UInt32[] ID_delays, UInt16 ID_set_length, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			result = indralib.sequencer_write_bank(indraref, 1, speeds, accels, jerks, delays, len(speeds), ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref		 	API reference (see init()).
+	/// @param [in]		ID_bank		 	Sequence bank (0 ... SEQUENCER_BANKS-1).
+	/// @param [in]		ID_speeds	 	Sequencer speed list in [1/min]. Signs define the rotation directions.
+	/// @param [in]		ID_accels	 	Sequencer acceleration list in [rad/s^2].
+	/// @param [in]		ID_jerks	 	Sequencer jerk list in [rad/s^3].
+	/// @param [in]		ID_delays	 	Delay list representing delay between each kinematic step in [cs].
+	/// @param [in]		ID_set_length	Length of the sequence (1 ... SEQUENCER_BANK_STEPS).
+	/// @param [out]	ID_err		 	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV sequencer_write_bank(SISHandle ID_ref, uint8_t ID_bank, double_t ID_speeds[], double_t ID_accels[], double_t ID_jerks[], uint32_t ID_delays[], const uint16_t ID_set_length, ErrHandle ID_err = ErrHandle());
+
+	/// Selects the sequence bank that is started by the next trigger (see sequencer_write_bank()).
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int sequencer_select_bank(int ID_ref, Byte ID_bank, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			result = indralib.sequencer_select_bank(indraref, 1, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	API reference (see init()).
+	/// @param [in]		ID_bank	Sequence bank (0 ... SEQUENCER_BANKS-1).
+	/// @param [out]	ID_err	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV sequencer_select_bank(SISHandle ID_ref, uint8_t ID_bank, ErrHandle ID_err = ErrHandle());
+
+	/// Compiles a run sequence for the "Sequencer" drive mode, without any communication with the drive.
+	///
+	/// Computes the jerk of each step that is required to reach its speed within its delay (starting from standstill),
+	/// and checks the sequence against the given limits and the maximum length of SEQUENCER_MAX_STEPS. Infeasible
+	/// sequences are rejected with an error message that names every failing step. The resulting jerks can be
+	/// passed to sequencer_write() directly.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	ID_max_accel and ID_max_jerk are supposed to be the same values as passed to sequencer_init().
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int sequencer_compile(Double[] ID_speeds, Double[] ID_accels, UInt32[] ID_delays, UInt16 ID_set_length, Double ID_max_accel, Double ID_max_jerk, Double[] ID_jerks, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			jerks = (ctypes.c_double * len(speeds))()
+	/// 			result = indralib.sequencer_compile(speeds, accels, delays, len(speeds), ctypes.c_double(10000), ctypes.c_double(1000), jerks, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_speeds	 	Sequencer speed list in [1/min]. Signs define the rotation directions.
+	/// @param [in]		ID_accels	 	Sequencer acceleration list in [rad/s^2].
+	/// @param [in]		ID_delays	 	Delay list representing delay between each kinematic step in [cs].
+	/// @param [in]		ID_set_length	Length of the sequence (=number of elements of ID_speeds, ID_accels, etc).
+	/// @param [in]		ID_max_accel 	Maximum acceleration in [rad/s^2].
+	/// @param [in]		ID_max_jerk  	Maximum jerk in [rad/s^3].
+	/// @param [out]	ID_jerks	 	Sequencer jerk list in [rad/s^3]. Needs space for ID_set_length elements.
+	/// @param [out]	ID_err		 	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV sequencer_compile(double_t ID_speeds[], double_t ID_accels[], uint32_t ID_delays[], const uint16_t ID_set_length, double_t ID_max_accel, double_t ID_max_jerk, double_t ID_jerks[], ErrHandle ID_err = ErrHandle());
 
 	/// Software-Trigger to start operation of the "Sequencer" drive mode.
 	///
+	/// @remarks	Resets both triggers and waits for RESULT_READ_OK and bDriveStarted of the last trigger to drop. Then,
+	/// 			sets the read trigger G1 (P-0-1371) and waits for RESULT_READ_OK, and sets the sequencer trigger G2
+	/// 			(P-0-1372) and waits for bDriveStarted, each within SEQUENCER_HANDSHAKE_TIMEOUT. The timing of the
+	/// 			trigger is provided by sequencer_gettriggertiming().
+	///
 	/// @remarks	This function is exported to the Indradrive API DLL.
 	///
 	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
@@ -350,15 +539,19 @@ extern "C" {  /*  using a C++ compiler  */
 	/// 			private static extern int sequencer_softtrigger(int ID_ref, ref ErrHandle ID_err);
 	/// 			@endcode.
 	///
-	/// @param [in]		ID_ref	API reference. Pointer can be casted in from UINT32.
+	/// @param [in]		ID_ref	API reference (see init()).
 	/// @param [out]	ID_err	(Optional) Error handle.
 	///
 	/// @return	Error handle return code (ErrHandle()).
-	DLLEXPORT int32_t DLLCALLCONV sequencer_softtrigger(SISProtocol* ID_ref, ErrHandle ID_err = ErrHandle());
+	DLLEXPORT int32_t DLLCALLCONV sequencer_softtrigger(SISHandle ID_ref, ErrHandle ID_err = ErrHandle());
 
 	/// Hardware-Trigger to start operation of the "Sequencer" drive mode.
 	/// By special PLC software (if configured), the hardware trigger is realized through a 24V rising edge input line.
 	///
+	/// @remarks	Resets both triggers and waits for RESULT_READ_OK of the last trigger to drop. Then, sets the read
+	/// 			trigger G1 (P-0-1371) and waits for RESULT_READ_OK within SEQUENCER_HANDSHAKE_TIMEOUT. The timing is
+	/// 			provided by sequencer_gettriggertiming().
+	///
 	/// @remarks	This function is exported to the Indradrive API DLL.
 	/// 
 	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
@@ -369,11 +562,67 @@ extern "C" {  /*  using a C++ compiler  */
 	/// 			private static extern int sequencer_hardtrigger(int ID_ref, ref ErrHandle ID_err);
 	/// 			@endcode.
 	///
-	/// @param [in]		ID_ref	API reference. Pointer can be casted in from UINT32.
+	/// @param [in]		ID_ref	API reference (see init()).
 	/// @param [out]	ID_err	(Optional) Error handle.
 	///
 	/// @return	Error handle return code (ErrHandle()).
-	DLLEXPORT int32_t DLLCALLCONV sequencer_hardtrigger(SISProtocol* ID_ref, ErrHandle ID_err = ErrHandle());
+	DLLEXPORT int32_t DLLCALLCONV sequencer_hardtrigger(SISHandle ID_ref, ErrHandle ID_err = ErrHandle());
+
+	/// Handshake with the PLC: Writes a global register, and waits for a bit of the PLC status register (P-0-1410).
+	///
+	/// Latency is bounded by the deadline, and measured: The returned statistics tell how long writing took, and when
+	/// the bit has been observed, with the resolution of a single status read.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int sequencer_handshake(int ID_ref, UInt16 ID_register, UInt32 ID_value, Byte ID_bit, Byte ID_state, UInt32 ID_timeout, UInt32 ID_interval, ref PLCHandshakeStats ID_stats, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			stats = PLCHandshakeStats()
+	/// 			result = indralib.sequencer_handshake(indraref, 1372, 1, 3, 1, 3000, 0, ctypes.byref(stats), ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	 	API reference (see init()).
+	/// @param [in]		ID_register	Number of the global register to be written (e.g. 1372 for G2, P-0-1372).
+	/// @param [in]		ID_value   	Value to be written into the register.
+	/// @param [in]		ID_bit	   	Bit of P-0-1410 to be waited for (see sequencer_getstatus()).
+	/// @param [in]		ID_state   	State of the bit to be waited for (0: reset, 1: set).
+	/// @param [in]		ID_timeout 	Deadline in [ms], counted from the register being written.
+	/// @param [in]		ID_interval	Interval between status reads in [ms]. 0 reads back-to-back, which gives the lowest
+	/// 							latency.
+	/// @param [out]	ID_stats   	(Optional) Timing statistics of the handshake. May be NULL.
+	/// @param [out]	ID_err	   	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV sequencer_handshake(SISHandle ID_ref, uint16_t ID_register, uint32_t ID_value, uint8_t ID_bit, uint8_t ID_state, uint32_t ID_timeout, uint32_t ID_interval, PLCHandshakeStats * ID_stats, ErrHandle ID_err = ErrHandle());
+
+	/// Gets the timing of the last trigger by sequencer_softtrigger() or sequencer_hardtrigger().
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int sequencer_gettriggertiming(int ID_ref, ref PLCHandshakeStats ID_stats, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			stats = PLCHandshakeStats()
+	/// 			result = indralib.sequencer_gettriggertiming(indraref, ctypes.byref(stats), ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref  	API reference (see init()).
+	/// @param [out]	ID_stats	Timing statistics of the final handshake of the trigger.
+	/// @param [out]	ID_err  	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV sequencer_gettriggertiming(SISHandle ID_ref, PLCHandshakeStats * ID_stats, ErrHandle ID_err = ErrHandle());
 
 	/// Get the status of the "Sequencer" drive mode.
 	/// The information is derived from the PLC that reports the actual status within an internal register.
@@ -394,7 +643,7 @@ extern "C" {  /*  using a C++ compiler  */
 	/// 			result = indralib.sequencer_getstatus(indraref, ctypes.byref(plcstatus), ctypes.byref(indra_error))
 	/// 			@endcode.
 	///
-	/// @param [in]		ID_ref	API reference. Pointer can be casted in from UINT32.
+	/// @param [in]		ID_ref	API reference (see init()).
 	/// @param [out]	ID_status	Pointer that provides the respective information:
 	/// 							* Bit 0 - bSeqFinished, if true then end of the sequence has been reached.
 	/// 							* Bit 1 - bCamTick, if true then cam is currently shifting to the next position.
@@ -407,7 +656,7 @@ extern "C" {  /*  using a C++ compiler  */
 	/// @param [out]	ID_err	(Optional) Error handle.
 	///
 	/// @return	Error handle return code (ErrHandle()).
-	DLLEXPORT int32_t DLLCALLCONV sequencer_getstatus(SISProtocol* ID_ref, uint16_t * ID_status, ErrHandle ID_err = ErrHandle());
+	DLLEXPORT int32_t DLLCALLCONV sequencer_getstatus(SISHandle ID_ref, uint16_t * ID_status, ErrHandle ID_err = ErrHandle());
 
 #pragma endregion API Sequencer
 
@@ -434,11 +683,11 @@ extern "C" {  /*  using a C++ compiler  */
 	/// 			result = indralib.speedcontrol_activate(indraref, ctypes.byref(indra_error))
 	/// 			@endcode.
 	///
-	/// @param [in]		ID_ref	API reference. Pointer can be casted in from UINT32.
+	/// @param [in]		ID_ref	API reference (see init()).
 	/// @param [out]	ID_err	(Optional) Error handle.
 	///
 	/// @return	Error handle return code (ErrHandle()).
-	DLLEXPORT int32_t DLLCALLCONV speedcontrol_activate(SISProtocol* ID_ref, ErrHandle ID_err = ErrHandle());
+	DLLEXPORT int32_t DLLCALLCONV speedcontrol_activate(SISHandle ID_ref, ErrHandle ID_err = ErrHandle());
 
 	/// Initializes limits and sets the right scaling/unit factors for operation of "Speed Control" drive mode.
 	///
@@ -457,13 +706,13 @@ extern "C" {  /*  using a C++ compiler  */
 	/// 			result = indralib.speedcontrol_init(indraref, ctypes.c_double(10000), ctypes.c_double(1000), ctypes.byref(indra_error))
 	/// 			@endcode.
 	///
-	/// @param [in]		ID_ref			API reference. Pointer can be casted in from UINT32.
+	/// @param [in]		ID_ref			API reference (see init()).
 	/// @param [out]	ID_max_accel	(Optional) Maximum allowed acceleration in [rad/s^2]. Default: 10000 rad/s^2.
 	/// @param [out]	ID_max_jerk 	(Optional) Maximum allowed jerk in [rad/s^3]. Default: 1000 rad/s^3.
 	/// @param [out]	ID_err			(Optional) Error handle.
 	///
 	/// @return	Error handle return code (ErrHandle()).
-	DLLEXPORT int32_t DLLCALLCONV speedcontrol_init(SISProtocol* ID_ref, double_t ID_max_accel = 10000, double_t ID_max_jerk = 1000, ErrHandle ID_err = ErrHandle());
+	DLLEXPORT int32_t DLLCALLCONV speedcontrol_init(SISHandle ID_ref, double_t ID_max_accel = 10000, double_t ID_max_jerk = 1000, ErrHandle ID_err = ErrHandle());
 
 	/// Writes the current kinematic (speed and acceleration) into the device.
 	///
@@ -482,7 +731,7 @@ extern "C" {  /*  using a C++ compiler  */
 	/// 			result = indralib.speedcontrol_write(indraref, ctypes.c_double(speed), ctypes.c_double(10), ctypes.byref(indra_error))
 	/// 			@endcode.
 	///
-	/// @param [in]		ID_ref  	API reference. Pointer can be casted in from UINT32.
+	/// @param [in]		ID_ref  	API reference (see init()).
 	/// @param [out]	ID_speed	Target speed in [1/min]. Sign represents the rotation direction:
 	/// 							* Positive sign: Clockwise direction  
 	/// 							* Negative sign: Counter-clockwise direction.
@@ -490,224 +739,1430 @@ extern "C" {  /*  using a C++ compiler  */
 	/// @param [out]	ID_err  	(Optional) Error handle.
 	///
 	/// @return	Error handle return code (ErrHandle()).
-	DLLEXPORT int32_t DLLCALLCONV speedcontrol_write(SISProtocol* ID_ref, double_t ID_speed, double_t ID_accel, ErrHandle ID_err = ErrHandle());
-
-#pragma endregion API Speed Control
-
-
-#pragma region API Configuration
+	DLLEXPORT int32_t DLLCALLCONV speedcontrol_write(SISHandle ID_ref, double_t ID_speed, double_t ID_accel, ErrHandle ID_err = ErrHandle());
 
-	/// Sets the proper unit and language environment.
-	/// 
-	/// Proper unit and language environment is:
-	/// * for unit setup: Preferred scaling / Rotary scaling / Unit [rpm] / Velocity data scaling
-	/// * for language environment: English language.  
+	/// Opens the speed setpoint channel for speedcontrol_channel_write().
 	/// 
-	/// @attention Not setting the proper unit and language environment may cause unexpected behavior when programming
-	/// and setting kinematics.
+	/// The attributes of the setpoint parameters are read here, so that writing a setpoint afterwards does not need
+	/// any attribute reads. Opening the channel again resets it. Functions that write the setpoint by other means
+	/// (e.g. speedcontrol_write(), write_params(), batch_commit()) or change the state of the drive (e.g. clear_error(),
+	/// speedcontrol_activate()) reset it as well, so that the next channel write transmits all fields with the
+	/// current scaling (e.g. after speedcontrol_init() has changed S-0-0044).
 	///
 	/// @remarks	This function is exported to the Indradrive API DLL.
 	///
 	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
 	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int speedcontrol_channel_open(int ID_ref, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
 	/// @remarks	How to call with Python:
 	/// 			@code{.py}
-	/// 			result = indralib.set_stdenvironment(indraref, ctypes.byref(indra_error))
+	/// 			result = indralib.speedcontrol_channel_open(indraref, ctypes.byref(indra_error))
 	/// 			@endcode.
 	///
-	/// @param [in,out]	ID_ref	API reference. Pointer can be casted in from UINT32.
-	/// @param 		   	ID_err	(Optional) Error handle.
+	/// @param [in]		ID_ref	API reference (see init()).
+	/// @param [out]	ID_err	(Optional) Error handle.
 	///
 	/// @return	Error handle return code (ErrHandle()).
-	DLLEXPORT int32_t DLLCALLCONV set_stdenvironment(SISProtocol* ID_ref, ErrHandle ID_err = ErrHandle());
+	DLLEXPORT int32_t DLLCALLCONV speedcontrol_channel_open(SISHandle ID_ref, ErrHandle ID_err = ErrHandle());
 
-#pragma endregion API Configuration
-
-
-#pragma region API Status
-
-	/// Retrieve information about the drive mode: Speed Control or Sequencer.
-	/// 
-	/// The drive mode feedback is provided by <c>ID_drvmode</c> parameter. The following table depicts the coding:
+	/// Writes the current kinematic (speed and acceleration) into the device by the speed setpoint channel.
 	/// 
-	/// If | Then
-	/// -- | -----------
-	/// <c>*ID_drvmode == 0</c> | Drive Mode not supported
-	/// <c>*ID_drvmode == 1</c> | "Sequencer" drive mode active
-	/// <c>*ID_drvmode == 2</c> | "Speed Control" drive mode active.
+	/// Same as speedcontrol_write(), but only values that have changed since the last call are transmitted, all of
+	/// them in a single telegram. Usually, only the speed is transmitted.
 	///
 	/// @remarks	This function is exported to the Indradrive API DLL.
 	///
-	/// @remarks	The drive mode can be changed by speedcontrol_activate() or sequencer_activate().
-	///
-	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	/// @remarks	The channel assumes to be the only writer of P-0-1200, P-0-1203 and S-0-0036. If they have been
+	/// 			written by other means (e.g. speedcontrol_write()), call speedcontrol_channel_open() again.
 	///
 	/// @remarks	How to call with C\#:
 	/// 			@code{.cs}
 	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
-	/// 			private static extern int get_drivemode(int ID_ref, ref UInt32 mode, ref ErrHandle ID_err);
+	/// 			private static extern int speedcontrol_channel_write(int ID_ref, Double ID_speed, Double ID_accel, ref ErrHandle ID_err);
 	/// 			@endcode.
 	///
 	/// @remarks	How to call with Python:
 	/// 			@code{.py}
-	/// 			drvmode = ctypes.c_uint32(0)
-	/// 			result = indralib.get_drivemode(indraref, ctypes.byref(drvmode), ctypes.byref(indra_error))
+	/// 			result = indralib.speedcontrol_channel_write(indraref, ctypes.c_double(speed), ctypes.c_double(10), ctypes.byref(indra_error))
 	/// 			@endcode.
 	///
-	/// @param [in]		ID_ref	  	API reference. Pointer can be casted in from UINT32.
-	/// @param [out]	ID_drvmode	Pointer that provides the respective information:
-	/// 							* 0 - Drive Mode not supported,
-	/// 							* 1 - "Sequencer" drive mode active,
-	/// 							* 2 - "Speed Control" drive mode active.
-	/// @param [out]	ID_err	  	(Optional) Error handle.
+	/// @param [in]		ID_ref  	API reference (see init()).
+	/// @param [in]		ID_speed	Target speed in [1/min]. Sign represents the rotation direction:
+	/// 							* Positive sign: Clockwise direction  
+	/// 							* Negative sign: Counter-clockwise direction.
+	/// @param [in]		ID_accel	Target acceleration in [rad/s^2].
+	/// @param [out]	ID_err  	(Optional) Error handle.
 	///
 	/// @return	Error handle return code (ErrHandle()).
-	DLLEXPORT int32_t DLLCALLCONV get_drivemode(SISProtocol* ID_ref, uint32_t * ID_drvmode, ErrHandle ID_err = ErrHandle());
+	DLLEXPORT int32_t DLLCALLCONV speedcontrol_channel_write(SISHandle ID_ref, double_t ID_speed, double_t ID_accel, ErrHandle ID_err = ErrHandle());
 
-	/// Retrieve information about the operation states: bb, Ab, or AF.
-	/// 
-	/// The operation state feedback is provided by <c>ID_opstate</c> parameter. The following table depicts the coding:
-	/// 
-	/// If | Then
-	/// -- | -----------
-	/// <c>(*ID_opstate &amp; 0b11) == 0b00</c> | Control section / power section not ready for operation(e.g., drive error or phase 2)
-	/// <c>(*ID_opstate &amp; 0b11) == 0b01</c> | Control section ready for operation "bb"
-	/// <c>(*ID_opstate &amp; 0b11) == 0b10</c> | Control section and power section ready for op. "Ab"
-	/// <c>(*ID_opstate &amp; 0b11) == 0b11</c> | Drive with torque "AF".
-	/// <c>((*ID_opstate &amp; 0b100) &gt;&gt; 2) == 1</c> | Drive Halt is active and axis is in standstill
-	/// <c>((*ID_opstate &amp; 0b1000) &gt;&gt; 3) == 1</c> | Drive error.
+	/// Closes the speed setpoint channel.
 	///
 	/// @remarks	This function is exported to the Indradrive API DLL.
 	///
-	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	/// @remarks	The channel is closed by close() as well.
 	///
 	/// @remarks	How to call with C\#:
 	/// 			@code{.cs}
-	/// 			[DllImport(&lt;path_to_DLL&gt;, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
-	/// 			private static extern int get_opstate(int ID_ref, ref Byte state, ref ErrHandle ID_err);
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int speedcontrol_channel_close(int ID_ref, ref ErrHandle ID_err);
 	/// 			@endcode.
 	///
 	/// @remarks	How to call with Python:
 	/// 			@code{.py}
-	/// 			opstate = ctypes.c_uint8(0)
-	/// 			result = indralib.get_opstate(indraref, ctypes.byref(opstate), ctypes.byref(indra_error))
+	/// 			result = indralib.speedcontrol_channel_close(indraref, ctypes.byref(indra_error))
 	/// 			@endcode.
 	///
-	/// @param [in]		ID_ref	  	API reference. Pointer can be casted in from UINT32.
-	/// @param [out]	ID_opstate	Pointer that provides the respective information:
-	/// 							* Bit 0-1: Operation state
-	/// 								* <c>0b00</c>: Control section / power section not ready for operation(e.g., drive
-	/// 								error or phase 2)
-	/// 								* <c>0b01</c>: Control section ready for operation "bb"
-	/// 								* <c>0b10</c>: Control section and power section ready for op. "Ab"
-	/// 								* <c>0b11</c>: Drive with torque "AF".
-	/// 							* Bit 2: Drive Halt acknowledgment
-	/// 								* <c>0</c>: Drive not halted  
-	/// 								* <c>1</c>: Drive Halt is active and axis is in standstill  
-	/// 							* Bit 3: Drive error  
-	/// 								* <c>0</c>: No error  
-	/// 								* <c>1</c>: Drive error present.
-	/// @param [out]	ID_err	  	(Optional) Error handle.
+	/// @param [in]		ID_ref	API reference (see init()).
+	/// @param [out]	ID_err	(Optional) Error handle.
 	///
 	/// @return	Error handle return code (ErrHandle()).
-	DLLEXPORT int32_t DLLCALLCONV get_opstate(SISProtocol* ID_ref, uint8_t * ID_opstate, ErrHandle ID_err = ErrHandle());
+	DLLEXPORT int32_t DLLCALLCONV speedcontrol_channel_close(SISHandle ID_ref, ErrHandle ID_err = ErrHandle());
 
-	/// Gets the actual rotation speed.
+	/// Starts streaming of a speed profile in drive mode "Speed Control".
+	/// 
+	/// A dedicated thread with time-critical priority wakes up at a fixed period and writes the latest due setpoint of
+	/// the profile (see speedcontrol_stream_enqueue()). Deadlines are derived from the start time, so that delays do
+	/// not accumulate. Unchanged values are not transmitted (see speedcontrol_channel_write()).
 	///
 	/// @remarks	This function is exported to the Indradrive API DLL.
 	///
-	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	/// @remarks	The achievable period depends on the baud rate: A period has to be longer than the transmission of a
+	/// 			setpoint. Refer to speedcontrol_stream_getstats() for measuring.
 	///
 	/// @remarks	How to call with C\#:
 	/// 			@code{.cs}
 	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
-	/// 			private static extern int get_speed(int ID_ref, ref Double speed, ref ErrHandle ID_err);
+	/// 			private static extern int speedcontrol_stream_start(int ID_ref, UInt32 ID_period, ref ErrHandle ID_err);
 	/// 			@endcode.
 	///
-	/// @param [in]		ID_ref  	API reference. Pointer can be casted in from UINT32.
-	/// @param [out]	ID_speed	Pointer that provides the speed information as double Value in [1/min]. Sign
-	/// 							represents the rotation direction:
-	/// 							* Positive sign: Clockwise direction  
-	/// 							* Negative sign: Counter-clockwise direction.
-	/// @param [out]	ID_err  	(Optional) Error handle.
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			result = indralib.speedcontrol_stream_start(indraref, 10, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref   	API reference (see init()).
+	/// @param [in]		ID_period	(Optional) Streaming period in [ms]. Default: 10.
+	/// @param [out]	ID_err   	(Optional) Error handle.
 	///
 	/// @return	Error handle return code (ErrHandle()).
-	DLLEXPORT int32_t DLLCALLCONV get_speed(SISProtocol * ID_ref, double_t * ID_speed, ErrHandle ID_err = ErrHandle());
+	DLLEXPORT int32_t DLLCALLCONV speedcontrol_stream_start(SISHandle ID_ref, uint32_t ID_period = SISSTREAMER_PERIOD_DEFAULT, ErrHandle ID_err = ErrHandle());
 
-	/// Gets diagnostic message string of the current Indradrive status.
+	/// Enqueues setpoints into the speed profile that is streamed.
 	/// 
-	/// @attention The API presumes a properly allocated char array for <c>ID_diagnostic_msg</c> parameter.
+	/// Each setpoint is written in the first period at or after its due time. If several setpoints are due within
+	/// the same period, only the latest one is written.
 	///
 	/// @remarks	This function is exported to the Indradrive API DLL.
 	///
-	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	/// @remarks	Setpoints may be enqueued before or while streaming. Up to SISSTREAMER_QUEUE_SIZE setpoints can be
+	/// 			pending.
 	///
 	/// @remarks	How to call with C\#:
 	/// 			@code{.cs}
 	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
-	/// 			private static extern int get_diagnostic_msg(int ID_ref, Byte[] ID_diagnostic_msg, ref ErrHandle ID_err);
+	/// 			private static extern int speedcontrol_stream_enqueue(int ID_ref, UInt32[] ID_times, Double[] ID_speeds, Double[] ID_accels, UInt16 ID_set_length, ref ErrHandle ID_err);
 	/// 			@endcode.
 	///
 	/// @remarks	How to call with Python:
 	/// 			@code{.py}
-	/// 			diagmsg = ctypes.create_string_buffer(256)
-	/// 			result = indralib.get_diagnostic_msg(indraref, diagmsg, ctypes.byref(indra_error))
+	/// 			times = (ctypes.c_uint32 * 3)(0, 500, 1000)
+	/// 			speeds = (ctypes.c_double * 3)(100, 500, 0)
+	/// 			accels = (ctypes.c_double * 3)(10, 10, 10)
+	/// 			result = indralib.speedcontrol_stream_enqueue(indraref, times, speeds, accels, 3, ctypes.byref(indra_error))
 	/// 			@endcode.
 	///
-	/// @param [in]		ID_ref			 	API reference. Pointer can be casted in from UINT32.
-	/// @param [out]	ID_diagnostic_msg	Pointer that provides the diagnostic message string.
-	/// @param [out]	ID_err			 	(Optional) Error handle.
+	/// @param [in]		ID_ref		 	API reference (see init()).
+	/// @param [in]		ID_times	 	Due times in [ms], relative to the start of streaming. Have to be ascending,
+	/// 								also across calls.
+	/// @param [in]		ID_speeds	 	Target speeds in [1/min]. Sign represents the rotation direction:
+	/// 								* Positive sign: Clockwise direction  
+	/// 								* Negative sign: Counter-clockwise direction.
+	/// @param [in]		ID_accels	 	Target accelerations in [rad/s^2].
+	/// @param [in]		ID_set_length	Number of setpoints.
+	/// @param [out]	ID_err		 	(Optional) Error handle.
 	///
 	/// @return	Error handle return code (ErrHandle()).
-	DLLEXPORT int32_t DLLCALLCONV get_diagnostic_msg(SISProtocol* ID_ref, char * ID_diagnostic_msg, ErrHandle ID_err = ErrHandle());
+	DLLEXPORT int32_t DLLCALLCONV speedcontrol_stream_enqueue(SISHandle ID_ref, uint32_t ID_times[], double_t ID_speeds[], double_t ID_accels[], const uint16_t ID_set_length, ErrHandle ID_err = ErrHandle());
 
-	/// Gets diagnostic number of the current Indradrive status.
+	/// Gets the statistics of the speed profile streaming.
 	///
 	/// @remarks	This function is exported to the Indradrive API DLL.
 	///
-	/// @remarks	The coding of the diagnostic number is described in the document "Rexroth IndraDrive Firmware for
-	/// 			Drive Controller MPH-04, MPB-04, MPD-04 / Function Description (Chapter 10.3). For example, operation
-	/// 			state "AF" is described as 0xA0101.
-	///
-	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	/// @remarks	Streaming stops on the first communication error. In this case, the statistics are provided and the
+	/// 			error is returned.
 	///
 	/// @remarks	How to call with C\#:
 	/// 			@code{.cs}
 	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
-	/// 			private static extern int get_diagnostic_num(int ID_ref, ref UInt32 ID_diagnostic_num, ref ErrHandle ID_err);
+	/// 			private static extern int speedcontrol_stream_getstats(int ID_ref, ref SISStreamStats ID_stats, ref ErrHandle ID_err);
 	/// 			@endcode.
 	///
-	/// @param [in]		ID_ref			 	API reference. Pointer can be casted in from UINT32.
-	/// @param [out]	ID_diagnostic_num	Pointer that provides the diagnostic number.
-	/// @param [out]	ID_err			 	(Optional) Error handle.
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			stats = SISStreamStats()
+	/// 			result = indralib.speedcontrol_stream_getstats(indraref, ctypes.byref(stats), ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref  	API reference (see init()).
+	/// @param [out]	ID_stats	Streaming statistics: Periods, sent setpoints, missed periods, pending setpoints, mean
+	/// 							and maximum send jitter, maximum transmission time.
+	/// @param [out]	ID_err  	(Optional) Error handle.
 	///
 	/// @return	Error handle return code (ErrHandle()).
-	DLLEXPORT int32_t DLLCALLCONV get_diagnostic_num(SISProtocol* ID_ref, uint32_t * ID_diagnostic_num, ErrHandle ID_err = ErrHandle());
+	DLLEXPORT int32_t DLLCALLCONV speedcontrol_stream_getstats(SISHandle ID_ref, SISStreamStats * ID_stats, ErrHandle ID_err = ErrHandle());
 
-	/// Clears a latched error in the Indradrive device.
-	/// 
-	/// In case of error that has been occurred on the Indradrive, the error information is latched until cleared with
-	/// this call.
+	/// Stops streaming of the speed profile. Pending setpoints are discarded.
 	///
 	/// @remarks	This function is exported to the Indradrive API DLL.
 	///
-	/// @remarks	Use get_diagnostic_message() and/or get_diagnostic_num() for retrieving the error information.
+	/// @remarks	The drive keeps the last written setpoint. Streaming is stopped by close() as well.
 	///
-	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int speedcontrol_stream_stop(int ID_ref, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			result = indralib.speedcontrol_stream_stop(indraref, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	API reference (see init()).
+	/// @param [out]	ID_err	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV speedcontrol_stream_stop(SISHandle ID_ref, ErrHandle ID_err = ErrHandle());
+
+#pragma endregion API Speed Control
+
+
+#pragma region API Configuration
+
+	/// Sets the proper unit and language environment.
+	/// 
+	/// Proper unit and language environment is:
+	/// * for unit setup: Preferred scaling / Rotary scaling / Unit [rpm] / Velocity data scaling
+	/// * for language environment: English language.  
+	/// 
+	/// @attention Not setting the proper unit and language environment may cause unexpected behavior when programming
+	/// and setting kinematics.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			result = indralib.set_stdenvironment(indraref, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in,out]	ID_ref	API reference (see init()).
+	/// @param 		   	ID_err	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV set_stdenvironment(SISHandle ID_ref, ErrHandle ID_err = ErrHandle());
+
+#pragma endregion API Configuration
+
+
+#pragma region API Status
+
+	/// Retrieve information about the drive mode: Speed Control or Sequencer.
+	/// 
+	/// The drive mode feedback is provided by <c>ID_drvmode</c> parameter. The following table depicts the coding:
+	/// 
+	/// If | Then
+	/// -- | -----------
+	/// <c>*ID_drvmode == 0</c> | Drive Mode not supported
+	/// <c>*ID_drvmode == 1</c> | "Sequencer" drive mode active
+	/// <c>*ID_drvmode == 2</c> | "Speed Control" drive mode active.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	The drive mode can be changed by speedcontrol_activate() or sequencer_activate().
+	///
+	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int get_drivemode(int ID_ref, ref UInt32 mode, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			drvmode = ctypes.c_uint32(0)
+	/// 			result = indralib.get_drivemode(indraref, ctypes.byref(drvmode), ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	  	API reference (see init()).
+	/// @param [out]	ID_drvmode	Pointer that provides the respective information:
+	/// 							* 0 - Drive Mode not supported,
+	/// 							* 1 - "Sequencer" drive mode active,
+	/// 							* 2 - "Speed Control" drive mode active.
+	/// @param [out]	ID_err	  	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV get_drivemode(SISHandle ID_ref, uint32_t * ID_drvmode, ErrHandle ID_err = ErrHandle());
+
+	/// Retrieve information about the operation states: bb, Ab, or AF.
+	/// 
+	/// The operation state feedback is provided by <c>ID_opstate</c> parameter. The following table depicts the coding:
+	/// 
+	/// If | Then
+	/// -- | -----------
+	/// <c>(*ID_opstate &amp; 0b11) == 0b00</c> | Control section / power section not ready for operation(e.g., drive error or phase 2)
+	/// <c>(*ID_opstate &amp; 0b11) == 0b01</c> | Control section ready for operation "bb"
+	/// <c>(*ID_opstate &amp; 0b11) == 0b10</c> | Control section and power section ready for op. "Ab"
+	/// <c>(*ID_opstate &amp; 0b11) == 0b11</c> | Drive with torque "AF".
+	/// <c>((*ID_opstate &amp; 0b100) &gt;&gt; 2) == 1</c> | Drive Halt is active and axis is in standstill
+	/// <c>((*ID_opstate &amp; 0b1000) &gt;&gt; 3) == 1</c> | Drive error.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(&lt;path_to_DLL&gt;, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int get_opstate(int ID_ref, ref Byte state, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			opstate = ctypes.c_uint8(0)
+	/// 			result = indralib.get_opstate(indraref, ctypes.byref(opstate), ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	  	API reference (see init()).
+	/// @param [out]	ID_opstate	Pointer that provides the respective information:
+	/// 							* Bit 0-1: Operation state
+	/// 								* <c>0b00</c>: Control section / power section not ready for operation(e.g., drive
+	/// 								error or phase 2)
+	/// 								* <c>0b01</c>: Control section ready for operation "bb"
+	/// 								* <c>0b10</c>: Control section and power section ready for op. "Ab"
+	/// 								* <c>0b11</c>: Drive with torque "AF".
+	/// 							* Bit 2: Drive Halt acknowledgment
+	/// 								* <c>0</c>: Drive not halted  
+	/// 								* <c>1</c>: Drive Halt is active and axis is in standstill  
+	/// 							* Bit 3: Drive error  
+	/// 								* <c>0</c>: No error  
+	/// 								* <c>1</c>: Drive error present.
+	/// @param [out]	ID_err	  	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV get_opstate(SISHandle ID_ref, uint8_t * ID_opstate, ErrHandle ID_err = ErrHandle());
+
+	/// Gets the actual rotation speed.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int get_speed(int ID_ref, ref Double speed, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref  	API reference (see init()).
+	/// @param [out]	ID_speed	Pointer that provides the speed information as double Value in [1/min]. Sign
+	/// 							represents the rotation direction:
+	/// 							* Positive sign: Clockwise direction  
+	/// 							* Negative sign: Counter-clockwise direction.
+	/// @param [out]	ID_err  	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV get_speed(SISHandle ID_ref, double_t * ID_speed, ErrHandle ID_err = ErrHandle());
+
+	/// Gets diagnostic message string of the current Indradrive status.
+	/// 
+	/// @attention The API presumes a properly allocated char array for <c>ID_diagnostic_msg</c> parameter.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	The diagnostic message is cached per API reference. Only the diagnostic number (S-0-0390) is read on
+	/// 			every call; the message string (S-0-0095) is re-read only if the number has changed.
+	///
+	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int get_diagnostic_msg(int ID_ref, Byte[] ID_diagnostic_msg, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			diagmsg = ctypes.create_string_buffer(256)
+	/// 			result = indralib.get_diagnostic_msg(indraref, diagmsg, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref			 	API reference (see init()).
+	/// @param [out]	ID_diagnostic_msg	Pointer that provides the diagnostic message string.
+	/// @param [out]	ID_err			 	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV get_diagnostic_msg(SISHandle ID_ref, char * ID_diagnostic_msg, ErrHandle ID_err = ErrHandle());
+
+	/// Gets diagnostic number of the current Indradrive status.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	The coding of the diagnostic number is described in the document "Rexroth IndraDrive Firmware for
+	/// 			Drive Controller MPH-04, MPB-04, MPD-04 / Function Description (Chapter 10.3). For example, operation
+	/// 			state "AF" is described as 0xA0101.
+	///
+	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int get_diagnostic_num(int ID_ref, ref UInt32 ID_diagnostic_num, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref			 	API reference (see init()).
+	/// @param [out]	ID_diagnostic_num	Pointer that provides the diagnostic number.
+	/// @param [out]	ID_err			 	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV get_diagnostic_num(SISHandle ID_ref, uint32_t * ID_diagnostic_num, ErrHandle ID_err = ErrHandle());
+
+	/// Clears a latched error in the Indradrive device.
+	/// 
+	/// In case of error that has been occurred on the Indradrive, the error information is latched until cleared with
+	/// this call.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Use get_diagnostic_message() and/or get_diagnostic_num() for retrieving the error information.
+	///
+	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int clear_error(int ID_ref, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	API reference (see init()).
+	/// @param [out]	ID_err	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV clear_error(SISHandle ID_ref, ErrHandle ID_err = ErrHandle());
+
+	/// Gets the timing of the telegram exchanges with the device.
+	/// 
+	/// Each exchange is measured from its request until the first byte of the command telegram is handed to the
+	/// serial port (includes waiting for other exchanges in progress), and until the reaction has been received
+	/// completely. Distributions are provided as mean, minimum, maximum and percentiles.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Refer to apps/SpeedControlBenchmark for measuring the achievable setpoint rate.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int get_link_timing(int ID_ref, ref SISLinkTiming ID_timing, Byte ID_reset, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			timing = SISLinkTiming()
+	/// 			result = indralib.get_link_timing(indraref, ctypes.byref(timing), 1, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref   	API reference (see init()).
+	/// @param [out]	ID_timing	Timing of the exchanges since open or the last reset. Latencies in [us].
+	/// @param [in]		ID_reset 	(Optional) If not 0, the measurements are reset after reading.
+	/// @param [out]	ID_err   	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV get_link_timing(SISHandle ID_ref, SISLinkTiming * ID_timing, uint8_t ID_reset = 0, ErrHandle ID_err = ErrHandle());
+
+	/// Gets the health of the serial link: Link losses, reconnects, and replayed exchanges (see supervisor_start()).
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int get_link_health(int ID_ref, ref SISLinkHealth ID_health, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			health = SISLinkHealth()
+	/// 			result = indralib.get_link_health(indraref, ctypes.byref(health), ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref   	API reference (see init()).
+	/// @param [out]	ID_health	Health of the link since init().
+	/// @param [out]	ID_err   	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV get_link_health(SISHandle ID_ref, SISLinkHealth * ID_health, ErrHandle ID_err = ErrHandle());
+
+	/// Gets the traffic on the serial link, and its utilisation.
+	/// 
+	/// Bytes and telegrams are counted per SIS service, per priority class, and per parameter. The airtime of the
+	/// bytes is derived from the baud rate (10 bits per byte), and related to the duration of the measurement. Thus,
+	/// the utilisation tells how close the line is to saturation, and which parameters take the most of it.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int get_link_stats(int ID_ref, ref SISLinkStats ID_stats, Byte ID_reset, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			stats = SISLinkStats()
+	/// 			result = indralib.get_link_stats(indraref, ctypes.byref(stats), 1, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref  	API reference (see init()).
+	/// @param [out]	ID_stats	Traffic since open or the last reset (see SISLinkStats).
+	/// @param [in]		ID_reset	(Optional) If not 0, the counters are reset after reading.
+	/// @param [out]	ID_err  	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV get_link_stats(SISHandle ID_ref, SISLinkStats * ID_stats, uint8_t ID_reset = 0, ErrHandle ID_err = ErrHandle());
+
+	/// Plans the link budget of cyclic parameter accesses: Computes the required airtime at the current baud rate, tells
+	/// whether the accesses fit, and which periods to relax otherwise.
+	/// 
+	/// The airtime is computed from the sizes of the real telegrams (SIS header, SERCOS payload head and data of command
+	/// and reaction) at 10 bits per byte. Accesses of the same period are gathered into sequential telegrams, as done
+	/// by events_start() or read_params(). If the load exceeds the limit, the period of the access with the highest load
+	/// is doubled repeatedly, until the accesses fit.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	The limit leaves headroom for commands and for the turnaround of the device, which is not included
+	/// 			in the airtime. Verify the plan with get_link_stats() on the machine.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int plan_link_budget(int ID_ref, [In, Out] SISCyclicTask[] ID_tasks, UInt16 ID_len, Double ID_limit, Byte ID_sequential, ref SISLinkBudget ID_budget, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			tasks = (SISCyclicTask * 2)()
+	/// 			tasks[0].ParamNum = 40; tasks[0].Period = 10
+	/// 			tasks[1].ParamNum = 36; tasks[1].Write = 1; tasks[1].Period = 5
+	/// 			budget = SISLinkBudget()
+	/// 			result = indralib.plan_link_budget(indraref, tasks, 2, ctypes.c_double(0.8), 1, ctypes.byref(budget), ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref		 	API reference (see init()). Has to be opened (see open()).
+	/// @param [in,out]	ID_tasks	 	Cyclic accesses. Data lengths of 0 are read from the parameter attributes.
+	/// 								Airtime, load and relaxed period are set per access.
+	/// @param [in]		ID_len		 	Number of accesses (=number of elements of ID_tasks).
+	/// @param [in]		ID_limit	 	(Optional) Utilisation limit of the line (0 ... 1). Default: 0.8.
+	/// @param [in]		ID_sequential	(Optional) If not 0, accesses of the same period share sequential telegrams.
+	/// 								Default: 1.
+	/// @param [out]	ID_budget	 	(Optional) Link budget (see SISLinkBudget). Can be NULL.
+	/// @param [out]	ID_err		 	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV plan_link_budget(SISHandle ID_ref, SISCyclicTask ID_tasks[], uint16_t ID_len, double_t ID_limit = SISLINKPLANNER_LIMIT_DEFAULT, uint8_t ID_sequential = 1, SISLinkBudget * ID_budget = NULL, ErrHandle ID_err = ErrHandle());
+
+#pragma endregion API Status
+
+
+#pragma region API Commands
+
+	/// Starts the execution of an Indradrive command (e.g. S-0-0099 for C0500) without blocking the caller.
+	/// 
+	/// The returned command handle can be polled with command_getstate(), waited for with command_wait() and
+	/// cancelled with command_cancel(). Commands on different API references (drives) can thus run concurrently.
+	///
+	/// @attention	Every command handle has to be released by command_release() after use.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int execute_command_async(int ID_ref, Byte ID_paramvar, UInt16 ID_paramnum, ref UInt32 ID_cmd, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			cmd = ctypes.c_uint32(0)
+	/// 			result = indralib.execute_command_async(indraref, 0, 99, ctypes.byref(cmd), ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	  	API reference (see init()).
+	/// @param [in]		ID_paramvar	Parameter variant of the command: 0 for S-Parameter, 1 for P-Parameter.
+	/// @param [in]		ID_paramnum	Parameter number of the command (e.g. 99 for S-0-0099).
+	/// @param [out]	ID_cmd	  	Pointer that provides the command handle. Handles are released by command_release().
+	/// @param [out]	ID_err	  	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV execute_command_async(SISHandle ID_ref, uint8_t ID_paramvar, uint16_t ID_paramnum, SISCommandHandle * ID_cmd, ErrHandle ID_err = ErrHandle());
+
+	/// Non-blocking variant of clear_error(). Starts clearing a latched error (C0500) in the background.
+	///
+	/// @attention	Every command handle has to be released by command_release() after use.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int clear_error_async(int ID_ref, ref UInt32 ID_cmd, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	API reference (see init()).
+	/// @param [out]	ID_cmd	Pointer that provides the command handle.
+	/// @param [out]	ID_err	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV clear_error_async(SISHandle ID_ref, SISCommandHandle * ID_cmd, ErrHandle ID_err = ErrHandle());
+
+	/// Non-blocking variant of sequencer_activate(). Starts the drive mode change in the background.
+	///
+	/// @attention	Every command handle has to be released by command_release() after use.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Cancellation is only effective until the parameterization level (C0400) has been entered. Once
+	/// 			entered, the drive mode is written and the parameterization level is left regularly (C0200), so
+	/// 			that the drive is never left in parameterization level.
+	///
+	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int sequencer_activate_async(int ID_ref, ref UInt32 ID_cmd, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	API reference (see init()).
+	/// @param [out]	ID_cmd	Pointer that provides the command handle.
+	/// @param [out]	ID_err	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV sequencer_activate_async(SISHandle ID_ref, SISCommandHandle * ID_cmd, ErrHandle ID_err = ErrHandle());
+
+	/// Non-blocking variant of speedcontrol_activate(). Starts the drive mode change in the background.
+	///
+	/// @attention	Every command handle has to be released by command_release() after use.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Cancellation behaves as described for sequencer_activate_async().
+	///
+	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int speedcontrol_activate_async(int ID_ref, ref UInt32 ID_cmd, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	API reference (see init()).
+	/// @param [out]	ID_cmd	Pointer that provides the command handle.
+	/// @param [out]	ID_err	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV speedcontrol_activate_async(SISHandle ID_ref, SISCommandHandle * ID_cmd, ErrHandle ID_err = ErrHandle());
+
+	/// Gets the processing state of a command handle without blocking.
+	/// 
+	/// The processing state is provided by <c>ID_state</c> parameter. The following table depicts the coding:
+	/// 
+	/// If | Then
+	/// -- | -----------
+	/// <c>*ID_state == 0</c> | Command is still being processed
+	/// <c>*ID_state == 1</c> | Command has been finished successfully
+	/// <c>*ID_state == 2</c> | Command execution failed (the error handle provides the reason)
+	/// <c>*ID_state == 3</c> | Command execution has been canceled.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int command_getstate(UInt32 ID_cmd, ref Byte ID_state, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			cmdstate = ctypes.c_uint8(0)
+	/// 			result = indralib.command_getstate(cmd, ctypes.byref(cmdstate), ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_cmd  	Command handle.
+	/// @param [out]	ID_state	Pointer that provides the processing state.
+	/// @param [out]	ID_err  	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV command_getstate(SISCommandHandle ID_cmd, uint8_t * ID_state, ErrHandle ID_err = ErrHandle());
+
+	/// Waits until the command has been processed or the timeout has elapsed.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	The coding of <c>ID_state</c> is described at command_getstate().
+	///
+	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int command_wait(UInt32 ID_cmd, UInt32 ID_timeout, ref Byte ID_state, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			cmdstate = ctypes.c_uint8(0)
+	/// 			result = indralib.command_wait(cmd, 5000, ctypes.byref(cmdstate), ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_cmd    	Command handle.
+	/// @param [in]		ID_timeout	Timeout in [ms]. 0xFFFFFFFF waits infinitely.
+	/// @param [out]	ID_state  	Pointer that provides the processing state after waiting.
+	/// @param [out]	ID_err    	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV command_wait(SISCommandHandle ID_cmd, uint32_t ID_timeout, uint8_t * ID_state, ErrHandle ID_err = ErrHandle());
+
+	/// Requests the cancellation of a command. The call returns immediately.
+	/// 
+	/// A running Indradrive command is interrupted by Commandrequest_Cancel and deleted afterwards. Use command_wait()
+	/// to wait for the cancellation to be completed.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int command_cancel(UInt32 ID_cmd, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_cmd	Command handle.
+	/// @param [out]	ID_err	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV command_cancel(SISCommandHandle ID_cmd, ErrHandle ID_err = ErrHandle());
+
+	/// Releases a command handle.
+	/// 
+	/// @attention	Blocks until the command has been processed. Call command_cancel() first for a quick release.
+	///
+	/// @remarks	The handle is invalid for other calls immediately. Calls in progress with the handle (e.g.
+	/// 			command_wait()) are completed before the command is deleted.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int command_release(UInt32 ID_cmd, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_cmd	Command handle.
+	/// @param [out]	ID_err	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV command_release(SISCommandHandle ID_cmd, ErrHandle ID_err = ErrHandle());
+
+#pragma endregion API Commands
+
+
+#pragma region API Batch
+
+	/// Starts a batch of parameter writes.
+	/// 
+	/// Writes are queued by batch_write_param() and batch_write_listelm(), and applied at once by batch_commit().
+	/// Calling batch_begin() again discards writes that have not been committed yet.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int batch_begin(int ID_ref, Byte ID_paramlevel, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			result = indralib.batch_begin(indraref, 1, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref			API reference (see init()).
+	/// @param [in]		ID_paramlevel	(Optional) If not 0, the writes are applied within parameterization level 1
+	/// 								(C0400 ... C0200), which is needed for parameters such as S-0-0032. Default: 0.
+	/// @param [out]	ID_err			(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV batch_begin(SISHandle ID_ref, uint8_t ID_paramlevel = 0, ErrHandle ID_err = ErrHandle());
+
+	/// Queues a parameter write into the current batch.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int batch_write_param(int ID_ref, Byte ID_paramvar, UInt16 ID_paramnum, Double ID_value, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			result = indralib.batch_write_param(indraref, 0, 32, ctypes.c_double(0b111011), ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	  	API reference (see init()).
+	/// @param [in]		ID_paramvar	Parameter variant: 0 for S-Parameter, 1 for P-Parameter.
+	/// @param [in]		ID_paramnum	Parameter number.
+	/// @param [in]		ID_value  	Value to be written. Scaled by the decimal places of the parameter's attribute.
+	/// @param [out]	ID_err	  	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV batch_write_param(SISHandle ID_ref, uint8_t ID_paramvar, uint16_t ID_paramnum, double_t ID_value, ErrHandle ID_err = ErrHandle());
+
+	/// Queues a list element write into the current batch.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	The list size is adjusted once per list to the highest element written.
+	///
+	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int batch_write_listelm(int ID_ref, Byte ID_paramvar, UInt16 ID_paramnum, UInt16 ID_elm_pos, Double ID_value, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			result = indralib.batch_write_listelm(indraref, 1, 4007, 1, ctypes.c_double(100), ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	  	API reference (see init()).
+	/// @param [in]		ID_paramvar	Parameter variant: 0 for S-Parameter, 1 for P-Parameter.
+	/// @param [in]		ID_paramnum	Parameter number.
+	/// @param [in]		ID_elm_pos	Position of the list element.
+	/// @param [in]		ID_value  	Value to be written. Scaled by the decimal places of the parameter's attribute.
+	/// @param [out]	ID_err	  	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV batch_write_listelm(SISHandle ID_ref, uint8_t ID_paramvar, uint16_t ID_paramnum, uint16_t ID_elm_pos, double_t ID_value, ErrHandle ID_err = ErrHandle());
+
+	/// Commits the current batch of parameter writes.
+	/// 
+	/// Writes to the same parameter or list element are coalesced (last write wins) and ordered by parameter and list
+	/// element. Writes are transmitted in as few telegrams as possible (SIS service 0x04). The batch is finished
+	/// afterwards, even if some writes failed.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int batch_commit(int ID_ref, UInt16[] ID_results, UInt32 ID_results_len, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			results = (ctypes.c_uint16 * 16)()
+	/// 			result = indralib.batch_commit(indraref, results, 16, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref		  	API reference (see init()).
+	/// @param [out]	ID_results	  	(Optional) Array that provides one result per queued write, in the order of the
+	/// 								queueing calls: SIS error code of the write, or 0 if succeeded. Coalesced writes
+	/// 								report the result of the write that superseded them. Writes that have not been
+	/// 								executed report 0xFFFF (SISPARAMSESSION_NOT_EXECUTED). Can be NULL.
+	/// @param [in]		ID_results_len	Number of elements of ID_results.
+	/// @param [out]	ID_err		  	(Optional) Error handle. Lists all failed writes.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV batch_commit(SISHandle ID_ref, uint16_t * ID_results, uint32_t ID_results_len, ErrHandle ID_err = ErrHandle());
+
+	/// Reads several parameters at once.
+	///
+	/// All parameters are read in as few telegrams as possible (SIS service 0x04): Attributes first, followed by the
+	/// values. Thus, a whole set of parameters takes a single call and a few link round trips.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Only single-value parameters are supported. Lists are read by their list elements.
+	///
+	/// @remarks	Values above 2^53 (e.g. 64-bit parameters) lose precision as double. Use read_params_int() for them.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int read_params(int ID_ref, Byte[] ID_paramvars, UInt16[] ID_paramnums, Double[] ID_values, UInt16[] ID_errors, UInt16 ID_len, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			paramvars = (ctypes.c_uint8 * 3)(0, 1, 0)
+	/// 			paramnums = (ctypes.c_uint16 * 3)(40, 115, 390)
+	/// 			values = (ctypes.c_double * 3)()
+	/// 			errors = (ctypes.c_uint16 * 3)()
+	/// 			result = indralib.read_params(indraref, paramvars, paramnums, values, errors, 3, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref		 	API reference (see init()).
+	/// @param [in]		ID_paramvars 	Parameter variants: 0 for S-Parameter, 1 for P-Parameter.
+	/// @param [in]		ID_paramnums 	Parameter numbers.
+	/// @param [out]	ID_values	 	Values, scaled by the decimal places of the parameters' attributes. 0 if failed.
+	/// @param [out]	ID_errors	 	(Optional) SIS error code per parameter, or 0 if succeeded. Can be NULL.
+	/// @param [in]		ID_len		 	Number of parameters (=number of elements of each array).
+	/// @param [out]	ID_err		 	(Optional) Error handle. Lists all failed parameters.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV read_params(SISHandle ID_ref, uint8_t ID_paramvars[], uint16_t ID_paramnums[], double_t ID_values[], uint16_t ID_errors[], const uint16_t ID_len, ErrHandle ID_err = ErrHandle());
+
+	/// Reads several parameters at once, as integers.
+	///
+	/// Like read_params(), but the values are delivered as the operation data of the parameters, so that 64-bit
+	/// values (e.g. S-0-0032) are kept exactly.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Values are not scaled by the decimal places of the parameters' attributes, and are zero-extended by
+	/// 			the data length. Values of signed parameters are to be casted to the signed type of their length.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int read_params_int(int ID_ref, Byte[] ID_paramvars, UInt16[] ID_paramnums, UInt64[] ID_values, UInt16[] ID_errors, UInt16 ID_len, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			paramvars = (ctypes.c_uint8 * 2)(0, 1)
+	/// 			paramnums = (ctypes.c_uint16 * 2)(32, 115)
+	/// 			values = (ctypes.c_uint64 * 2)()
+	/// 			errors = (ctypes.c_uint16 * 2)()
+	/// 			result = indralib.read_params_int(indraref, paramvars, paramnums, values, errors, 2, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref		 	API reference (see init()).
+	/// @param [in]		ID_paramvars 	Parameter variants: 0 for S-Parameter, 1 for P-Parameter.
+	/// @param [in]		ID_paramnums 	Parameter numbers.
+	/// @param [out]	ID_values	 	Operation data of the parameters. 0 if failed.
+	/// @param [out]	ID_errors	 	(Optional) SIS error code per parameter, or 0 if succeeded. Can be NULL.
+	/// @param [in]		ID_len		 	Number of parameters (=number of elements of each array).
+	/// @param [out]	ID_err		 	(Optional) Error handle. Lists all failed parameters.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV read_params_int(SISHandle ID_ref, uint8_t ID_paramvars[], uint16_t ID_paramnums[], uint64_t ID_values[], uint16_t ID_errors[], const uint16_t ID_len, ErrHandle ID_err = ErrHandle());
+
+	/// Writes several parameters at once.
+	///
+	/// Like batch_commit(), but without parameterization level and in a single call: Writes to the same parameter are
+	/// coalesced (last write wins), and all writes are transmitted in as few telegrams as possible (SIS service 0x04).
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Parameters that can only be written in parameterization level 1 (e.g. S-0-0032) require
+	/// 			batch_begin() ... batch_commit() instead.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int write_params(int ID_ref, Byte[] ID_paramvars, UInt16[] ID_paramnums, Double[] ID_values, UInt16[] ID_errors, UInt16 ID_len, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			paramvars = (ctypes.c_uint8 * 2)(1, 1)
+	/// 			paramnums = (ctypes.c_uint16 * 2)(1203, 1200)
+	/// 			values = (ctypes.c_double * 2)(10, 0)
+	/// 			result = indralib.write_params(indraref, paramvars, paramnums, values, None, 2, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref		 	API reference (see init()).
+	/// @param [in]		ID_paramvars 	Parameter variants: 0 for S-Parameter, 1 for P-Parameter.
+	/// @param [in]		ID_paramnums 	Parameter numbers.
+	/// @param [in]		ID_values	 	Values to be written. Scaled by the decimal places of the parameters' attributes.
+	/// @param [out]	ID_errors	 	(Optional) SIS error code per parameter, or 0 if succeeded. Writes that have not
+	/// 								been executed report 0xFFFF (SISPARAMSESSION_NOT_EXECUTED). Can be NULL.
+	/// @param [in]		ID_len		 	Number of parameters (=number of elements of each array).
+	/// @param [out]	ID_err		 	(Optional) Error handle. Lists all failed writes.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV write_params(SISHandle ID_ref, uint8_t ID_paramvars[], uint16_t ID_paramnums[], double_t ID_values[], uint16_t ID_errors[], const uint16_t ID_len, ErrHandle ID_err = ErrHandle());
+
+	/// Writes several parameters at once, as integers.
+	///
+	/// Like write_params(), but the values are written as the operation data of the parameters, so that 64-bit values
+	/// (e.g. S-0-0032) are kept exactly.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Values are not scaled by the decimal places of the parameters' attributes, and are truncated to the
+	/// 			data length. Negative values are passed in two's complement.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int write_params_int(int ID_ref, Byte[] ID_paramvars, UInt16[] ID_paramnums, UInt64[] ID_values, UInt16[] ID_errors, UInt16 ID_len, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			paramvars = (ctypes.c_uint8 * 1)(1)
+	/// 			paramnums = (ctypes.c_uint16 * 1)(1200)
+	/// 			values = (ctypes.c_uint64 * 1)(1024)
+	/// 			result = indralib.write_params_int(indraref, paramvars, paramnums, values, None, 1, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref		 	API reference (see init()).
+	/// @param [in]		ID_paramvars 	Parameter variants: 0 for S-Parameter, 1 for P-Parameter.
+	/// @param [in]		ID_paramnums 	Parameter numbers.
+	/// @param [in]		ID_values	 	Operation data to be written.
+	/// @param [out]	ID_errors	 	(Optional) SIS error code per parameter, or 0 if succeeded. Writes that have not
+	/// 								been executed report 0xFFFF (SISPARAMSESSION_NOT_EXECUTED). Can be NULL.
+	/// @param [in]		ID_len		 	Number of parameters (=number of elements of each array).
+	/// @param [out]	ID_err		 	(Optional) Error handle. Lists all failed writes.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV write_params_int(SISHandle ID_ref, uint8_t ID_paramvars[], uint16_t ID_paramnums[], uint64_t ID_values[], uint16_t ID_errors[], const uint16_t ID_len, ErrHandle ID_err = ErrHandle());
+
+#pragma endregion API Batch
+
+
+#pragma region API Events
+
+	/// Starts monitoring the drive for events.
+	/// 
+	/// A sampler thread reads the device control status word (P-0-0115), the diagnostic number (S-0-0390) and the
+	/// primary operation mode (S-0-0032) in a single telegram per interval. Each change is pushed into an event queue
+	/// (see events_poll()) and passed to the registered callbacks (see events_register()). On start, one event per
+	/// parameter reports the initial state.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Refer to @ref sec_Examples "Examples" for detailed code examples.
 	///
 	/// @remarks	How to call with C\#:
 	/// 			@code{.cs}
 	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
-	/// 			private static extern int clear_error(int ID_ref, ref ErrHandle ID_err);
+	/// 			private static extern int events_start(int ID_ref, UInt32 ID_interval, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			result = indralib.events_start(indraref, 100, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	  	API reference (see init()).
+	/// @param [in]		ID_interval	(Optional) Sampling interval in [ms]. Default: 100.
+	/// @param [out]	ID_err	  	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV events_start(SISHandle ID_ref, uint32_t ID_interval = SISMONITOR_INTERVAL_DEFAULT, ErrHandle ID_err = ErrHandle());
+
+	/// Stops monitoring the drive for events. Events that have not been polled yet are discarded.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Monitoring is stopped by close() as well.
+	///
+	/// @remarks	May be called from within the callback (see events_register()). The sampler thread then ends once
+	/// 			the callback has returned, instead of being joined.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int events_stop(int ID_ref, ref ErrHandle ID_err);
 	/// 			@endcode.
 	///
-	/// @param [in]		ID_ref	API reference. Pointer can be casted in from UINT32.
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			result = indralib.events_stop(indraref, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	API reference (see init()).
 	/// @param [out]	ID_err	(Optional) Error handle.
 	///
 	/// @return	Error handle return code (ErrHandle()).
-	DLLEXPORT int32_t DLLCALLCONV clear_error(SISProtocol* ID_ref, ErrHandle ID_err = ErrHandle());
+	DLLEXPORT int32_t DLLCALLCONV events_stop(SISHandle ID_ref, ErrHandle ID_err = ErrHandle());
 
-#pragma endregion API Status
+	/// Registers a callback that is fired on each drive event. Has to be called after events_start().
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	The callback is called from within the sampler thread. It shall return quickly, since sampling is
+	/// 			paused meanwhile. Calling API functions from within the callback is allowed. If events_stop() or
+	/// 			close() is called from within the callback, the sampler thread is not joined, but ends once the
+	/// 			callback has returned. Thus, the callback must not rely on the reference after calling close().
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+	/// 			public delegate void EventCallback(ref SISEvent ID_event, IntPtr ID_user);
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int events_register(int ID_ref, EventCallback ID_callback, IntPtr ID_user, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			EVENTCALLBACK = ctypes.CFUNCTYPE(None, ctypes.POINTER(SISEvent), ctypes.c_void_p)
+	/// 			callback = EVENTCALLBACK(on_event)
+	/// 			result = indralib.events_register(indraref, callback, None, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	   	API reference (see init()).
+	/// @param [in]		ID_callback	Callback function. Receives the event and the user data.
+	/// @param [in]		ID_user	   	(Optional) User data passed to the callback. Can be NULL.
+	/// @param [out]	ID_err	   	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV events_register(SISHandle ID_ref, SISEventCallback ID_callback, void * ID_user = NULL, ErrHandle ID_err = ErrHandle());
+
+	/// Takes the oldest event from the event queue.
+	/// 
+	/// The queue holds up to SISMONITOR_QUEUE_SIZE events. If exceeded, the oldest events are dropped.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int events_poll(int ID_ref, ref SISEvent ID_event, ref Byte ID_available, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			event = SISEvent()
+	/// 			available = ctypes.c_uint8()
+	/// 			result = indralib.events_poll(indraref, ctypes.byref(event), ctypes.byref(available), ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref		 	API reference (see init()).
+	/// @param [out]	ID_event	 	Event taken from the queue, if available. Type is defined by SISEventType;
+	/// 								values of SISEvent_Opstate can be decoded like get_opstate() does.
+	/// @param [out]	ID_available	1 if an event has been taken, 0 if the queue is empty.
+	/// @param [out]	ID_err		 	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV events_poll(SISHandle ID_ref, SISEvent * ID_event, uint8_t * ID_available, ErrHandle ID_err = ErrHandle());
+
+	/// Attaches the drive to the reactor, which samples parameters of many drives cyclically from a single thread.
+	/// 
+	/// Unlike events_start(), no thread is started per drive. The reactor drives the exchanges of all attached drives
+	/// by overlapped I/O on their serial ports, and keeps timeouts and sampling intervals in a timer wheel. Thus, a
+	/// single thread serves dozens of drives on separate ports. The last samples are read by reactor_read(). Drives
+	/// opened over a TCP gateway cannot be attached.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Up to SISREACTOR_LINKS_MAX drives can be attached. The scaling of the parameters is read in by this
+	/// 			call. The link is released after each read of a sampling cycle, and the next read is postponed while
+	/// 			the application communicates with the drive.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int reactor_attach(int ID_ref, SISReactorParam[] ID_params, UInt16 ID_len, UInt32 ID_interval, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			params = (SISReactorParam * 2)()
+	/// 			params[0].ParamNum = 40
+	/// 			params[1].ParamVar = 1; params[1].ParamNum = 115
+	/// 			result = indralib.reactor_attach(indraref, params, 2, 100, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	  	API reference (see init()). Has to be opened (see open()).
+	/// @param [in]		ID_params  	Parameters to be sampled (see SISReactorParam).
+	/// @param [in]		ID_len	  	Number of parameters (=number of elements of ID_params): 1 ... SISREACTOR_PARAMS_MAX.
+	/// @param [in]		ID_interval	(Optional) Sampling interval in [ms]. Default: 100.
+	/// @param [out]	ID_err	  	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV reactor_attach(SISHandle ID_ref, const SISReactorParam ID_params[], const uint16_t ID_len, uint32_t ID_interval = SISREACTOR_INTERVAL_DEFAULT, ErrHandle ID_err = ErrHandle());
+
+	/// Detaches the drive from the reactor. A pending sampling cycle is aborted.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	The drive is detached by close() as well.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int reactor_detach(int ID_ref, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			result = indralib.reactor_detach(indraref, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	API reference (see init()).
+	/// @param [out]	ID_err	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV reactor_detach(SISHandle ID_ref, ErrHandle ID_err = ErrHandle());
+
+	/// Reads the last samples of the drive, taken by the reactor (see reactor_attach()).
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int reactor_read(int ID_ref, [Out] SISReactorSample[] ID_samples, UInt16 ID_len, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			samples = (SISReactorSample * 2)()
+	/// 			result = indralib.reactor_read(indraref, samples, 2, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	  	API reference (see init()).
+	/// @param [out]	ID_samples	Last samples, in order of the parameters of reactor_attach() (see SISReactorSample).
+	/// @param [in]		ID_len	  	Number of elements of ID_samples.
+	/// @param [out]	ID_err	  	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV reactor_read(SISHandle ID_ref, SISReactorSample ID_samples[], const uint16_t ID_len, ErrHandle ID_err = ErrHandle());
+
+#pragma endregion API Events
+
+
+#pragma region API Scope
+
+	/// Configures the internal oscilloscope of the drive: Signals, trigger and sampling.
+	/// 
+	/// The oscilloscope records the signals at the servo cycle, independent of the link speed. All configuration
+	/// parameters (P-0-0023 ... P-0-0033) are written in as few telegrams as possible (SIS service 0x04).
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int scope_configure(int ID_ref, ref SISScopeConfig ID_config, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			config = SISScopeConfig((0, 0), (40, 84), 0, 40, ctypes.c_double(500), 1, 1000, 1024, 512)
+	/// 			result = indralib.scope_configure(indraref, ctypes.byref(config), ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref   	API reference (see init()).
+	/// @param [in]		ID_config	Oscilloscope configuration.
+	/// @param [out]	ID_err   	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV scope_configure(SISHandle ID_ref, SISScopeConfig * ID_config, ErrHandle ID_err = ErrHandle());
+
+	/// Arms the oscilloscope. Recording starts, and the trigger event is awaited.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int scope_arm(int ID_ref, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			result = indralib.scope_arm(indraref, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	API reference (see init()).
+	/// @param [out]	ID_err	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV scope_arm(SISHandle ID_ref, ErrHandle ID_err = ErrHandle());
+
+	/// Waits until the oscilloscope recording has been completed or the timeout has elapsed.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int scope_wait(int ID_ref, UInt32 ID_timeout, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			result = indralib.scope_wait(indraref, 5000, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	  	API reference (see init()).
+	/// @param [in]		ID_timeout	Timeout in [ms]. An error is returned if exceeded.
+	/// @param [out]	ID_err	  	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV scope_wait(SISHandle ID_ref, uint32_t ID_timeout, ErrHandle ID_err = ErrHandle());
+
+	/// Downloads the recorded samples of an oscilloscope channel.
+	/// 
+	/// The memory list (P-0-0021, P-0-0022) is read in segments that fill whole telegrams, and decoded as a whole by
+	/// the scaling of the recorded signal.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int scope_download(int ID_ref, Byte ID_channel, Double[] ID_values, UInt32 ID_len, ref UInt32 ID_count, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			values = (ctypes.c_double * 1024)()
+	/// 			count = ctypes.c_uint32()
+	/// 			result = indralib.scope_download(indraref, 0, values, 1024, ctypes.byref(count), ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	  	API reference (see init()).
+	/// @param [in]		ID_channel	Channel: 0 for channel 1, 1 for channel 2.
+	/// @param [out]	ID_values 	Recorded samples, scaled by the decimal places of the recorded signal.
+	/// @param [in]		ID_len	  	Number of elements of ID_values.
+	/// @param [out]	ID_count  	Number of samples that have been downloaded.
+	/// @param [out]	ID_err	  	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV scope_download(SISHandle ID_ref, uint8_t ID_channel, double_t ID_values[], uint32_t ID_len, uint32_t * ID_count, ErrHandle ID_err = ErrHandle());
+
+#pragma endregion API Scope
+
+
+#pragma region API Backup
+
+	/// Backs up the parameters of the drive into a compact binary image file.
+	/// 
+	/// The parameters are enumerated by an IDN list (S-0-0192 by default). Attributes and values are read in as few
+	/// telegrams as possible (SIS service 0x04). The image holds a header, an index of all parameters with their
+	/// attributes, and the operation data (see SISBackupHeader and SISBackupIndex). Parameters that cannot be read are
+	/// kept in the index with their SIS error code.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	Use backup_parameters_parallel() to back up several drives at once.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int backup_parameters(int ID_ref, string ID_path, UInt16 ID_idnlist, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			result = indralib.backup_parameters(indraref, "drive1.isbk", 192, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref	  	API reference (see init()).
+	/// @param [in]		ID_path	  	Path of the image file. Overwritten, if existing.
+	/// @param [in]		ID_idnlist	(Optional) IDN list of the parameters: 192 for S-0-0192 (backup operation data), 17
+	/// 							for S-0-0017 (all operation data). Default: 192.
+	/// @param [out]	ID_err	  	(Optional) Error handle.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV backup_parameters(SISHandle ID_ref, const wchar_t * ID_path, uint16_t ID_idnlist = SISBACKUP_IDNLIST, ErrHandle ID_err = ErrHandle());
+
+	/// Backs up the parameters of several drives in parallel, one thread per drive (see backup_parameters()).
+	/// 
+	/// Each drive has to be connected by its own API reference, i.e. its own communication port. The call returns
+	/// when all backups have finished.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int backup_parameters_parallel(int[] ID_refs, string[] ID_paths, UInt16 ID_len, UInt16 ID_idnlist, Int32[] ID_results, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			refs = (ctypes.c_uint32 * 2)(indraref1, indraref2)
+	/// 			paths = (ctypes.c_wchar_p * 2)("drive1.isbk", "drive2.isbk")
+	/// 			results = (ctypes.c_int32 * 2)()
+	/// 			result = indralib.backup_parameters_parallel(refs, paths, 2, 192, results, ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_refs	  	API references (see init()), one per drive. Each reference must be given once.
+	/// @param [in]		ID_paths  	Paths of the image files, one per drive.
+	/// @param [in]		ID_len	  	Number of drives (=number of elements of each array).
+	/// @param [in]		ID_idnlist	IDN list of the parameters (see backup_parameters()).
+	/// @param [out]	ID_results	(Optional) Error code per drive, as returned by backup_parameters(), or Err_NoError if
+	/// 							succeeded. Can be NULL.
+	/// @param [out]	ID_err	  	(Optional) Error handle. Lists all failed backups.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV backup_parameters_parallel(SISHandle ID_refs[], const wchar_t * ID_paths[], uint16_t ID_len, uint16_t ID_idnlist = SISBACKUP_IDNLIST, int32_t ID_results[] = NULL, ErrHandle ID_err = ErrHandle());
+
+	/// Restores a backup image onto the drive, writing only parameters that differ from the image.
+	/// 
+	/// The current values of all parameters of the image are read in bulk first. Only differing parameters are
+	/// written, within a single parameterization level bracket, and read back in bulk to verify them. Restoring an
+	/// image that equals the drive causes no writes at all, which spares the flash memory of the drive.
+	///
+	/// @remarks	This function is exported to the Indradrive API DLL.
+	///
+	/// @remarks	How to call with C\#:
+	/// 			@code{.cs}
+	/// 			[DllImport(dllpath, CharSet = CharSet.Unicode, CallingConvention = CallingConvention.Cdecl)]
+	/// 			private static extern int restore_parameters(int ID_ref, string ID_path, ref SISRestoreStats ID_stats, ref ErrHandle ID_err);
+	/// 			@endcode.
+	///
+	/// @remarks	How to call with Python:
+	/// 			@code{.py}
+	/// 			stats = SISRestoreStats()
+	/// 			result = indralib.restore_parameters(indraref, "drive1.isbk", ctypes.byref(stats), ctypes.byref(indra_error))
+	/// 			@endcode.
+	///
+	/// @param [in]		ID_ref  	API reference (see init()).
+	/// @param [in]		ID_path 	Path of the image file (see backup_parameters()).
+	/// @param [out]	ID_stats	(Optional) Statistics of the restore (see SISRestoreStats). Set even if the restore
+	/// 							failed partly. Can be NULL.
+	/// @param [out]	ID_err  	(Optional) Error handle. Lists all parameters that could not be restored.
+	///
+	/// @return	Error handle return code (ErrHandle()).
+	DLLEXPORT int32_t DLLCALLCONV restore_parameters(SISHandle ID_ref, const wchar_t * ID_path, SISRestoreStats * ID_stats = NULL, ErrHandle ID_err = ErrHandle());
+
+#pragma endregion API Backup
 	
 	/* \cond Do not document this */
 	
@@ -715,26 +2170,80 @@ extern "C" {  /*  using a C++ compiler  */
 
 	/// Called by speedcontrol_activate() and sequencer_activate() to set the desired operation mode.
 	///
-	/// @param [in]	ID_ref	API reference. Pointer can be casted in from UINT32.
+	/// @param [in]	ID_ref	API reference (see init()).
 	/// @param [in]	opmode	Desired operation mode. Use constants DRIVEMODE_SEQUENCER as well as DRIVEMODE_SPEEDCONTROL
 	/// 					for setting.
-	inline void change_opmode(SISProtocol * ID_ref, const uint64_t opmode);
+	/// @param [in]	ID_cmd	(Optional) Command handle, if called asynchronously. Used for cancellation.
+	inline void change_opmode(SISProtocol * ID_ref, const uint64_t opmode, SISCommand * ID_cmd = NULL);
+
+	/// Writes the positioning blocks of a sequence. Used by sequencer_write() and sequencer_write_bank().
+	///
+	/// @param [in]	ID_ref	API reference (see init()).
+	/// @param [in]	offset	Index of the first step within the positioning block lists.
+	/// @param [in]	speeds	Speed list in [1/min].
+	/// @param [in]	accels	Acceleration list in [rad/s^2].
+	/// @param [in]	jerks 	Jerk list in [rad/s^3].
+	/// @param [in]	delays	Delay list in [cs].
+	/// @param [in]	length	Length of the sequence.
+	/// @param [in]	retain	True to keep the list elements behind the sequence (e.g. of the other bank), false to cut
+	/// 					the lists off behind the sequence.
+	inline void write_sequence(SISProtocol * ID_ref, const uint16_t offset, double_t speeds[], double_t accels[], double_t jerks[], uint32_t delays[], const uint16_t length, const bool retain);
+
+	/// Reads the parameters of an IDN list, and writes them into a backup image. Used by backup_parameters() and
+	/// backup_parameters_parallel().
+	///
+	/// @param [in]	ID_ref 	API reference (see init()).
+	/// @param [in]	path   	Path of the image file.
+	/// @param [in]	idnlist	IDN list of the parameters.
+	inline void backup_drive(SISProtocol * ID_ref, const wchar_t * path, const uint16_t idnlist);
+
+	/// Detaches a reference from the reactor, and stops the reactor with the last link. Used by reactor_detach() and
+	/// close().
+	///
+	/// @param [in]	ID_ref	API reference (see init()).
+	inline void detach_reactor(SISProtocol * ID_ref);
+
+	/// Reports a result of SISProtocol::try_read_parameter() or SISProtocol::try_write_parameter() to the error
+	/// handle. Used by the exports whose reads and writes fail frequently (status, setpoints).
+	///
+	/// @param [out]	ID_err	Error handle.
+	/// @param [in]		result	Result of the operation.
+	/// @param [in]		block 	Error block code defined by EErrorBlocks enum.
+	///
+	/// @return	Err_NoError if succeeded, or the error handle return code.
+	inline int32_t set_result(ErrHandle ID_err, const SISResult& result, const int32_t block);
+
+	/// Invalidates the values last written by the speed setpoint channel and by the channel of a running streamer, so
+	/// that their next write transmits all fields.
+	/// Used by all functions that write the setpoint by other means, or change the state of the drive.
+	///
+	/// @param [in]	ID_ref	API reference (see init()).
+	inline void invalidate_channel(SISHandle ID_ref);
+
+	/// Registers a command that has been started by the *_async() functions, and provides its handle.
+	///
+	/// @param [in]		cmd   	Started command. Deleted if it cannot be registered.
+	/// @param [out]	ID_cmd	Pointer that provides the command handle.
+	/// @param [out]	ID_err	Error handle.
+	///
+	/// @return	Err_NoError if succeeded, or the error handle return code.
+	inline int32_t register_command(SISCommand * cmd, SISCommandHandle * ID_cmd, ErrHandle ID_err);
 
 	/// Gets the units.
 	///
-	/// @param [in]	ID_ref	API reference. Pointer can be casted in from UINT32.
+	/// @param [in]	ID_ref	API reference (see init()).
 	///
 	/// @return	Unit information.
 	inline SPEEDUNITS get_units(SISProtocol * ID_ref);
 
 	/// Change units according to the requirements. Used by set_stdenvironment().
 	///
-	/// @param [in]	ID_ref	API reference. Pointer can be casted in from UINT32.
+	/// @param [in]	ID_ref	API reference (see init()).
 	inline void change_units(SISProtocol * ID_ref);
 
 	/// Change language of the diagnostic messages.
 	///
-	/// @param [in]	ID_ref   	API reference. Pointer can be casted in from UINT32.
+	/// @param [in]	ID_ref   	API reference (see init()).
 	/// @param [in]	lang_code	(Optional) The language code:
 	/// 						* 0: German
 	/// 						* 1: English
@@ -0,0 +1,167 @@
+import sys
+import time
+import ctypes
+import argparse
+from ctypes import cdll
+import os
+
+# Minimum Python 3.3 required
+assert sys.version_info >= (3,3)
+
+
+# Load Indradrive API DLL into memory (use absolute or relative path for 'libpath')
+libpath = os.path.dirname(__file__) + "\\..\\..\\bin\\IndradriveAPI.dll"
+indralib = cdll.LoadLibrary(libpath)
+
+# Error-specific class
+class ERR(ctypes.Structure):
+    _fields_ = [("code", ctypes.c_int32),("msg", ctypes.c_char * 2048)]
+
+    def get_msg_str(self):
+        return str(self.msg, "UTF-8")
+
+# Latency distribution, see SISLatency (all times in us)
+class SISLatency(ctypes.Structure):
+    _pack_ = 1
+    _fields_ = [("Count", ctypes.c_uint32), ("Mean", ctypes.c_double), ("Min", ctypes.c_double), ("Max", ctypes.c_double),
+                ("P50", ctypes.c_double), ("P90", ctypes.c_double), ("P99", ctypes.c_double)]
+
+# Timing of telegram exchanges, see SISLinkTiming
+class SISLinkTiming(ctypes.Structure):
+    _pack_ = 1
+    _fields_ = [("Baudrate", ctypes.c_uint32), ("ToFirstByte", SISLatency), ("ToAck", SISLatency)]
+
+indra_error = ERR(0)
+
+
+def check_result(result):
+    if result:
+        print("Error occurred: " + indra_error.get_msg_str())
+        sys.exit(result)
+
+def percentile(values, p):
+    if not values: return 0.0
+    values = sorted(values)
+    return values[min(len(values) - 1, int(p * len(values)))]
+
+
+# Sends setpoints at the given rate for the given duration. Returns the measurements of this run.
+def run_rate(indraref, write, rate, duration, speed):
+    period = 1.0 / rate
+    latencies = []
+
+    # Reset library-side timing
+    timing = SISLinkTiming()
+    check_result(indralib.get_link_timing(indraref, ctypes.byref(timing), 1, ctypes.byref(indra_error)))
+
+    start = time.perf_counter()
+    deadline = start
+    n = 0
+    while True:
+        now = time.perf_counter()
+        if now - start >= duration: break
+
+        # Absolute deadlines, so that delays do not accumulate
+        if now < deadline:
+            time.sleep(deadline - now)
+
+        # Alternating setpoint, so that every call has to be transmitted
+        t_enqueue = time.perf_counter()
+        check_result(write(indraref, ctypes.c_double(speed + (n % 2)), ctypes.c_double(10), ctypes.byref(indra_error)))
+        latencies.append((time.perf_counter() - t_enqueue) * 1e6)
+
+        n += 1
+        deadline = start + n * period
+
+    elapsed = time.perf_counter() - start
+    check_result(indralib.get_link_timing(indraref, ctypes.byref(timing), 0, ctypes.byref(indra_error)))
+
+    achieved = n / elapsed
+    p99 = percentile(latencies, 0.99)
+    return {
+        "rate": rate,
+        "achieved": achieved,
+        "p50": percentile(latencies, 0.50),
+        "p99": p99,
+        "max": max(latencies) if latencies else 0.0,
+        "tgm_firstbyte_p99": timing.ToFirstByte.P99,
+        "tgm_ack_p50": timing.ToAck.P50,
+        "tgm_ack_p99": timing.ToAck.P99,
+        "telegrams": timing.ToAck.Count / max(n, 1),
+        # A rate is sustainable if it is reached and (almost) every setpoint is acknowledged within its period
+        "sustainable": achieved >= 0.95 * rate and p99 <= period * 1e6,
+    }
+
+
+def run_baudrate(args, baudrate):
+    # Getting API reference
+    indraref = indralib.init()
+
+    # Opening communication channel
+    result = indralib.open(indraref, args.port, baudrate, ctypes.byref(indra_error))
+    check_result(result)
+
+    # Check Drive Mode
+    drvmode = ctypes.c_uint32(0)
+    result = indralib.get_drivemode(indraref, ctypes.byref(drvmode), ctypes.byref(indra_error))
+    check_result(result)
+
+    if drvmode.value != 2:
+        print("Drive mode is not \"Speed Control\". Activate it first (e.g. by PythonApplication1).")
+        indralib.close(indraref, ctypes.byref(indra_error))
+        sys.exit(1)
+
+    if args.mode == "channel":
+        check_result(indralib.speedcontrol_channel_open(indraref, ctypes.byref(indra_error)))
+        write = indralib.speedcontrol_channel_write
+    else:
+        write = indralib.speedcontrol_write
+
+    print("\n%d Baud, %s" % (baudrate, "speedcontrol_channel_write()" if args.mode == "channel" else "speedcontrol_write()"))
+    print("%8s %9s %10s %10s %10s %9s %12s %12s %12s %s" % ("rate", "achieved", "call p50", "call p99", "call max", "tgm/call", "tgm 1stB p99", "tgm ack p50", "tgm ack p99", ""))
+
+    max_rate = 0
+    for rate in args.rates:
+        r = run_rate(indraref, write, rate, args.duration, args.speed)
+        print("%6d/s %7.1f/s %8.0fus %8.0fus %8.0fus %9.1f %10.0fus %10.0fus %10.0fus %s" % (
+            r["rate"], r["achieved"], r["p50"], r["p99"], r["max"], r["telegrams"],
+            r["tgm_firstbyte_p99"], r["tgm_ack_p50"], r["tgm_ack_p99"], "ok" if r["sustainable"] else "NOT SUSTAINABLE"))
+
+        if r["sustainable"]: max_rate = rate
+        else: break
+
+    print("Max sustainable setpoint rate at %d Baud: %d/s" % (baudrate, max_rate))
+
+    # Closing communication channel
+    result = indralib.close(indraref, ctypes.byref(indra_error))
+    check_result(result)
+
+    return max_rate
+
+
+# MAIN ENTRY POINT
+def main():
+    parser = argparse.ArgumentParser(description="Measures setpoint-to-acknowledge latency and the maximum sustainable setpoint rate of Speed Control per baud rate.")
+    parser.add_argument("--port", default="COM1", help="Communication port (default: COM1)")
+    parser.add_argument("--baudrates", type=int, nargs="+", default=[19200, 115200], help="Baud rates to be measured (default: 19200 115200)")
+    parser.add_argument("--rates", type=int, nargs="+", default=[5, 10, 20, 50, 100, 200, 500], help="Setpoint rates in [1/s], ascending (default: 5 ... 500)")
+    parser.add_argument("--duration", type=float, default=5.0, help="Duration per rate in [s] (default: 5)")
+    parser.add_argument("--speed", type=float, default=10.0, help="Setpoint speed in [rpm]; alternates between speed and speed+1 (default: 10)")
+    parser.add_argument("--mode", choices=["write", "channel"], default="write", help="write: speedcontrol_write(), channel: speedcontrol_channel_write()")
+    args = parser.parse_args()
+
+    input("Setpoints are written to the drive. Make sure the drive is NOT released (stand-by mode), or the motor is allowed to rotate!\n(Press any key to continue...)")
+
+    results = {}
+    for baudrate in args.baudrates:
+        results[baudrate] = run_baudrate(args, baudrate)
+
+    print("\nSummary:")
+    for baudrate in args.baudrates:
+        print("%7d Baud: %d setpoints/s" % (baudrate, results[baudrate]))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(int(main() or 0))
@@ -37,7 +37,9 @@ typedef struct GenericErrHandle {
 	/// @param	_msg 	(Optional) Error message. Parameter will not be used.
 	GenericErrHandle(uint32_t _code = 0, const char* _msg = "") :
 		code(_code)
-	{}
+	{
+		msg[0] = '\0';
+	}
 
 	/// Sets error code and error message.
 	///
@@ -47,8 +49,13 @@ typedef struct GenericErrHandle {
 	{
 		code = _code;
 
-		for (size_t i = 0; i < strlen(_msg); i++)
+		if (_msg == msg) return;
+
+		// Truncated to the buffer size, and always null-terminated
+		size_t i = 0;
+		for (; i < sizeof(msg) - 1 && _msg[i]; i++)
 			msg[i] = _msg[i];
+		msg[i] = '\0';
 	}
 
 	/// Sets an error message.
@@ -127,6 +134,10 @@ typedef enum EErrorBlocks
 	Err_Block_Close			= 2,
 	/// An enum constant representing the Error on test  
 	Err_Block_Test			= 3,				 
+	/// An enum constant representing the Error on drive event monitoring
+	Err_Block_Events		= 4,
+	/// An enum constant representing the Error on Sequence compile
+	Err_Block_SeqCompile	= 5,
 	/// An enum constant representing the Error on Sequence init  
 	Err_Block_SeqInit		= 6,				 
 	/// An enum constant representing the Error on Sequence write  
@@ -140,7 +151,13 @@ typedef enum EErrorBlocks
 	/// An enum constant representing the Error on set control  
 	Err_Block_SetControl	= 11,
 	/// An enum constant representing the Error of invalid API reference
-	Err_Invalid_Pointer		= 12
+	Err_Invalid_Pointer		= 12,
+	/// An enum constant representing the Error on asynchronous command execution
+	Err_Block_Command		= 13,
+	/// An enum constant representing the Error on batched parameter reads and writes, parameter backup and restore
+	Err_Block_Batch			= 14,
+	/// An enum constant representing the Error on oscilloscope recording
+	Err_Block_Scope			= 15
 } EErrorBlocks;
 
 #ifdef USE_LABVIEW_ENV
@@ -166,6 +183,19 @@ static MgErr write_string(ErrHandle lvhandle, std::string str)
 }
 #endif
 
+/// Gets the final error code of an error block and issue, without setting an error handle.
+///
+/// @param [in]	block_code	Error block code defined by EErrorBlocks enum.
+/// @param [in]	issue_code	(Optional) The issue code.
+///
+/// @return	The final error code, as returned by set_error().
+///
+/// @sa	set_error()
+inline static int32_t get_error_code(int32_t block_code, int32_t issue_code = 1)
+{
+	return (Err_Base << 8) | (block_code << 4) | issue_code;
+}
+
 /// Sets an error handle to the errhndl parameter.
 /// 
 /// This static function can be utilized to set an error message as well as a error code in the following scheme to
@@ -182,7 +212,7 @@ static MgErr write_string(ErrHandle lvhandle, std::string str)
 /// @sa	EErrorBlocks
 inline static int32_t set_error(ErrHandle errhndl, std::string errstr, int32_t block_code, int32_t issue_code = 1)
 {
-	int32_t retcode = (Err_Base << 8) | (block_code << 4) | issue_code;
+	int32_t retcode = get_error_code(block_code, issue_code);
 
 #ifdef USE_LABVIEW_ENV
 	write_string(errhndl, errstr);
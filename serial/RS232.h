@@ -441,7 +441,7 @@ public:
 	///
 	/// <returns>	The error. </returns>
 	///=================================================================================================
-	EError GetError (void);
+	virtual EError GetError (void);
 
 	///=================================================================================================
 	/// <summary>	Obtain the COMM and event handle. </summary>
@@ -475,7 +475,7 @@ public:
 	///
 	/// <returns>	A LONG. </returns>
 	///=================================================================================================
-	LONG Purge (void);
+	virtual LONG Purge (void);
 
 protected:
 	/// <summary>	Internal helper class which wraps DCB structure. </summary>
@@ -536,16 +536,19 @@ public:
 		warning(_warning)
 	{}
 
+	/// Gets the message. Formatted on the first call, and cached afterwards.
 	virtual const char* what() const throw ()
 	{
+		if (!m_what.empty()) return m_what.c_str();
+
 #ifdef NDEBUG
-		return str2char(sformat("CSerial exception caused %s: STATUS=%d, MESSAGE='%s'", Stack::GetTraceString().c_str(), m_status, m_message.c_str()));
+		m_what = sformat("CSerial exception caused %s: STATUS=%d, MESSAGE='%s'", Stack::GetTraceString().c_str(), m_status, m_message.c_str());
 #else
 		std::string foo = stde::GetWinErrorString(m_status);
-		const char* ex = str2char(sformat("CSerial exception caused: %s ### STATUS=0x%04x (%s) ### MESSAGE='%s'", Stack::GetTraceString().c_str(), m_status, foo.c_str(), m_message.c_str()));
-		OutputDebugStringA((LPCSTR)ex);
-		return ex;
+		m_what = sformat("CSerial exception caused: %s ### STATUS=0x%04x (%s) ### MESSAGE='%s'", Stack::GetTraceString().c_str(), m_status, foo.c_str(), m_message.c_str());
+		OutputDebugStringA((LPCSTR)m_what.c_str());
 #endif
+		return m_what.c_str();
 	}
 
 	int get_status() { return m_status; }
@@ -559,6 +562,10 @@ public:
 	int m_status;
 
 	std::string m_message;
+
+protected:
+	/// Formatted message. Empty until requested by what().
+	mutable std::string m_what;
 };
 
 
@@ -577,14 +584,16 @@ public:
 
 	virtual const char* what() const throw ()
 	{
+		if (!m_what.empty()) return m_what.c_str();
+
 #ifdef NDEBUG
-		return str2char(sformat("CSerial reception fail caused: STATUS=0x%04x ### MESSAGE='%s'", m_status, m_message.c_str()));
+		m_what = sformat("CSerial reception fail caused: STATUS=0x%04x ### MESSAGE='%s'", m_status, m_message.c_str());
 #else
 		std::string errstr = stde::GetWinErrorString(m_status);
-		const char* ex = str2char(sformat("CSerial reception fail caused: STATUS=0x%04x (%s) ### MESSAGE='%s'", m_status, errstr.c_str(), m_message.c_str()));
-		OutputDebugStringA((LPCSTR)ex);
-		return ex;
+		m_what = sformat("CSerial reception fail caused: STATUS=0x%04x (%s) ### MESSAGE='%s'", m_status, errstr.c_str(), m_message.c_str());
+		OutputDebugStringA((LPCSTR)m_what.c_str());
 #endif
+		return m_what.c_str();
 	}
 };
 
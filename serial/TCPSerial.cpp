@@ -0,0 +1,620 @@
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#include "TCPSerial.h"
+
+#include <vector>
+
+#pragma comment(lib, "ws2_32.lib")
+
+
+// Telnet commands and options (RFC 854, RFC 856, RFC 858)
+#define TELNET_SE				240
+#define TELNET_SB				250
+#define TELNET_WILL				251
+#define TELNET_WONT				252
+#define TELNET_DO				253
+#define TELNET_DONT				254
+#define TELNET_IAC				255
+#define TELNET_BINARY			0
+#define TELNET_SGA				3
+#define TELNET_COMPORT			44
+
+// Com Port Control commands of the client (RFC 2217)
+#define COMPORT_SET_BAUDRATE	1
+#define COMPORT_SET_DATASIZE	2
+#define COMPORT_SET_PARITY		3
+#define COMPORT_SET_STOPSIZE	4
+#define COMPORT_SET_CONTROL		5
+#define COMPORT_PURGE_DATA		12
+
+
+
+CTCPSerial::CTCPSerial() :
+	m_socket(INVALID_SOCKET),
+	m_winsock(false),
+	m_rfc2217(false),
+	m_telnet(Telnet_Data),
+	m_command(0)
+{
+	memset(m_local, 0, sizeof(m_local));
+	memset(m_remote, 0, sizeof(m_remote));
+}
+
+
+CTCPSerial::~CTCPSerial()
+{
+	// Closed here, since the destructor of CSerial would close the socket as a file
+	Close();
+}
+
+
+bool CTCPSerial::IsURL(const wchar_t * _port)
+{
+	if (!_port) return false;
+
+	return wcsncmp(_port, TCPSERIAL_SCHEME_RAW, wcslen(TCPSERIAL_SCHEME_RAW)) == 0 ||
+		wcsncmp(_port, TCPSERIAL_SCHEME_RFC2217, wcslen(TCPSERIAL_SCHEME_RFC2217)) == 0;
+}
+
+
+void CTCPSerial::Open(LPCTSTR lpszDevice, DWORD /*dwInQueue*/, DWORD /*dwOutQueue*/, bool /*fOverlapped*/)
+{
+	STACK;
+
+	// URLs consist of ASCII characters
+	std::wstring url;
+	for (LPCTSTR c = lpszDevice; c && *c; c++)
+		url += static_cast<wchar_t>(*c);
+
+	Connect(url.c_str());
+}
+
+
+void CTCPSerial::Connect(const wchar_t * _url)
+{
+	STACK;
+
+	// Check if the port isn't already opened
+	if (m_hFile)
+	{
+		m_lLastError = ERROR_ALREADY_INITIALIZED;
+		throw ExceptionGeneric(m_lLastError, "Port already opened");
+	}
+
+	if (!IsURL(_url))
+	{
+		m_lLastError = ERROR_INVALID_PARAMETER;
+		throw ExceptionGeneric(m_lLastError, "URL of the gateway is invalid. Use tcp://host:port, or rfc2217://host:port.");
+	}
+
+	m_rfc2217 = wcsncmp(_url, TCPSERIAL_SCHEME_RFC2217, wcslen(TCPSERIAL_SCHEME_RFC2217)) == 0;
+
+	// Host and TCP port
+	std::wstring address(_url + wcslen(m_rfc2217 ? TCPSERIAL_SCHEME_RFC2217 : TCPSERIAL_SCHEME_RAW));
+	size_t colon = address.rfind(L':');
+	if (colon == std::wstring::npos || colon == 0 || colon + 1 == address.size())
+	{
+		m_lLastError = ERROR_INVALID_PARAMETER;
+		throw ExceptionGeneric(m_lLastError, "URL of the gateway lacks host or port. Use tcp://host:port, or rfc2217://host:port.");
+	}
+
+	std::string host, service;
+	for (size_t i = 0; i < colon; i++) host += static_cast<char>(address[i]);
+	for (size_t i = colon + 1; i < address.size(); i++) service += static_cast<char>(address[i]);
+
+	WSADATA wsadata;
+	int result = WSAStartup(MAKEWORD(2, 2), &wsadata);
+	if (result)
+	{
+		m_lLastError = result;
+		throw ExceptionGeneric(m_lLastError, "Winsock could not be initialized");
+	}
+	m_winsock = true;
+
+	addrinfo hints;
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_protocol = IPPROTO_TCP;
+
+	addrinfo * addresses = NULL;
+	result = getaddrinfo(host.c_str(), service.c_str(), &hints, &addresses);
+	if (result)
+	{
+		Close();
+		m_lLastError = result;
+		throw ExceptionGeneric(m_lLastError, sformat("Gateway '%s' could not be resolved", host.c_str()));
+	}
+
+	SOCKET sock = INVALID_SOCKET;
+	for (addrinfo * ai = addresses; ai && sock == INVALID_SOCKET; ai = ai->ai_next)
+	{
+		sock = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+		if (sock == INVALID_SOCKET) continue;
+
+		// Connected without blocking, so that unreachable gateways fail within the timeout
+		u_long nonblocking = 1;
+		ioctlsocket(sock, FIONBIO, &nonblocking);
+
+		bool connected = (connect(sock, ai->ai_addr, static_cast<int>(ai->ai_addrlen)) == 0);
+		if (!connected && WSAGetLastError() == WSAEWOULDBLOCK)
+		{
+			fd_set writable;
+			FD_ZERO(&writable);
+			FD_SET(sock, &writable);
+
+			timeval timeout = { TCPSERIAL_CONNECT_TIMEOUT / 1000, (TCPSERIAL_CONNECT_TIMEOUT % 1000) * 1000 };
+			connected = (select(0, NULL, &writable, NULL, &timeout) == 1);
+		}
+
+		if (!connected)
+		{
+			closesocket(sock);
+			sock = INVALID_SOCKET;
+			continue;
+		}
+
+		nonblocking = 0;
+		ioctlsocket(sock, FIONBIO, &nonblocking);
+	}
+
+	freeaddrinfo(addresses);
+
+	if (sock == INVALID_SOCKET)
+	{
+		Close();
+		m_lLastError = WSAETIMEDOUT;
+		throw ExceptionGeneric(m_lLastError, sformat("Gateway '%s:%s' is not reachable", host.c_str(), service.c_str()));
+	}
+
+	// Telegrams are written as a whole, and must not wait for the acknowledge of the previous segment
+	BOOL nodelay = TRUE;
+	setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&nodelay), sizeof(nodelay));
+
+	// Dead connections are detected even while idle
+	BOOL keepalive = TRUE;
+	setsockopt(sock, SOL_SOCKET, SO_KEEPALIVE, reinterpret_cast<const char*>(&keepalive), sizeof(keepalive));
+
+	m_socket = sock;
+	// Port is reported as opened by CSerial::IsOpen()
+	m_hFile = reinterpret_cast<HANDLE>(sock);
+
+	m_telnet = Telnet_Data;
+	memset(m_local, 0, sizeof(m_local));
+	memset(m_remote, 0, sizeof(m_remote));
+
+	// Binary transmission in both directions, and Com Port Control by the client
+	if (m_rfc2217)
+	{
+		negotiate(TELNET_WILL, TELNET_BINARY);
+		negotiate(TELNET_DO, TELNET_BINARY);
+		negotiate(TELNET_WILL, TELNET_COMPORT);
+	}
+
+	m_lLastError = ERROR_SUCCESS;
+}
+
+
+LONG CTCPSerial::Close(void)
+{
+	STACK;
+
+	if (m_socket != INVALID_SOCKET)
+	{
+		shutdown(m_socket, SD_BOTH);
+		closesocket(m_socket);
+		m_socket = INVALID_SOCKET;
+	}
+
+	if (m_winsock)
+	{
+		WSACleanup();
+		m_winsock = false;
+	}
+
+	m_hFile = 0;
+
+	m_lLastError = ERROR_SUCCESS;
+	return m_lLastError;
+}
+
+
+LONG CTCPSerial::Setup(EBaudrate eBaudrate, EDataBits eDataBits, EParity eParity, EStopBits eStopBits)
+{
+	STACK;
+
+	// Check if the device is open
+	if (m_socket == INVALID_SOCKET)
+	{
+		m_lLastError = ERROR_INVALID_HANDLE;
+		throw ExceptionGeneric(m_lLastError, "Device is not opened");
+	}
+
+	// Line settings of raw gateways are fixed by their configuration
+	if (m_rfc2217)
+	{
+		const DWORD baudrate = static_cast<DWORD>(eBaudrate);
+		const BYTE baud[4] = { static_cast<BYTE>(baudrate >> 24), static_cast<BYTE>(baudrate >> 16), static_cast<BYTE>(baudrate >> 8), static_cast<BYTE>(baudrate) };
+		send_control(COMPORT_SET_BAUDRATE, baud, sizeof(baud));
+
+		const BYTE datasize = static_cast<BYTE>(eDataBits);
+		send_control(COMPORT_SET_DATASIZE, &datasize, 1);
+
+		// NONE=1, ODD=2, EVEN=3, MARK=4, SPACE=5
+		const BYTE parity = static_cast<BYTE>(eParity + 1);
+		send_control(COMPORT_SET_PARITY, &parity, 1);
+
+		// 1=1, 2=2, 3=1.5 stop bits
+		const BYTE stopsize = (eStopBits == EStop1_5) ? 3 : (eStopBits == EStop2) ? 2 : 1;
+		send_control(COMPORT_SET_STOPSIZE, &stopsize, 1);
+	}
+
+	m_lLastError = ERROR_SUCCESS;
+	return m_lLastError;
+}
+
+
+LONG CTCPSerial::SetMask(DWORD dwMask)
+{
+	// Only EEventRecv is emulated
+	m_dwEventMask = dwMask;
+
+	m_lLastError = ERROR_SUCCESS;
+	return m_lLastError;
+}
+
+
+LONG CTCPSerial::SetupHandshaking(EHandshake eHandshake)
+{
+	STACK;
+
+	// Check if the device is open
+	if (m_socket == INVALID_SOCKET)
+	{
+		m_lLastError = ERROR_INVALID_HANDLE;
+		throw ExceptionGeneric(m_lLastError, "Device is not opened");
+	}
+
+	if (m_rfc2217)
+	{
+		// No flow control=1, XON/XOFF=2, RTS/CTS=3
+		const BYTE control = (eHandshake == EHandshakeHardware) ? 3 : (eHandshake == EHandshakeSoftware) ? 2 : 1;
+		send_control(COMPORT_SET_CONTROL, &control, 1);
+	}
+
+	m_lLastError = ERROR_SUCCESS;
+	return m_lLastError;
+}
+
+
+LONG CTCPSerial::SetupReadTimeouts(EReadTimeout /*eReadTimeout*/)
+{
+	// Read() never blocks. Use WaitEvent() to wait for bytes.
+	m_lLastError = ERROR_SUCCESS;
+	return m_lLastError;
+}
+
+
+LONG CTCPSerial::WaitEvent(LPOVERLAPPED lpOverlapped, DWORD dwTimeout)
+{
+	STACK;
+
+	// Check if the device is open
+	if (m_socket == INVALID_SOCKET)
+	{
+		m_lLastError = ERROR_INVALID_HANDLE;
+		throw ExceptionGeneric(m_lLastError, "Device is not opened");
+	}
+
+	if (lpOverlapped)
+	{
+		m_lLastError = ERROR_NOT_SUPPORTED;
+		throw ExceptionGeneric(m_lLastError, "Overlapped operations are not supported by gateways");
+	}
+
+	m_eEvent = EEventNone;
+
+	if (!is_readable(dwTimeout))
+	{
+		m_lLastError = ERROR_TIMEOUT;
+		return m_lLastError;
+	}
+
+	m_eEvent = EEventRecv;
+
+	m_lLastError = ERROR_SUCCESS;
+	return m_lLastError;
+}
+
+
+LONG CTCPSerial::Write(const void* pData, size_t iLen, DWORD* pdwWritten, LPOVERLAPPED lpOverlapped, DWORD /*dwTimeout*/)
+{
+	STACK;
+
+	if (pdwWritten) *pdwWritten = 0;
+
+	// Check if the device is open
+	if (m_socket == INVALID_SOCKET)
+	{
+		m_lLastError = ERROR_INVALID_HANDLE;
+		throw ExceptionGeneric(m_lLastError, "Device is not opened");
+	}
+
+	if (lpOverlapped)
+	{
+		m_lLastError = ERROR_NOT_SUPPORTED;
+		throw ExceptionGeneric(m_lLastError, "Overlapped operations are not supported by gateways");
+	}
+
+	const BYTE * data = static_cast<const BYTE*>(pData);
+
+	if (!m_rfc2217)
+		send_raw(data, iLen);
+	else
+	{
+		// Data bytes 0xFF are doubled, so that they are not taken as Telnet commands
+		std::vector<BYTE> escaped;
+		escaped.reserve(2 * iLen);
+
+		for (size_t i = 0; i < iLen; i++)
+		{
+			escaped.push_back(data[i]);
+			if (data[i] == TELNET_IAC) escaped.push_back(TELNET_IAC);
+		}
+
+		send_raw(escaped.data(), escaped.size());
+	}
+
+	if (pdwWritten) *pdwWritten = static_cast<DWORD>(iLen);
+
+	m_lLastError = ERROR_SUCCESS;
+	return m_lLastError;
+}
+
+
+LONG CTCPSerial::Read(void* pData, size_t iLen, DWORD* pdwRead, LPOVERLAPPED lpOverlapped, DWORD /*dwTimeout*/)
+{
+	STACK;
+
+	if (pdwRead) *pdwRead = 0;
+
+	// Check if the device is open
+	if (m_socket == INVALID_SOCKET)
+	{
+		m_lLastError = ERROR_INVALID_HANDLE;
+		throw ExceptionGeneric(m_lLastError, "Device is not opened");
+	}
+
+	if (lpOverlapped)
+	{
+		m_lLastError = ERROR_NOT_SUPPORTED;
+		throw ExceptionGeneric(m_lLastError, "Overlapped operations are not supported by gateways");
+	}
+
+	m_lLastError = ERROR_SUCCESS;
+
+	// Only bytes that have been received already are read
+	if (!is_readable(0)) return m_lLastError;
+
+	int received = recv(m_socket, static_cast<char*>(pData), static_cast<int>(iLen), 0);
+
+	if (received == 0)
+	{
+		m_lLastError = WSAECONNRESET;
+		throw ExceptionGeneric(m_lLastError, "Connection has been closed by the gateway");
+	}
+
+	if (received == SOCKET_ERROR)
+	{
+		m_lLastError = WSAGetLastError();
+		throw ExceptionGeneric(m_lLastError, "Unable to read from the gateway");
+	}
+
+	size_t len = m_rfc2217 ? decode(static_cast<BYTE*>(pData), received) : static_cast<size_t>(received);
+
+	if (pdwRead) *pdwRead = static_cast<DWORD>(len);
+
+	return m_lLastError;
+}
+
+
+LONG CTCPSerial::Purge(void)
+{
+	STACK;
+
+	// Check if the device is open
+	if (m_socket == INVALID_SOCKET)
+	{
+		m_lLastError = ERROR_INVALID_HANDLE;
+		throw ExceptionGeneric(m_lLastError, "Device is not opened");
+	}
+
+	// Buffers of the gateway: Receive and transmit
+	if (m_rfc2217)
+	{
+		const BYTE both = 3;
+		send_control(COMPORT_PURGE_DATA, &both, 1);
+	}
+
+	// Bytes received so far. Telnet commands among them are processed.
+	BYTE buffer[256];
+	while (is_readable(0))
+	{
+		int received = recv(m_socket, reinterpret_cast<char*>(buffer), sizeof(buffer), 0);
+		if (received <= 0) break;
+
+		if (m_rfc2217) decode(buffer, received);
+	}
+
+	m_lLastError = ERROR_SUCCESS;
+	return m_lLastError;
+}
+
+
+CSerial::EError CTCPSerial::GetError(void)
+{
+	// Line errors are not reported by gateways
+	m_lLastError = ERROR_SUCCESS;
+	return EErrorUnknown;
+}
+
+
+size_t CTCPSerial::decode(BYTE * _data, const size_t _len)
+{
+	// Data bytes are compacted in place
+	size_t len = 0;
+
+	for (size_t i = 0; i < _len; i++)
+	{
+		const BYTE b = _data[i];
+
+		switch (m_telnet)
+		{
+		case Telnet_Data:
+			if (b == TELNET_IAC) m_telnet = Telnet_IAC;
+			else _data[len++] = b;
+			break;
+
+		case Telnet_IAC:
+			if (b == TELNET_IAC)
+			{
+				_data[len++] = b;
+				m_telnet = Telnet_Data;
+			}
+			else if (b == TELNET_SB)
+				m_telnet = Telnet_Sub;
+			else if (b >= TELNET_WILL && b <= TELNET_DONT)
+			{
+				m_command = b;
+				m_telnet = Telnet_Option;
+			}
+			else
+				// NOP, GA, ...
+				m_telnet = Telnet_Data;
+			break;
+
+		case Telnet_Option:
+			respond(m_command, b);
+			m_telnet = Telnet_Data;
+			break;
+
+		case Telnet_Sub:
+			// Acknowledges and notifications of the gateway (e.g. line state) are not evaluated
+			if (b == TELNET_IAC) m_telnet = Telnet_SubIAC;
+			break;
+
+		case Telnet_SubIAC:
+			m_telnet = (b == TELNET_SE) ? Telnet_Data : Telnet_Sub;
+			break;
+		}
+	}
+
+	return len;
+}
+
+
+void CTCPSerial::respond(const BYTE _command, const BYTE _option)
+{
+	// Requests are answered only if they change the state of the option, so that negotiations do not loop
+	switch (_command)
+	{
+	case TELNET_DO:
+		if (_option == TELNET_BINARY || _option == TELNET_SGA || _option == TELNET_COMPORT)
+		{
+			if (!m_local[_option]) negotiate(TELNET_WILL, _option);
+		}
+		else
+			negotiate(TELNET_WONT, _option);
+		break;
+
+	case TELNET_DONT:
+		if (m_local[_option]) negotiate(TELNET_WONT, _option);
+		break;
+
+	case TELNET_WILL:
+		if (_option == TELNET_BINARY || _option == TELNET_SGA)
+		{
+			if (!m_remote[_option]) negotiate(TELNET_DO, _option);
+		}
+		else
+			negotiate(TELNET_DONT, _option);
+		break;
+
+	case TELNET_WONT:
+		if (m_remote[_option]) negotiate(TELNET_DONT, _option);
+		break;
+	}
+}
+
+
+void CTCPSerial::negotiate(const BYTE _command, const BYTE _option)
+{
+	switch (_command)
+	{
+	case TELNET_WILL:	m_local[_option] = true; break;
+	case TELNET_WONT:	m_local[_option] = false; break;
+	case TELNET_DO:		m_remote[_option] = true; break;
+	case TELNET_DONT:	m_remote[_option] = false; break;
+	}
+
+	const BYTE command[3] = { TELNET_IAC, _command, _option };
+	send_raw(command, sizeof(command));
+}
+
+
+void CTCPSerial::send_control(const BYTE _command, const BYTE _value[], const size_t _len)
+{
+	std::vector<BYTE> command = { TELNET_IAC, TELNET_SB, TELNET_COMPORT, _command };
+
+	for (size_t i = 0; i < _len; i++)
+	{
+		command.push_back(_value[i]);
+		if (_value[i] == TELNET_IAC) command.push_back(TELNET_IAC);
+	}
+
+	command.push_back(TELNET_IAC);
+	command.push_back(TELNET_SE);
+
+	send_raw(command.data(), command.size());
+}
+
+
+void CTCPSerial::send_raw(const BYTE * _data, const size_t _len)
+{
+	size_t sent = 0;
+
+	// Handed to the socket as a whole. Blocking sockets return after all bytes have been buffered.
+	while (sent < _len)
+	{
+		int result = send(m_socket, reinterpret_cast<const char*>(_data + sent), static_cast<int>(_len - sent), 0);
+
+		if (result == SOCKET_ERROR)
+		{
+			m_lLastError = WSAGetLastError();
+			throw ExceptionGeneric(m_lLastError, "Unable to write to the gateway");
+		}
+
+		sent += result;
+	}
+}
+
+
+bool CTCPSerial::is_readable(const DWORD _timeout)
+{
+	fd_set readable;
+	FD_ZERO(&readable);
+	FD_SET(m_socket, &readable);
+
+	timeval timeout = { static_cast<long>(_timeout / 1000), static_cast<long>((_timeout % 1000) * 1000) };
+
+	int result = select(0, &readable, NULL, NULL, (_timeout == INFINITE) ? NULL : &timeout);
+
+	if (result == SOCKET_ERROR)
+	{
+		m_lLastError = WSAGetLastError();
+		throw ExceptionGeneric(m_lLastError, "Unable to wait for the gateway");
+	}
+
+	return result > 0;
+}
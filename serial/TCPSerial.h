@@ -0,0 +1,110 @@
+/// @file
+/// Contains the transport that reaches a serial port of a serial-to-Ethernet gateway over TCP.
+
+#ifndef _TCPSERIAL_H_
+#define _TCPSERIAL_H_
+
+#include <Windows.h>
+#include <string>
+
+#include "RS232.h"
+
+
+/// URL scheme of a raw TCP gateway. The line settings are fixed by the configuration of the gateway.
+#define TCPSERIAL_SCHEME_RAW		L"tcp://"
+/// URL scheme of a gateway with RFC 2217 (Telnet Com Port Control). The line settings are set by the client.
+#define TCPSERIAL_SCHEME_RFC2217	L"rfc2217://"
+/// Timeout in [ms] to establish the connection.
+#define TCPSERIAL_CONNECT_TIMEOUT	3000
+
+
+/// Transport to a serial port of a serial-to-Ethernet gateway (device server), behind the interface of CSerial.
+///
+/// The gateway is addressed by a URL instead of a COM port: "tcp://host:port" for a raw TCP socket, or
+/// "rfc2217://host:port" for Telnet Com Port Control, which sets baud rate, data bits, parity and stop bits on the
+/// gateway. Nagle's algorithm is disabled, and each Write() is handed to the socket as a whole, so that a telegram
+/// leaves the host in a single segment.
+///
+/// Events are emulated: WaitEvent() reports CSerial::EEventRecv once bytes are readable. Line errors and breaks are
+/// not reported by gateways. A closed connection throws CSerial::ExceptionGeneric on Read(), like an unplugged
+/// adapter.
+///
+/// @code{.cpp}
+/// CTCPSerial gateway;
+/// gateway.Connect(L"rfc2217://192.168.0.10:4001");
+/// gateway.Setup(CSerial::EBaud115200);
+/// @endcode
+class CTCPSerial : public CSerial
+{
+public:
+	/// Constructor.
+	CTCPSerial();
+	/// Destructor. Closes the connection.
+	virtual ~CTCPSerial();
+
+	/// Checks if a port name is the URL of a gateway.
+	///
+	/// @param	_port	Port name, e.g. "COM1" or "tcp://192.168.0.10:4001".
+	///
+	/// @return	True if the URL of a gateway, false otherwise.
+	static bool IsURL(const wchar_t * _port);
+
+	/// Connects to the gateway.
+	///
+	/// @param	_url	URL of the gateway: "tcp://host:port", or "rfc2217://host:port".
+	void Connect(const wchar_t * _url);
+
+	/// Checks if the line settings are set by the client (RFC 2217).
+	///
+	/// @return	True if Setup() sets the line of the gateway, false if the line settings are fixed.
+	bool HasLineControl() const { return m_rfc2217; }
+
+	virtual void Open(LPCTSTR lpszDevice = _T("tcp://localhost:4001"), DWORD dwInQueue = 0, DWORD dwOutQueue = 0, bool fOverlapped = SERIAL_DEFAULT_OVERLAPPED);
+	virtual LONG Close(void);
+
+	virtual LONG Setup(EBaudrate eBaudrate = EBaud9600, EDataBits eDataBits = EData8, EParity eParity = EParNone, EStopBits eStopBits = EStop1);
+	virtual LONG SetMask(DWORD dwMask = EEventBreak | EEventError | EEventRecv);
+	virtual LONG SetupHandshaking(EHandshake eHandshake);
+	virtual LONG SetupReadTimeouts(EReadTimeout eReadTimeout);
+
+	virtual LONG WaitEvent(LPOVERLAPPED lpOverlapped = 0, DWORD dwTimeout = INFINITE);
+
+	using CSerial::Write;
+	virtual LONG Write(const void* pData, size_t iLen, DWORD* pdwWritten = 0, LPOVERLAPPED lpOverlapped = 0, DWORD dwTimeout = INFINITE);
+	virtual LONG Read(void* pData, size_t iLen, DWORD* pdwRead = 0, LPOVERLAPPED lpOverlapped = 0, DWORD dwTimeout = INFINITE);
+
+	virtual LONG Purge(void);
+	virtual EError GetError(void);
+
+private:
+	/// Values that represent the states of the Telnet decoder (RFC 854).
+	typedef enum TelnetState
+	{
+		Telnet_Data,
+		Telnet_IAC,
+		Telnet_Option,
+		Telnet_Sub,
+		Telnet_SubIAC
+	} TelnetState;
+
+	size_t decode(BYTE * _data, const size_t _len);
+	void respond(const BYTE _command, const BYTE _option);
+	void negotiate(const BYTE _command, const BYTE _option);
+	void send_control(const BYTE _command, const BYTE _value[], const size_t _len);
+	void send_raw(const BYTE * _data, const size_t _len);
+	bool is_readable(const DWORD _timeout);
+
+private:
+	/// Connected socket (SOCKET), or INVALID_SOCKET.
+	UINT_PTR m_socket;
+	bool m_winsock;
+	bool m_rfc2217;
+
+	TelnetState m_telnet;
+	BYTE m_command;
+	/// Telnet options enabled on the client side (WILL), and on the gateway side (DO).
+	bool m_local[256];
+	bool m_remote[256];
+};
+
+#endif /* _TCPSERIAL_H_ */
@@ -0,0 +1,394 @@
+#include "SISBackup.h"
+
+#include <algorithm>
+#include <map>
+
+
+
+SISBackup::SISBackup()
+{
+}
+
+
+SISBackup::~SISBackup()
+{
+}
+
+
+void SISBackup::read(SISProtocol * _sis, const USHORT _idnlist)
+{
+	STACK;
+
+	// IDN list: 4 bytes per IDN. Bits 15...0 hold the parameter ident, bits 31...16 the structure element.
+	std::vector<BYTE> idns;
+	_sis->read_list(TGM::SercosParamS, _idnlist, idns);
+
+	std::vector<Entry> entries;
+	for (size_t i = 0; i + 4 <= idns.size(); i += 4)
+	{
+		UINT32 idn = 0;
+		memcpy(&idn, &idns[i], 4);
+
+		TGM::Bitfields::SercosParamIdent ident;
+		ident.Value = static_cast<USHORT>(idn);
+		if ((idn >> 16) || ident.Bits.ParamSet) continue;
+
+		Entry entry;
+		entry.ParamVar = ident.Bits.ParamVariant ? TGM::SercosParamP : TGM::SercosParamS;
+		entry.ParamNum = ident.Bits.ParamNumber;
+		entry.Attribute = 0;
+		entry.Error = 0;
+		entry.ListMax = 0;
+		entries.push_back(entry);
+	}
+
+	read_entries(_sis, entries);
+}
+
+
+void SISBackup::read(SISProtocol * _sis, const std::vector<Entry>& _params)
+{
+	STACK;
+
+	std::vector<Entry> entries;
+	for (size_t i = 0; i < _params.size(); i++)
+	{
+		Entry entry;
+		entry.ParamVar = _params[i].ParamVar;
+		entry.ParamNum = _params[i].ParamNum;
+		entry.Attribute = 0;
+		entry.Error = 0;
+		entry.ListMax = 0;
+		entries.push_back(entry);
+	}
+
+	read_entries(_sis, entries);
+}
+
+
+void SISBackup::read_entries(SISProtocol * _sis, std::vector<Entry>& _entries)
+{
+	STACK;
+
+	// Preempted by other exchanges at each telegram
+	SISPriorityScope priority(SISPriority_Bulk);
+
+	m_entries.clear();
+
+	// Attributes of all parameters
+	std::vector<SISProtocol::SercosRequest> attributes;
+	attributes.reserve(_entries.size());
+	for (size_t i = 0; i < _entries.size(); i++)
+		attributes.push_back(SISProtocol::SercosRequest(SISProtocol::SIS_SERVICE_SERCOS_PARAM_READ, _entries[i].ParamVar, _entries[i].ParamNum, TGM::Datablock_Attribute, TGM::Data(), 4));
+
+	_sis->transceive_sequential(attributes);
+
+	// Single values with their actual length, and list headers. Procedure commands have no operation data.
+	std::vector<SISProtocol::SercosRequest> reads;
+	for (size_t i = 0; i < _entries.size(); i++)
+	{
+		Entry& entry = _entries[i];
+
+		entry.Error = attributes[i].Error;
+		if (!entry.Error) entry.Attribute = attributes[i].Data.toUINT32();
+		if (!entry.Error && TGM::Bitfields::SercosParamAttribute(entry.Attribute).Bits.DataFunction) continue;
+
+		m_entries.push_back(entry);
+		if (entry.Error) continue;
+
+		if (entry.is_list())
+			reads.push_back(SISProtocol::SercosRequest(SISProtocol::SIS_SERVICE_SERCOS_LIST_READ, entry.ParamVar, entry.ParamNum, TGM::Datablock_OperationData, TGM::Data(), 4, 0, 4));
+		else
+			reads.push_back(SISProtocol::SercosRequest(SISProtocol::SIS_SERVICE_SERCOS_PARAM_READ, entry.ParamVar, entry.ParamNum, TGM::Datablock_OperationData, TGM::Data(), static_cast<USHORT>(SISScaling(entry.Attribute).get_datalen())));
+	}
+
+	_sis->transceive_sequential(reads);
+
+	// List segments of all lists, one segment per telegram
+	std::vector<SISProtocol::SercosRequest> segments;
+	std::vector<size_t> owners;
+	for (size_t i = 0, k = 0; i < m_entries.size(); i++)
+	{
+		Entry& entry = m_entries[i];
+		if (entry.Error) continue;
+
+		SISProtocol::SercosRequest& request = reads[k++];
+
+		entry.Error = request.Error;
+		if (entry.Error) continue;
+
+		if (!entry.is_list())
+		{
+			size_t datalen = std::min<size_t>(SISScaling(entry.Attribute).get_datalen(), request.Data.Size);
+			entry.Data.assign(request.Data.Bytes, request.Data.Bytes + datalen);
+			continue;
+		}
+
+		// List header: Actual length (bits 15...0) and maximum length (bits 31...16) in bytes. List offsets are 16 bits
+		// wide, and include the header.
+		size_t len = std::min<size_t>(request.Data.toUINT32() & 0xFFFF, 0xFFFF - 4);
+		entry.ListMax = static_cast<USHORT>(request.Data.toUINT32() >> 16);
+		entry.Data.assign(len, 0);
+
+		for (size_t offset = 0; offset < len; offset += SIS_LIST_SEGMENT_SIZE)
+		{
+			USHORT size = static_cast<USHORT>(std::min<size_t>(SIS_LIST_SEGMENT_SIZE, len - offset));
+			segments.push_back(SISProtocol::SercosRequest(SISProtocol::SIS_SERVICE_SERCOS_LIST_READ, entry.ParamVar, entry.ParamNum, TGM::Datablock_OperationData, TGM::Data(), size, static_cast<USHORT>(4 + offset), size));
+			owners.push_back(i);
+		}
+	}
+
+	_sis->transceive_sequential(segments);
+
+	for (size_t k = 0; k < segments.size(); k++)
+	{
+		Entry& entry = m_entries[owners[k]];
+		if (entry.Error) continue;
+
+		if (segments[k].Error)
+		{
+			entry.Error = segments[k].Error;
+			entry.Data.clear();
+			continue;
+		}
+
+		memcpy(&entry.Data[segments[k].ListOffset - 4], segments[k].Data.Bytes, std::min<size_t>(segments[k].SegmentSize, segments[k].Data.Size));
+	}
+}
+
+
+void SISBackup::save(const wchar_t * _path) const
+{
+	STACK;
+
+	if (m_entries.size() > 0xFFFF)
+		throw SISProtocol::ExceptionGeneric(-1, sformat("Backup holds %u parameters, but an image holds 65535 parameters at most.", m_entries.size()));
+
+	SISBackupHeader header;
+	header.Magic = SISBACKUP_MAGIC;
+	header.Version = SISBACKUP_VERSION;
+	header.Count = static_cast<uint16_t>(m_entries.size());
+
+	std::vector<BYTE> image(reinterpret_cast<const BYTE*>(&header), reinterpret_cast<const BYTE*>(&header) + sizeof(header));
+
+	// Index, followed by the data of all parameters
+	uint32_t offset = 0;
+	for (size_t i = 0; i < m_entries.size(); i++)
+	{
+		const Entry& entry = m_entries[i];
+
+		SISBackupIndex index;
+		index.Ident = TGM::Bitfields::SercosParamIdent(entry.ParamVar, entry.ParamNum).Value;
+		index.Attribute = entry.Attribute;
+		index.Error = entry.Error;
+		index.Offset = offset;
+		index.Length = static_cast<uint16_t>(entry.Data.size());
+
+		image.insert(image.end(), reinterpret_cast<const BYTE*>(&index), reinterpret_cast<const BYTE*>(&index) + sizeof(index));
+		offset += index.Length;
+	}
+
+	for (size_t i = 0; i < m_entries.size(); i++)
+		image.insert(image.end(), m_entries[i].Data.begin(), m_entries[i].Data.end());
+
+	HANDLE file = CreateFileW(_path, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		throw SISProtocol::ExceptionGeneric(GetLastError(), "Backup image cannot be created.");
+
+	DWORD written = 0;
+	BOOL success = WriteFile(file, image.data(), static_cast<DWORD>(image.size()), &written, NULL);
+	DWORD error = GetLastError();
+	CloseHandle(file);
+
+	if (!success || written != image.size())
+		throw SISProtocol::ExceptionGeneric(error, "Backup image cannot be written.");
+}
+
+
+void SISBackup::load(const wchar_t * _path)
+{
+	STACK;
+
+	m_entries.clear();
+
+	HANDLE file = CreateFileW(_path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		throw SISProtocol::ExceptionGeneric(GetLastError(), "Backup image cannot be opened.");
+
+	LARGE_INTEGER size;
+	std::vector<BYTE> image;
+	DWORD read = 0;
+	BOOL success = GetFileSizeEx(file, &size) && size.QuadPart <= MAXDWORD;
+	if (success)
+	{
+		image.resize(static_cast<size_t>(size.QuadPart));
+		success = ReadFile(file, image.data(), static_cast<DWORD>(image.size()), &read, NULL) && read == image.size();
+	}
+	DWORD error = GetLastError();
+	CloseHandle(file);
+
+	if (!success)
+		throw SISProtocol::ExceptionGeneric(error, "Backup image cannot be read.");
+
+	SISBackupHeader header;
+	if (image.size() < sizeof(header))
+		throw SISProtocol::ExceptionGeneric(-1, "Backup image is truncated.");
+
+	memcpy(&header, image.data(), sizeof(header));
+	if (header.Magic != SISBACKUP_MAGIC || header.Version != SISBACKUP_VERSION)
+		throw SISProtocol::ExceptionGeneric(-1, sformat("Backup image has an unknown format (version %u).", header.Version));
+
+	size_t data = sizeof(header) + header.Count * sizeof(SISBackupIndex);
+	if (image.size() < data)
+		throw SISProtocol::ExceptionGeneric(-1, "Backup image is truncated.");
+
+	for (uint16_t i = 0; i < header.Count; i++)
+	{
+		SISBackupIndex index;
+		memcpy(&index, &image[sizeof(header) + i * sizeof(SISBackupIndex)], sizeof(index));
+
+		if (data + index.Offset + index.Length > image.size())
+			throw SISProtocol::ExceptionGeneric(-1, "Backup image is truncated.");
+
+		TGM::Bitfields::SercosParamIdent ident;
+		ident.Value = index.Ident;
+
+		Entry entry;
+		entry.ParamVar = ident.Bits.ParamVariant ? TGM::SercosParamP : TGM::SercosParamS;
+		entry.ParamNum = ident.Bits.ParamNumber;
+		entry.Attribute = index.Attribute;
+		entry.Error = index.Error;
+		entry.Data.assign(image.begin() + data + index.Offset, image.begin() + data + index.Offset + index.Length);
+		entry.ListMax = 0;
+		m_entries.push_back(entry);
+	}
+}
+
+
+void SISBackup::restore(SISProtocol * _sis, SISRestoreStats& _stats) const
+{
+	STACK;
+
+	// Preempted by other exchanges at each telegram
+	SISPriorityScope priority(SISPriority_Bulk);
+
+	_stats.Count = static_cast<uint16_t>(m_entries.size());
+	_stats.Written = 0;
+	_stats.Failed = 0;
+
+	// Current values of all parameters
+	SISBackup current;
+	current.read(_sis, m_entries);
+
+	std::map<UINT32, const Entry*> actuals;
+	for (size_t i = 0; i < current.m_entries.size(); i++)
+		actuals[current.m_entries[i].get_param_key()] = &current.m_entries[i];
+
+	// Parameters that differ. Parameters that have not been read for the backup are not restored.
+	std::string failed;
+	std::vector<const Entry*> diffs;
+	for (size_t i = 0; i < m_entries.size(); i++)
+	{
+		const Entry& entry = m_entries[i];
+		if (entry.Error) continue;
+
+		std::map<UINT32, const Entry*>::const_iterator it = actuals.find(entry.get_param_key());
+		if (it == actuals.end()) continue;
+
+		const Entry& actual = *it->second;
+		if (actual.Error)
+			failed.append(sformat("%c-0-%04u: Not readable (0x%04X). ", entry.ParamVar == TGM::SercosParamS ? 'S' : 'P', entry.ParamNum, actual.Error));
+		else if (actual.Data == entry.Data)
+			continue;
+		else if (entry.is_list() && entry.Data.size() > actual.ListMax)
+			failed.append(sformat("%c-0-%04u: List exceeds %u bytes. ", entry.ParamVar == TGM::SercosParamS ? 'S' : 'P', entry.ParamNum, actual.ListMax));
+		else
+		{
+			diffs.push_back(&entry);
+			continue;
+		}
+
+		_stats.Failed++;
+	}
+
+	if (!diffs.empty())
+	{
+		// Single values, and lists: Header with the new actual length first, followed by the segments
+		std::vector<SISProtocol::SercosRequest> writes;
+		std::vector<size_t> owners;
+		for (size_t i = 0; i < diffs.size(); i++)
+		{
+			const Entry& entry = *diffs[i];
+
+			if (!entry.is_list())
+			{
+				writes.push_back(SISProtocol::SercosRequest(SISProtocol::SIS_SERVICE_SERCOS_PARAM_WRITE, entry.ParamVar, entry.ParamNum, TGM::Datablock_OperationData, TGM::Data(entry.Data), 0));
+				owners.push_back(i);
+				continue;
+			}
+
+			UINT32 header = ((UINT32)actuals[entry.get_param_key()]->ListMax << 16) | static_cast<UINT32>(entry.Data.size());
+			writes.push_back(SISProtocol::SercosRequest(SISProtocol::SIS_SERVICE_SERCOS_LIST_WRITE, entry.ParamVar, entry.ParamNum, TGM::Datablock_OperationData, TGM::Data(header), 0, 0, 4));
+			owners.push_back(i);
+
+			for (size_t offset = 0; offset < entry.Data.size(); offset += SIS_LIST_SEGMENT_SIZE)
+			{
+				size_t size = std::min<size_t>(SIS_LIST_SEGMENT_SIZE, entry.Data.size() - offset);
+				TGM::Data segment(std::vector<BYTE>(entry.Data.begin() + offset, entry.Data.begin() + offset + size));
+				writes.push_back(SISProtocol::SercosRequest(SISProtocol::SIS_SERVICE_SERCOS_LIST_WRITE, entry.ParamVar, entry.ParamNum, TGM::Datablock_OperationData, segment, 0, static_cast<USHORT>(4 + offset), static_cast<USHORT>(size)));
+				owners.push_back(i);
+			}
+		}
+
+		// Enter parameterization level 1 (S-0-0420) // Command C0400
+		_sis->execute_command(TGM::SercosParamS, 420);
+
+		try
+		{
+			_sis->transceive_sequential(writes);
+		}
+		catch (...)
+		{
+			// Leave parameterization level 1 (S-0-0422) // Command C0200
+			_sis->execute_command(TGM::SercosParamS, 422);
+			throw;
+		}
+
+		// Leave parameterization level 1 (S-0-0422) // Command C0200
+		_sis->execute_command(TGM::SercosParamS, 422);
+
+		std::vector<USHORT> errors(diffs.size(), 0);
+		for (size_t k = 0; k < writes.size(); k++)
+			if (!errors[owners[k]]) errors[owners[k]] = writes[k].Error;
+
+		// Verify the written parameters
+		std::vector<Entry> written;
+		for (size_t i = 0; i < diffs.size(); i++)
+			written.push_back(*diffs[i]);
+
+		SISBackup verify;
+		verify.read(_sis, written);
+
+		std::map<UINT32, const Entry*> verified;
+		for (size_t i = 0; i < verify.m_entries.size(); i++)
+			verified[verify.m_entries[i].get_param_key()] = &verify.m_entries[i];
+
+		for (size_t i = 0; i < diffs.size(); i++)
+		{
+			const Entry& entry = *diffs[i];
+			_stats.Written++;
+
+			if (errors[i])
+				failed.append(sformat("%c-0-%04u: Write failed (0x%04X). ", entry.ParamVar == TGM::SercosParamS ? 'S' : 'P', entry.ParamNum, errors[i]));
+			else if (!verified.count(entry.get_param_key()) || verified[entry.get_param_key()]->Data != entry.Data)
+				failed.append(sformat("%c-0-%04u: Verify mismatched. ", entry.ParamVar == TGM::SercosParamS ? 'S' : 'P', entry.ParamNum));
+			else
+				continue;
+
+			_stats.Failed++;
+		}
+	}
+
+	if (!failed.empty())
+		throw SISProtocol::ExceptionGeneric(-1, sformat("Restoring parameters failed: %s", failed.c_str()));
+}
@@ -0,0 +1,162 @@
+/// @file
+/// Contains the parameter backup that reads all backup parameters of a drive into a compact binary image.
+
+#ifndef _SISBACKUP_H_
+#define _SISBACKUP_H_
+
+#include <Windows.h>
+#include <stdint.h>
+#include <vector>
+
+#include "debug.h"
+#include "SISProtocol.h"
+
+
+/// Magic number of a backup image ("ISBK").
+#define SISBACKUP_MAGIC			0x4B425349
+/// Format version of a backup image.
+#define SISBACKUP_VERSION		1
+/// Default IDN list of the parameters to be backed up: S-0-0192 (IDN-list of backup operation data). Use S-0-0017
+/// (IDN-list of all operation data) to back up all parameters.
+#define SISBACKUP_IDNLIST		192
+
+
+#pragma pack(push,1)
+/// Header of a backup image. Followed by the index (one SISBackupIndex per parameter) and the data of all parameters.
+typedef struct SISBackupHeader
+{
+	/// Magic number, SISBACKUP_MAGIC.
+	uint32_t Magic;
+	/// Format version, SISBACKUP_VERSION.
+	uint16_t Version;
+	/// Number of parameters.
+	uint16_t Count;
+} SISBackupHeader;
+
+/// Index entry of a parameter within a backup image.
+typedef struct SISBackupIndex
+{
+	/// Parameter ident: Parameter number (bits 11...0), and parameter variant (bit 15), as of TGM::Bitfields::SercosParamIdent.
+	uint16_t Ident;
+	/// Parameter attribute.
+	uint32_t Attribute;
+	/// SIS error code if the parameter could not be read, or 0 if succeeded.
+	uint16_t Error;
+	/// Offset of the data in [bytes], relative to the begin of the data section.
+	uint32_t Offset;
+	/// Length of the data in [bytes]. Lists are stored without list header.
+	uint16_t Length;
+} SISBackupIndex;
+
+/// Statistics of a parameter restore.
+typedef struct SISRestoreStats
+{
+	/// Number of parameters in the backup image.
+	uint16_t Count;
+	/// Number of parameters that differed from the backup, and have been written.
+	uint16_t Written;
+	/// Number of parameters that could not be restored: Not readable, write failed, or verify mismatched.
+	uint16_t Failed;
+} SISRestoreStats;
+#pragma pack(pop)
+
+
+/// Backup of the parameters of a drive.
+///
+/// The parameters are enumerated by an IDN list (S-0-0192 by default). Attributes, single values, list headers and
+/// list segments are read in as few telegrams as possible (SIS service 0x04), so that a full backup takes a few link
+/// round trips per telegram size instead of one per parameter.
+///
+/// Backups of several drives can run in parallel, since each drive has its own SIS protocol reference.
+///
+/// @code{.cpp}
+/// SISBackup backup;
+/// backup.read(SISProtocol_ref);
+/// backup.save(L"drive1.isbk");
+///
+/// SISBackup image;
+/// image.load(L"drive1.isbk");
+/// image.restore(SISProtocol_ref, stats);
+/// @endcode
+class SISBackup
+{
+public:
+	/// Backed up parameter.
+	typedef struct Entry
+	{
+		/// SERCOS Parameter variant (S, or P).
+		TGM::SercosParamVar ParamVar;
+		/// SERCOS Parameter number.
+		USHORT ParamNum;
+		/// Parameter attribute.
+		UINT32 Attribute;
+		/// SIS error code if the parameter could not be read, or 0 if succeeded.
+		USHORT Error;
+		/// Operation data. Lists without list header.
+		std::vector<BYTE> Data;
+		/// Maximum length of the list in [bytes], as read from the drive (lists only). Not stored in images.
+		USHORT ListMax;
+
+		/// Gets the key of the parameter.
+		///
+		/// @return	The parameter key.
+		UINT32 get_param_key() const { return ((UINT32)ParamVar << 16) | ParamNum; }
+
+		/// Checks if the parameter is a list.
+		///
+		/// @return	True if list, false if single value.
+		bool is_list() const { return (TGM::Bitfields::SercosParamAttribute(Attribute).Bits.DataLen & 0b100) != 0; }
+	} Entry;
+
+	/// Constructor. The backup is empty.
+	SISBackup();
+	/// Destructor.
+	virtual ~SISBackup();
+
+	/// Reads all parameters of an IDN list from the drive. Parameters that cannot be read are kept with their SIS
+	/// error code. Parameters of other parameter sets, and structure elements are skipped.
+	///
+	/// @param [in]	_sis	 	SIS protocol reference of the drive.
+	/// @param	   	_idnlist	(Optional) Number of the S-Parameter that lists the parameters to be backed up.
+	void read(SISProtocol * _sis, const USHORT _idnlist = SISBACKUP_IDNLIST);
+
+	/// Reads the given parameters from the drive, e.g. the parameters of another backup.
+	///
+	/// @param [in]	_sis   	SIS protocol reference of the drive.
+	/// @param	   	_params	Parameters to be read. Only parameter variants and numbers are used.
+	void read(SISProtocol * _sis, const std::vector<Entry>& _params);
+
+	/// Writes the backup into an image file.
+	///
+	/// @param	_path	Path of the image file. Overwritten, if existing.
+	void save(const wchar_t * _path) const;
+
+	/// Reads the backup from an image file.
+	///
+	/// @param	_path	Path of the image file.
+	void load(const wchar_t * _path);
+
+	/// Restores the backup onto the drive, with a minimal number of writes.
+	///
+	/// The current values of all parameters are read in bulk first. Only parameters whose operation data differs from
+	/// the backup are written, within a single parameterization level bracket (C0400 ... C0200). The written
+	/// parameters are read back in bulk afterwards to verify them. Restoring a backup that equals the drive causes no
+	/// writes at all. Throws SISProtocol::ExceptionGeneric listing all parameters that could not be restored.
+	///
+	/// @param [in]	_sis  	SIS protocol reference of the drive.
+	/// @param [out]	_stats	Statistics of the restore. Set even if the restore failed partly.
+	void restore(SISProtocol * _sis, SISRestoreStats& _stats) const;
+
+	/// Gets the backed up parameters.
+	///
+	/// @return	The parameters.
+	const std::vector<Entry>& get_entries() const { return m_entries; }
+
+private:
+	void read_entries(SISProtocol * _sis, std::vector<Entry>& _entries);
+
+private:
+	std::vector<Entry> m_entries;
+};
+
+#endif /* _SISBACKUP_H_ */
@@ -0,0 +1,99 @@
+#include "SISCommand.h"
+
+
+
+SISCommand::SISCommand(Job _job) :
+	m_state(ECommandBusy),
+	m_cancel(false)
+{
+	// Worker is started as last member, so that all members are initialized before the job is running
+	m_worker = std::thread(&SISCommand::run, this, _job);
+}
+
+
+SISCommand::~SISCommand()
+{
+	if (m_worker.joinable())
+		m_worker.join();
+}
+
+
+SISCommand::ECommandState SISCommand::get_state()
+{
+	std::lock_guard<std::mutex> lock(mutex_state);
+
+	return m_state;
+}
+
+
+SISCommand::ECommandState SISCommand::wait(DWORD _timeout)
+{
+	std::unique_lock<std::mutex> lock(mutex_state);
+
+	if (_timeout == INFINITE)
+		m_finished.wait(lock, [this] { return m_state != ECommandBusy; });
+	else
+		m_finished.wait_for(lock, std::chrono::milliseconds(_timeout), [this] { return m_state != ECommandBusy; });
+
+	return m_state;
+}
+
+
+void SISCommand::cancel()
+{
+	m_cancel = true;
+}
+
+
+void SISCommand::rethrow()
+{
+	std::exception_ptr ex;
+	{
+		std::lock_guard<std::mutex> lock(mutex_state);
+		ex = m_exception;
+	}
+
+	if (ex) std::rethrow_exception(ex);
+}
+
+
+std::string SISCommand::get_message()
+{
+	try
+	{
+		rethrow();
+	}
+	catch (std::exception &ex)
+	{
+		return std::string(ex.what());
+	}
+
+	return std::string();
+}
+
+
+void SISCommand::run(Job _job)
+{
+	STACK;
+
+	ECommandState state = ECommandDone;
+	std::exception_ptr ex;
+
+	try
+	{
+		_job(*this);
+	}
+	catch (...)
+	{
+		ex = std::current_exception();
+		state = m_cancel ? ECommandCanceled : ECommandFailed;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_state);
+		m_exception = ex;
+		m_state = state;
+	}
+
+	m_finished.notify_all();
+}
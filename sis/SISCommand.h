@@ -0,0 +1,94 @@
+/// @file
+/// Contains the handle class for Indradrive commands (e.g. C0500, C0400) that are executed asynchronously.
+
+#ifndef _SISCOMMAND_H_
+#define _SISCOMMAND_H_
+
+#include <Windows.h>
+#include <string>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <thread>
+#include <atomic>
+
+#include "debug.h"
+
+
+/// Handle of an Indradrive command, or a sequence of commands, that is processed in the background.
+///
+/// The command job is started immediately by the constructor in a dedicated worker thread. The handle can be polled
+/// (get_state()), waited for (wait()) or cancelled (cancel()). Cancellation is cooperative: the job checks
+/// is_cancel_requested() between its telegrams and cancels a running drive command by Commandrequest_Cancel.
+///
+/// @sa	SISProtocol::execute_command_async
+class SISCommand
+{
+public:
+	/// Values that represent the processing state of a command.
+	typedef enum ECommandState
+	{
+		/// Command is still being processed
+		ECommandBusy		= 0,
+		/// Command has been finished successfully
+		ECommandDone		= 1,
+		/// Command execution failed
+		ECommandFailed		= 2,
+		/// Command execution has been canceled
+		ECommandCanceled	= 3
+	} ECommandState;
+
+	/// Job that is processed by the worker thread. The command handle is passed to check for cancellation.
+	typedef std::function<void(SISCommand&)> Job;
+
+	/// Constructor. Starts processing of the job.
+	///
+	/// @param	_job	Job to be processed in the background.
+	SISCommand(Job _job);
+	/// Destructor. Blocks until the job has been finished.
+	virtual ~SISCommand();
+
+	/// Gets the current processing state without blocking.
+	///
+	/// @return	The processing state.
+	ECommandState get_state();
+
+	/// Waits until the job has been finished or the timeout has elapsed.
+	///
+	/// @param	_timeout	(Optional) Timeout in [ms]. Default: INFINITE.
+	///
+	/// @return	The processing state after waiting.
+	ECommandState wait(DWORD _timeout = INFINITE);
+
+	/// Requests the cancellation of the job. The call returns immediately; use wait() to wait for completion.
+	void cancel();
+
+	/// Query if cancellation of the job has been requested.
+	///
+	/// @return	True if cancel requested, false if not.
+	bool is_cancel_requested() const { return m_cancel; }
+
+	/// Rethrows the exception that caused the job to fail or to be canceled. Does nothing if no exception occurred.
+	void rethrow();
+
+	/// Gets the error message of a failed or canceled job.
+	///
+	/// @return	The error message, or an empty string if no error occurred.
+	std::string get_message();
+
+private:
+	void run(Job _job);
+
+private:
+	std::mutex mutex_state;
+	std::condition_variable m_finished;
+
+	ECommandState m_state;
+	std::atomic<bool> m_cancel;
+	std::exception_ptr m_exception;
+
+	std::thread m_worker;
+};
+
+#endif /* _SISCOMMAND_H_ */
@@ -0,0 +1,88 @@
+#include "SISLinkArbiter.h"
+
+
+
+thread_local SISPriority SISLinkArbiter::m_priority = SISPriority_Command;
+
+
+SISLinkArbiter::SISLinkArbiter() :
+	m_depth(0)
+{
+	memset(m_waiting, 0, sizeof(m_waiting));
+	memset(m_drawn, 0, sizeof(m_drawn));
+	memset(m_served, 0, sizeof(m_served));
+}
+
+
+void SISLinkArbiter::lock()
+{
+	std::unique_lock<std::mutex> lock(mutex_arbiter);
+
+	// Recursive lock by the owner
+	if (m_depth && m_owner == std::this_thread::get_id())
+	{
+		m_depth++;
+		return;
+	}
+
+	const size_t priority = m_priority;
+	const uint64_t ticket = m_drawn[priority]++;
+	m_waiting[priority]++;
+
+	m_released.wait(lock, [&] { return !m_depth && is_next(priority, ticket); });
+
+	m_waiting[priority]--;
+	m_served[priority]++;
+
+	m_owner = std::this_thread::get_id();
+	m_depth = 1;
+}
+
+
+bool SISLinkArbiter::try_lock()
+{
+	std::lock_guard<std::mutex> lock(mutex_arbiter);
+
+	// Recursive lock by the owner
+	if (m_depth && m_owner == std::this_thread::get_id())
+	{
+		m_depth++;
+		return true;
+	}
+
+	if (m_depth) return false;
+
+	// Waiting exchanges of the same or a higher class go first
+	for (size_t i = m_priority; i < SISPriority_Count; i++)
+		if (m_waiting[i]) return false;
+
+	m_owner = std::this_thread::get_id();
+	m_depth = 1;
+
+	return true;
+}
+
+
+void SISLinkArbiter::unlock()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_arbiter);
+
+		if (--m_depth) return;
+
+		m_owner = std::thread::id();
+	}
+
+	// All waiters check whether they are next
+	m_released.notify_all();
+}
+
+
+bool SISLinkArbiter::is_next(const size_t _class, const uint64_t _ticket) const
+{
+	// No waiting exchange of a higher class, and first in order of arrival within the own class
+	for (size_t i = _class + 1; i < SISPriority_Count; i++)
+		if (m_waiting[i]) return false;
+
+	return m_served[_class] == _ticket;
+}
@@ -0,0 +1,116 @@
+/// @file
+/// Contains the link arbiter that grants the serial link to telegram exchanges by priority class.
+
+#ifndef _SISLINKARBITER_H_
+#define _SISLINKARBITER_H_
+
+#include <Windows.h>
+#include <stdint.h>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+
+/// Values that represent the priority classes of telegram exchanges. Higher values are served first.
+typedef enum SISPriority
+{
+	/// Bulk transfers: List downloads, backups, and restores.
+	SISPriority_Bulk		= 0,
+	/// Cyclic status polls: Drive monitor and keepalive.
+	SISPriority_Poll		= 1,
+	/// Commands and parameter accesses of the application. Default class.
+	SISPriority_Command		= 2,
+	/// Real-time setpoints.
+	SISPriority_Setpoint	= 3,
+	/// Number of priority classes.
+	SISPriority_Count		= 4
+} SISPriority;
+
+
+/// Arbiter of the serial link, used in place of a mutex (BasicLockable).
+///
+/// Each telegram exchange holds the link on its own. When the link is released, it is granted to the waiting exchange
+/// of the highest priority class, in order of arrival within the class. Thus, a bulk transfer that consists of many
+/// telegrams is preempted at the next telegram boundary, and delays a setpoint by one telegram time at most.
+///
+/// The priority class is a property of the calling thread, set by SISPriorityScope. The link can be locked
+/// recursively by the owning thread, e.g. to renegotiate the baud rate during a reconnect.
+class SISLinkArbiter
+{
+public:
+	/// Constructor.
+	SISLinkArbiter();
+
+	/// Waits until the link is granted to the calling thread, by the priority class of the thread.
+	void lock();
+	/// Takes the link without waiting, if it is free and no exchange of the same or a higher priority class is
+	/// waiting.
+	///
+	/// @return	True if the link has been granted, false otherwise.
+	bool try_lock();
+	/// Releases the link, and grants it to the next waiting exchange.
+	void unlock();
+
+	/// Gets the priority class of the calling thread.
+	///
+	/// @return	The priority class.
+	static SISPriority get_priority() { return m_priority; }
+
+	/// Sets the priority class of the calling thread. Prefer SISPriorityScope.
+	///
+	/// @param	_priority	The priority class.
+	static void set_priority(const SISPriority _priority) { m_priority = _priority; }
+
+private:
+	bool is_next(const size_t _class, const uint64_t _ticket) const;
+
+private:
+	std::mutex mutex_arbiter;
+	std::condition_variable m_released;
+
+	/// Thread that holds the link, and the number of recursive locks.
+	std::thread::id m_owner;
+	size_t m_depth;
+
+	/// Number of waiting exchanges per priority class.
+	size_t m_waiting[SISPriority_Count];
+	/// Next ticket to be drawn, and ticket to be served next per priority class (order of arrival).
+	uint64_t m_drawn[SISPriority_Count];
+	uint64_t m_served[SISPriority_Count];
+
+	static thread_local SISPriority m_priority;
+};
+
+
+/// Sets the priority class of the calling thread for the lifetime of the scope, and restores the previous class
+/// afterwards.
+///
+/// @code{.cpp}
+/// {
+/// 	SISPriorityScope priority(SISPriority_Bulk);
+/// 	SISProtocol_ref->read_list(TGM::SercosParamP, 21, data);
+/// }
+/// @endcode
+class SISPriorityScope
+{
+public:
+	/// Constructor.
+	///
+	/// @param	_priority	The priority class.
+	SISPriorityScope(const SISPriority _priority) :
+		m_previous(SISLinkArbiter::get_priority())
+	{
+		SISLinkArbiter::set_priority(_priority);
+	}
+
+	/// Destructor. Restores the previous priority class.
+	~SISPriorityScope()
+	{
+		SISLinkArbiter::set_priority(m_previous);
+	}
+
+private:
+	SISPriority m_previous;
+};
+
+#endif /* _SISLINKARBITER_H_ */
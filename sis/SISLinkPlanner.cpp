@@ -0,0 +1,176 @@
+#include "SISLinkPlanner.h"
+
+#include <map>
+
+
+
+SISLinkPlanner::SISLinkPlanner(const UINT32 _baudrate, const bool _sequential) :
+	m_baudrate(_baudrate),
+	m_sequential(_sequential)
+{
+}
+
+
+SISLinkPlanner::~SISLinkPlanner()
+{
+}
+
+
+SISLinkBudget SISLinkPlanner::plan(SISCyclicTask _tasks[], const size_t _len, const DOUBLE _limit)
+{
+	STACK;
+
+	if (!m_baudrate)
+		throw SISProtocol::ExceptionGeneric(-1, "Baud rate is unknown. Open the communication port first.");
+
+	if (_limit <= 0)
+		throw SISProtocol::ExceptionGeneric(-1, "Utilisation limit must be greater than 0.");
+
+	std::vector<DOUBLE> periods(_len);
+	for (size_t i = 0; i < _len; i++)
+	{
+		if (_tasks[i].Period <= 0)
+			throw SISProtocol::ExceptionGeneric(-1, sformat("Period of %c-0-%04u must be greater than 0 ms.", _tasks[i].ParamVar ? 'P' : 'S', _tasks[i].ParamNum));
+
+		periods[i] = _tasks[i].Period;
+	}
+
+	SISLinkBudget budget;
+	budget.Baudrate = m_baudrate;
+	budget.Limit = _limit;
+
+	std::vector<DOUBLE> airtimes;
+	budget.Load = compute(_tasks, periods, airtimes, budget.TelegramRate);
+	budget.Fits = budget.Load <= _limit;
+
+	for (size_t i = 0; i < _len; i++)
+	{
+		_tasks[i].Airtime = airtimes[i];
+		_tasks[i].Load = airtimes[i] / periods[i];
+	}
+
+	// Doubling the period of the access with the highest load, until the accesses fit
+	DOUBLE load = budget.Load;
+	DOUBLE telegrams = 0;
+	while (load > _limit)
+	{
+		size_t worst = _len;
+		for (size_t i = 0; i < _len; i++)
+		{
+			if (periods[i] >= _tasks[i].Period * SISLINKPLANNER_RELAX_MAX) continue;
+			if (worst == _len || airtimes[i] / periods[i] > airtimes[worst] / periods[worst]) worst = i;
+		}
+
+		if (worst == _len) break;
+
+		periods[worst] *= 2;
+		load = compute(_tasks, periods, airtimes, telegrams);
+	}
+
+	budget.RelaxedLoad = load;
+
+	for (size_t i = 0; i < _len; i++)
+		_tasks[i].RelaxedPeriod = periods[i];
+
+	return budget;
+}
+
+
+DOUBLE SISLinkPlanner::compute(const SISCyclicTask _tasks[], const std::vector<DOUBLE>& _periods, std::vector<DOUBLE>& _airtimes, DOUBLE& _telegrams) const
+{
+	_airtimes.assign(_periods.size(), 0);
+	_telegrams = 0;
+
+	// Accesses of the same period share telegrams, if sequential telegrams are used
+	std::vector<std::vector<size_t>> groups;
+	std::map<DOUBLE, size_t> periods;
+	for (size_t i = 0; i < _periods.size(); i++)
+	{
+		if (m_sequential && periods.count(_periods[i]))
+		{
+			groups[periods[_periods[i]]].push_back(i);
+			continue;
+		}
+
+		periods[_periods[i]] = groups.size();
+		groups.push_back(std::vector<size_t>(1, i));
+	}
+
+	DOUBLE load = 0;
+	for (size_t g = 0; g < groups.size(); g++)
+	{
+		const std::vector<size_t>& group = groups[g];
+		const DOUBLE period = _periods[group.front()];
+
+		size_t first = 0;
+		while (first < group.size())
+		{
+			// Same packing as SISProtocol::transceive_sequential()
+			size_t last = first;
+			size_t tx_len = 0;
+			size_t rx_len = 1;
+			while (last < group.size())
+			{
+				SISProtocol::SercosRequest req = get_request(_tasks[group[last]]);
+				size_t tx_add = 1 + req.get_request_size();
+				size_t rx_add = 1 + req.get_reaction_size();
+
+				if (tx_len + tx_add > TGM_SIZEMAX_PAYLOAD || rx_len + rx_add > TGM_SIZEMAX_PAYLOAD) break;
+
+				tx_len += tx_add;
+				rx_len += rx_add;
+				last++;
+			}
+
+			if (last - first < 2)
+			{
+				// Single telegram: Header, and SERCOS payload head and data
+				const SISCyclicTask& task = _tasks[group[first]];
+				size_t datalen = task.DataLen;
+
+				size_t tx = TGM_SIZE_HEADER + TGM::Commands::SercosParam().get_head_size() + (task.Write ? datalen : 0);
+				size_t rx = TGM_SIZE_HEADER + TGM::Reactions::SercosParam().get_head_size() + (task.Write ? 0 : datalen);
+
+				_airtimes[group[first]] = get_airtime(tx + rx);
+				last = first + 1;
+			}
+			else
+			{
+				// Sequential telegram: Headers are shared evenly
+				DOUBLE shared = get_airtime(TGM_SIZE_HEADER + TGM_SIZE_HEADER + 1) / (last - first);
+
+				for (size_t k = first; k < last; k++)
+				{
+					SISProtocol::SercosRequest req = get_request(_tasks[group[k]]);
+					_airtimes[group[k]] = shared + get_airtime(2 + req.get_request_size() + req.get_reaction_size());
+				}
+			}
+
+			for (size_t k = first; k < last; k++)
+				load += _airtimes[group[k]] / period;
+
+			_telegrams += 1000.0 / period;
+			first = last;
+		}
+	}
+
+	return load;
+}
+
+
+DOUBLE SISLinkPlanner::get_airtime(const size_t _bytes) const
+{
+	// Airtime in [ms]
+	return static_cast<DOUBLE>(_bytes * SISLINKSTATS_BITS_PER_BYTE) * 1000.0 / m_baudrate;
+}
+
+
+SISProtocol::SercosRequest SISLinkPlanner::get_request(const SISCyclicTask& _task)
+{
+	TGM::SercosParamVar paramvar = _task.ParamVar ? TGM::SercosParamP : TGM::SercosParamS;
+
+	if (_task.Write)
+		return SISProtocol::SercosRequest(SISProtocol::SIS_SERVICE_SERCOS_PARAM_WRITE, paramvar, _task.ParamNum, TGM::Datablock_OperationData, TGM::Data(std::vector<BYTE>(_task.DataLen, 0)), 0);
+
+	return SISProtocol::SercosRequest(SISProtocol::SIS_SERVICE_SERCOS_PARAM_READ, paramvar, _task.ParamNum, TGM::Datablock_OperationData, TGM::Data(), _task.DataLen);
+}
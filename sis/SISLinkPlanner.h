@@ -0,0 +1,108 @@
+/// @file
+/// Contains the link budget planner that computes the airtime of cyclic parameter accesses.
+
+#ifndef _SISLINKPLANNER_H_
+#define _SISLINKPLANNER_H_
+
+#include <Windows.h>
+#include <stdint.h>
+#include <math.h>
+#include <vector>
+
+#include "debug.h"
+#include "SISProtocol.h"
+
+
+/// Default utilisation limit of the line (0 ... 1). Leaves headroom for commands and for the turnaround of the device.
+#define SISLINKPLANNER_LIMIT_DEFAULT	0.8
+/// Maximum factor by which a period is relaxed.
+#define SISLINKPLANNER_RELAX_MAX		1024
+
+
+#pragma pack(push,1)
+/// Cyclic parameter access to be planned.
+typedef struct SISCyclicTask
+{
+	/// Parameter variant: 0 for S-Parameter, 1 for P-Parameter.
+	uint8_t ParamVar;
+	/// Parameter number, e.g. 36 for S-0-0036.
+	uint16_t ParamNum;
+	/// 0 if the parameter is read, 1 if written.
+	uint8_t Write;
+	/// Data length of the parameter in [bytes]: 1, 2, 4, or 8. 0 to read it from the parameter attribute.
+	uint8_t DataLen;
+	/// Period in [ms].
+	double_t Period;
+	/// Result: Airtime of the access in [ms] per period, including its share of the telegram headers.
+	double_t Airtime;
+	/// Result: Share of the line time taken by the access at Period (0 ... 1).
+	double_t Load;
+	/// Result: Period in [ms] that fits into the budget. Equals Period if it does not have to be relaxed.
+	double_t RelaxedPeriod;
+} SISCyclicTask;
+
+/// Link budget of a set of cyclic parameter accesses.
+typedef struct SISLinkBudget
+{
+	/// Baud rate the budget has been computed for.
+	uint32_t Baudrate;
+	/// Utilisation limit of the line (0 ... 1).
+	double_t Limit;
+	/// Utilisation of the line required by the accesses at their periods.
+	double_t Load;
+	/// Utilisation of the line at the relaxed periods.
+	double_t RelaxedLoad;
+	/// Number of telegrams per second at the periods.
+	double_t TelegramRate;
+	/// 1 if the accesses fit into the budget at their periods, 0 if periods have to be relaxed.
+	uint8_t Fits;
+} SISLinkBudget;
+#pragma pack(pop)
+
+
+/// Planner of the link budget for cyclic parameter accesses.
+///
+/// The airtime of an access is computed from the sizes of the real telegrams: SIS header, SERCOS payload head, and
+/// data of the command and the reaction telegram, at 10 bits per byte. If sequential telegrams are used, accesses of
+/// the same period are gathered into telegrams of SIS service 0x04 the same way as SISProtocol::transceive_sequential()
+/// does, and share the telegram headers.
+///
+/// If the accesses do not fit into the limit, the period of the access with the highest load is doubled repeatedly,
+/// until they fit.
+///
+/// @code{.cpp}
+/// SISLinkPlanner planner(115200, true);
+/// SISLinkBudget budget = planner.plan(tasks, len, 0.8);
+/// @endcode
+class SISLinkPlanner
+{
+public:
+	/// Constructor.
+	///
+	/// @param	_baudrate  	Baud rate of the serial line.
+	/// @param	_sequential	True if accesses of the same period are gathered into sequential telegrams.
+	SISLinkPlanner(const UINT32 _baudrate, const bool _sequential);
+	/// Destructor.
+	virtual ~SISLinkPlanner();
+
+	/// Computes the airtime and load of the accesses, and relaxes their periods if they do not fit into the limit.
+	///
+	/// @param	_tasks	The accesses. Data lengths have to be set. Results are set.
+	/// @param	_len  	Number of accesses.
+	/// @param	_limit	Utilisation limit of the line (0 ... 1).
+	///
+	/// @return	The budget.
+	SISLinkBudget plan(SISCyclicTask _tasks[], const size_t _len, const DOUBLE _limit);
+
+private:
+	DOUBLE compute(const SISCyclicTask _tasks[], const std::vector<DOUBLE>& _periods, std::vector<DOUBLE>& _airtimes, DOUBLE& _telegrams) const;
+	DOUBLE get_airtime(const size_t _bytes) const;
+
+	static SISProtocol::SercosRequest get_request(const SISCyclicTask& _task);
+
+private:
+	UINT32 m_baudrate;
+	bool m_sequential;
+};
+
+#endif /* _SISLINKPLANNER_H_ */
@@ -0,0 +1,120 @@
+#include "SISLinkStats.h"
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+
+
+// SIS services: Init communication, sequential operation, parameter read, list read, read phase, switch phase, list
+// write, parameter write
+const BYTE SISLinkCounter::m_slots[SISLINKSTATS_SERVICES] = { 0x03, 0x04, 0x10, 0x11, 0x12, 0x1D, 0x1E, 0x1F };
+
+
+SISLinkCounter::SISLinkCounter()
+{
+	reset(0);
+}
+
+
+void SISLinkCounter::record_tx(const BYTE _service, const SISPriority _priority, const size_t _bytes, const UINT32 _baudrate)
+{
+	add(m_total, 1, _bytes, 0, 0, _baudrate);
+	add(m_classes[_priority], 1, _bytes, 0, 0, _baudrate);
+
+	size_t slot = get_service_slot(_service);
+	if (slot < SISLINKSTATS_SERVICES) add(m_services[slot], 1, _bytes, 0, 0, _baudrate);
+}
+
+
+void SISLinkCounter::record_rx(const BYTE _service, const SISPriority _priority, const size_t _bytes, const UINT32 _baudrate)
+{
+	add(m_total, 0, 0, 1, _bytes, _baudrate);
+	add(m_classes[_priority], 0, 0, 1, _bytes, _baudrate);
+
+	size_t slot = get_service_slot(_service);
+	if (slot < SISLINKSTATS_SERVICES) add(m_services[slot], 0, 0, 1, _bytes, _baudrate);
+}
+
+
+void SISLinkCounter::record_param(const USHORT _ident, const size_t _txbytes, const size_t _rxbytes, const UINT32 _baudrate)
+{
+	// Value-initialized, i.e. zero, on first use
+	add(m_params[_ident], 1, _txbytes, 1, _rxbytes, _baudrate);
+}
+
+
+void SISLinkCounter::reset(const LONGLONG _now)
+{
+	memset(&m_total, 0, sizeof(m_total));
+	memset(m_services, 0, sizeof(m_services));
+	memset(m_classes, 0, sizeof(m_classes));
+	m_params.clear();
+
+	m_start = _now;
+}
+
+
+SISLinkStats SISLinkCounter::get(const LONGLONG _now, const LONGLONG _frequency, const UINT32 _baudrate) const
+{
+	SISLinkStats stats;
+	memset(&stats, 0, sizeof(stats));
+
+	stats.Baudrate = _baudrate;
+	stats.Duration = _frequency ? static_cast<double>(_now - m_start) / _frequency : 0;
+
+	const double duration = stats.Duration;
+	auto utilise = [duration](SISTraffic _traffic) -> SISTraffic
+	{
+		_traffic.Utilisation = duration > 0 ? _traffic.Airtime / duration : 0;
+		return _traffic;
+	};
+
+	stats.Total = utilise(m_total);
+
+	for (size_t i = 0; i < SISLINKSTATS_SERVICES; i++)
+	{
+		stats.Services[i].Service = m_slots[i];
+		stats.Services[i].Traffic = utilise(m_services[i]);
+	}
+
+	for (size_t i = 0; i < SISPriority_Count; i++)
+		stats.Classes[i] = utilise(m_classes[i]);
+
+	// Parameters with the most airtime first
+	std::vector<std::pair<double, USHORT>> order;
+	for (std::map<USHORT, SISTraffic>::const_iterator it = m_params.begin(); it != m_params.end(); ++it)
+		order.push_back(std::make_pair(it->second.Airtime, it->first));
+
+	size_t count = std::min<size_t>(order.size(), SISLINKSTATS_PARAMS);
+	std::partial_sort(order.begin(), order.begin() + count, order.end(), std::greater<std::pair<double, USHORT>>());
+
+	stats.ParamCount = static_cast<uint16_t>(std::min<size_t>(m_params.size(), 0xFFFF));
+	for (size_t i = 0; i < count; i++)
+	{
+		stats.Params[i].Ident = order[i].second;
+		stats.Params[i].Traffic = utilise(m_params.at(order[i].second));
+	}
+
+	return stats;
+}
+
+
+size_t SISLinkCounter::get_service_slot(const BYTE _service)
+{
+	for (size_t i = 0; i < SISLINKSTATS_SERVICES; i++)
+		if (m_slots[i] == _service) return i;
+
+	return SISLINKSTATS_SERVICES;
+}
+
+
+void SISLinkCounter::add(SISTraffic& _traffic, const size_t _txtelegrams, const size_t _txbytes, const size_t _rxtelegrams, const size_t _rxbytes, const UINT32 _baudrate)
+{
+	_traffic.TxTelegrams += static_cast<uint32_t>(_txtelegrams);
+	_traffic.RxTelegrams += static_cast<uint32_t>(_rxtelegrams);
+	_traffic.TxBytes += _txbytes;
+	_traffic.RxBytes += _rxbytes;
+
+	if (_baudrate) _traffic.Airtime += static_cast<double>((_txbytes + _rxbytes) * SISLINKSTATS_BITS_PER_BYTE) / _baudrate;
+}
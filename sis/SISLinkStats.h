@@ -0,0 +1,112 @@
+/// @file
+/// Contains the traffic counter that accounts the bytes and telegrams on the serial link, and derives its utilisation.
+
+#ifndef _SISLINKSTATS_H_
+#define _SISLINKSTATS_H_
+
+#include <Windows.h>
+#include <stdint.h>
+#include <math.h>
+#include <map>
+
+#include "SISLinkArbiter.h"
+
+
+/// Bits per byte on the serial line: Start bit, 8 data bits, stop bit (8N1).
+#define SISLINKSTATS_BITS_PER_BYTE	10
+/// Number of SIS services that are accounted separately.
+#define SISLINKSTATS_SERVICES		8
+/// Number of parameters reported by SISLinkStats, the ones with the most airtime.
+#define SISLINKSTATS_PARAMS			16
+
+
+#pragma pack(push,1)
+/// Traffic on the serial link.
+typedef struct SISTraffic
+{
+	/// Number of sent command telegrams.
+	uint32_t TxTelegrams;
+	/// Number of received reaction telegrams.
+	uint32_t RxTelegrams;
+	/// Number of sent bytes.
+	uint64_t TxBytes;
+	/// Number of received bytes.
+	uint64_t RxBytes;
+	/// Line time of the sent and received bytes in [s], at the baud rate in effect when they were transferred.
+	double_t Airtime;
+	/// Share of the line time in the duration of the measurement (0 ... 1).
+	double_t Utilisation;
+} SISTraffic;
+
+/// Traffic of a SIS service.
+typedef struct SISServiceTraffic
+{
+	/// SIS service, e.g. 0x10 for reading parameters.
+	uint8_t Service;
+	/// Traffic of the service.
+	SISTraffic Traffic;
+} SISServiceTraffic;
+
+/// Traffic of a SERCOS parameter.
+typedef struct SISParamTraffic
+{
+	/// Parameter ident: Parameter number (bits 11...0), and parameter variant (bit 15), as of
+	/// TGM::Bitfields::SercosParamIdent.
+	uint16_t Ident;
+	/// Traffic of the parameter. Requests that are part of a sequential telegram (SIS service 0x04) account their
+	/// own bytes only, without the telegram header.
+	SISTraffic Traffic;
+} SISParamTraffic;
+
+/// Snapshot of the traffic on the serial link.
+typedef struct SISLinkStats
+{
+	/// Baud rate of the serial line.
+	uint32_t Baudrate;
+	/// Duration of the measurement in [s].
+	double_t Duration;
+	/// Overall traffic. Utilisation tells how close the line is to saturation.
+	SISTraffic Total;
+	/// Traffic per SIS service.
+	SISServiceTraffic Services[SISLINKSTATS_SERVICES];
+	/// Traffic per priority class, indexed by SISPriority.
+	SISTraffic Classes[SISPriority_Count];
+	/// Number of parameters with traffic. Might exceed SISLINKSTATS_PARAMS.
+	uint16_t ParamCount;
+	/// Traffic of the parameters with the most airtime, in descending order. Unused entries are zero.
+	SISParamTraffic Params[SISLINKSTATS_PARAMS];
+} SISLinkStats;
+#pragma pack(pop)
+
+
+/// Traffic counter of the serial link. Counting takes constant time, except for the first telegram of a parameter.
+class SISLinkCounter
+{
+public:
+	SISLinkCounter();
+
+	void record_tx(const BYTE _service, const SISPriority _priority, const size_t _bytes, const UINT32 _baudrate);
+	void record_rx(const BYTE _service, const SISPriority _priority, const size_t _bytes, const UINT32 _baudrate);
+	void record_param(const USHORT _ident, const size_t _txbytes, const size_t _rxbytes, const UINT32 _baudrate);
+
+	void reset(const LONGLONG _now);
+	SISLinkStats get(const LONGLONG _now, const LONGLONG _frequency, const UINT32 _baudrate) const;
+
+private:
+	static size_t get_service_slot(const BYTE _service);
+	static void add(SISTraffic& _traffic, const size_t _txtelegrams, const size_t _txbytes, const size_t _rxtelegrams, const size_t _rxbytes, const UINT32 _baudrate);
+
+private:
+	/// Services accounted by the slots of m_services.
+	static const BYTE m_slots[SISLINKSTATS_SERVICES];
+
+	SISTraffic m_total;
+	SISTraffic m_services[SISLINKSTATS_SERVICES];
+	SISTraffic m_classes[SISPriority_Count];
+	std::map<USHORT, SISTraffic> m_params;
+
+	/// Performance counter at the start of the measurement.
+	LONGLONG m_start;
+};
+
+#endif /* _SISLINKSTATS_H_ */
@@ -0,0 +1,209 @@
+#include "SISMonitor.h"
+
+
+
+SISMonitor::SISMonitor(SISProtocol * _sis) :
+	m_sis(_sis),
+	m_stop(true),
+	m_release(false),
+	m_interval(SISMONITOR_INTERVAL_DEFAULT),
+	m_valid(false),
+	m_failing(false)
+{
+	memset(m_values, 0, sizeof(m_values));
+}
+
+
+SISMonitor::~SISMonitor()
+{
+	stop();
+}
+
+
+void SISMonitor::start(DWORD _interval)
+{
+	STACK;
+
+	stop();
+
+	m_interval = _interval;
+	m_valid = false;
+	m_failing = false;
+	m_stop = false;
+
+	m_sampler = std::thread(&SISMonitor::run, this);
+}
+
+
+void SISMonitor::stop()
+{
+	STACK;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_monitor);
+		m_stop = true;
+	}
+	m_wakeup.notify_all();
+
+	if (!m_sampler.joinable()) return;
+
+	// Called from within a callback: The sampler thread cannot join itself, but ends once the callback returned
+	if (m_sampler.get_id() == std::this_thread::get_id())
+		m_sampler.detach();
+	else
+		m_sampler.join();
+}
+
+
+void SISMonitor::release()
+{
+	STACK;
+
+	// Called from within a callback: Deleting is deferred to the sampler thread, which still runs the callback
+	if (m_sampler.joinable() && m_sampler.get_id() == std::this_thread::get_id())
+	{
+		m_release = true;
+		stop();
+		return;
+	}
+
+	delete this;
+}
+
+
+void SISMonitor::register_callback(SISEventCallback _callback, void * _user)
+{
+	STACK;
+
+	std::lock_guard<std::mutex> lock(mutex_monitor);
+
+	Callback callback;
+	callback.Function = _callback;
+	callback.User = _user;
+
+	m_callbacks.push_back(callback);
+}
+
+
+bool SISMonitor::poll(SISEvent & _event)
+{
+	STACK;
+
+	std::lock_guard<std::mutex> lock(mutex_monitor);
+
+	if (m_queue.empty()) return false;
+
+	_event = m_queue.front();
+	m_queue.pop_front();
+
+	return true;
+}
+
+
+void SISMonitor::run()
+{
+	STACK;
+
+	std::vector<SISEvent> events;
+
+	while (!m_stop)
+	{
+		events.clear();
+		sample(events);
+		notify(events);
+
+		// Waiting for next sample, but wake up immediately on stop()
+		std::unique_lock<std::mutex> lock(mutex_monitor);
+		m_wakeup.wait_for(lock, std::chrono::milliseconds(m_interval), [this] { return (bool)m_stop; });
+	}
+
+	if (m_release) delete this;
+}
+
+
+void SISMonitor::sample(std::vector<SISEvent>& _events)
+{
+	STACK;
+
+	static const SISEventType types[3] = { SISEvent_Opstate, SISEvent_Diagnostic, SISEvent_Drivemode };
+
+	SISPriorityScope priority(SISPriority_Poll);
+
+	// Device control: Status word (P-0-0115), Diagnostic number (S-0-0390), Primary Operation Mode (S-0-0032).
+	// All of them are integers without decimal places. Thus, attributes are not fetched.
+	std::vector<SISProtocol::SercosRequest> requests;
+	requests.push_back(SISProtocol::SercosRequest(SISProtocol::SIS_SERVICE_SERCOS_PARAM_READ, TGM::SercosParamP, 115, TGM::Datablock_OperationData, TGM::Data(), 2));
+	requests.push_back(SISProtocol::SercosRequest(SISProtocol::SIS_SERVICE_SERCOS_PARAM_READ, TGM::SercosParamS, 390, TGM::Datablock_OperationData, TGM::Data(), 4));
+	requests.push_back(SISProtocol::SercosRequest(SISProtocol::SIS_SERVICE_SERCOS_PARAM_READ, TGM::SercosParamS, 32, TGM::Datablock_OperationData, TGM::Data(), 2));
+
+	SISEvent ev;
+	ev.Timestamp = GetTickCount64();
+
+	bool failed = false;
+	try
+	{
+		m_sis->transceive_sequential(requests);
+
+		for (std::vector<SISProtocol::SercosRequest>::iterator it = requests.begin(); it != requests.end(); ++it)
+			failed |= (it->Error != 0);
+	}
+	catch (std::exception &)
+	{
+		failed = true;
+	}
+
+	// Communication errors are reported once on failing, and once on recovery
+	if (failed != m_failing)
+	{
+		ev.Type = SISEvent_Error;
+		ev.OldValue = m_failing;
+		ev.NewValue = failed;
+		_events.push_back(ev);
+
+		m_failing = failed;
+	}
+
+	if (failed) return;
+
+	for (size_t i = 0; i < 3; i++)
+	{
+		uint32_t value = requests[i].Data.toUINT32();
+
+		if (m_valid && value == m_values[i]) continue;
+
+		ev.Type = types[i];
+		ev.OldValue = m_valid ? m_values[i] : value;
+		ev.NewValue = value;
+		_events.push_back(ev);
+
+		m_values[i] = value;
+	}
+
+	m_valid = true;
+}
+
+
+void SISMonitor::notify(const std::vector<SISEvent>& _events)
+{
+	STACK;
+
+	if (_events.empty()) return;
+
+	std::vector<Callback> callbacks;
+	{
+		std::lock_guard<std::mutex> lock(mutex_monitor);
+
+		for (std::vector<SISEvent>::const_iterator it = _events.begin(); it != _events.end(); ++it)
+		{
+			if (m_queue.size() >= SISMONITOR_QUEUE_SIZE) m_queue.pop_front();
+			m_queue.push_back(*it);
+		}
+
+		callbacks = m_callbacks;
+	}
+
+	// Callbacks are fired without holding the lock, so that they are allowed to call poll() or API functions
+	for (std::vector<Callback>::iterator cb = callbacks.begin(); cb != callbacks.end(); ++cb)
+		for (std::vector<SISEvent>::const_iterator it = _events.begin(); it != _events.end(); ++it)
+			cb->Function(&(*it), cb->User);
+}
@@ -0,0 +1,117 @@
+/// @file
+/// Contains the drive monitor that samples status parameters and notifies about their changes.
+
+#ifndef _SISMONITOR_H_
+#define _SISMONITOR_H_
+
+#include <Windows.h>
+#include <stdint.h>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+
+#include "debug.h"
+#include "SISProtocol.h"
+
+
+/// Maximum number of events held by the event queue. If exceeded, the oldest events are dropped.
+#define SISMONITOR_QUEUE_SIZE		256
+/// Default sampling interval in [ms].
+#define SISMONITOR_INTERVAL_DEFAULT	100
+
+
+/// Values that represent the types of drive events.
+typedef enum SISEventType
+{
+	/// Device control status word (P-0-0115) has changed. Refer to OPSTATE for decoding.
+	SISEvent_Opstate	= 1,
+	/// Diagnostic number (S-0-0390) has changed, e.g. due to an error.
+	SISEvent_Diagnostic	= 2,
+	/// Primary operation mode (S-0-0032) has changed.
+	SISEvent_Drivemode	= 3,
+	/// Sampling failed (communication error). NewValue is 1 if failing, 0 if recovered.
+	SISEvent_Error		= 0xFF
+} SISEventType;
+
+#pragma pack(push,1)
+/// Drive event, provided by callback or event queue.
+typedef struct SISEvent
+{
+	/// Type of the event, defined by SISEventType.
+	uint8_t Type;
+	/// Previous raw value of the parameter.
+	uint32_t OldValue;
+	/// Current raw value of the parameter.
+	uint32_t NewValue;
+	/// Time stamp of the sample in [ms] since system start.
+	uint64_t Timestamp;
+} SISEvent;
+#pragma pack(pop)
+
+/// Callback fired on drive events. Called from within the sampler thread.
+typedef void(__cdecl *SISEventCallback)(const SISEvent * _event, void * _user);
+
+
+/// Drive monitor that samples P-0-0115, S-0-0390 and S-0-0032 in a single telegram (SIS service 0x04) and notifies
+/// about changes by callbacks and an event queue. A single sampler serves all consumers.
+///
+/// On the first sample after start(), events are generated for all parameters, so that consumers learn the initial
+/// state.
+class SISMonitor
+{
+public:
+	/// Constructor.
+	///
+	/// @param [in]	_sis	SIS protocol reference to be monitored.
+	SISMonitor(SISProtocol * _sis);
+	/// Destructor. Stops sampling.
+	virtual ~SISMonitor();
+
+	void start(DWORD _interval = SISMONITOR_INTERVAL_DEFAULT);
+	void stop();
+
+	/// Stops sampling and deletes the monitor. If called from within a callback, deleting is deferred until the
+	/// callback has returned.
+	void release();
+
+	void register_callback(SISEventCallback _callback, void * _user);
+	bool poll(SISEvent& _event);
+
+private:
+	/// Registered callback.
+	typedef struct Callback
+	{
+		/// Callback function.
+		SISEventCallback Function;
+		/// User data passed to the callback.
+		void * User;
+	} Callback;
+
+	void run();
+	void sample(std::vector<SISEvent>& _events);
+	void notify(const std::vector<SISEvent>& _events);
+
+private:
+	SISProtocol * m_sis;
+
+	std::thread m_sampler;
+	std::atomic<bool> m_stop;
+	/// Set by release() from within a callback: The sampler thread deletes the monitor once the callback returned.
+	bool m_release;
+	DWORD m_interval;
+
+	/// Last sampled values of P-0-0115, S-0-0390 and S-0-0032.
+	uint32_t m_values[3];
+	bool m_valid;
+	bool m_failing;
+
+	std::mutex mutex_monitor;
+	std::condition_variable m_wakeup;
+	std::deque<SISEvent> m_queue;
+	std::vector<Callback> m_callbacks;
+};
+
+#endif /* _SISMONITOR_H_ */
@@ -0,0 +1,319 @@
+#include "SISParamSession.h"
+
+
+/// Target key marking the list size adjustment of a list parameter (see PendingWrite::get_target_key()).
+#define LISTSIZE_TARGET(param_key) (((UINT64)(param_key) << 32) | 0xFFFFFFFF)
+
+
+
+SISParamSession::SISParamSession(SISProtocol * _sis, bool _paramlevel) :
+	m_sis(_sis),
+	m_paramlevel(_paramlevel)
+{
+}
+
+
+SISParamSession::~SISParamSession()
+{
+}
+
+
+void SISParamSession::write_parameter(TGM::SercosParamVar _paramvar, USHORT _paramnum, const UINT32 _data)
+{
+	STACK;
+
+	write_parameter(_paramvar, _paramnum, static_cast<UINT64>(_data));
+}
+
+
+void SISParamSession::write_parameter(TGM::SercosParamVar _paramvar, USHORT _paramnum, const UINT64 _data)
+{
+	STACK;
+
+	PendingWrite write;
+	write.ParamVar = _paramvar;
+	write.ParamNum = _paramnum;
+	write.IsList = false;
+	write.ElmPos = 0;
+	write.Format = WriteFormat_Integer;
+	write.Value = 0;
+	write.Integer = _data;
+
+	m_pending.push_back(write);
+}
+
+
+void SISParamSession::write_parameter(TGM::SercosParamVar _paramvar, USHORT _paramnum, const DOUBLE _data)
+{
+	STACK;
+
+	PendingWrite write;
+	write.ParamVar = _paramvar;
+	write.ParamNum = _paramnum;
+	write.IsList = false;
+	write.ElmPos = 0;
+	write.Format = WriteFormat_Double;
+	write.Value = _data;
+	write.Integer = 0;
+
+	m_pending.push_back(write);
+}
+
+
+void SISParamSession::write_parameter_raw(TGM::SercosParamVar _paramvar, USHORT _paramnum, const UINT64 _raw)
+{
+	STACK;
+
+	PendingWrite write;
+	write.ParamVar = _paramvar;
+	write.ParamNum = _paramnum;
+	write.IsList = false;
+	write.ElmPos = 0;
+	write.Format = WriteFormat_Raw;
+	write.Value = 0;
+	write.Integer = _raw;
+
+	m_pending.push_back(write);
+}
+
+
+void SISParamSession::write_listelm(TGM::SercosParamVar _paramvar, USHORT _paramnum, USHORT _elm_pos, const DOUBLE _data)
+{
+	STACK;
+
+	PendingWrite write;
+	write.ParamVar = _paramvar;
+	write.ParamNum = _paramnum;
+	write.IsList = true;
+	write.ElmPos = _elm_pos;
+	write.Format = WriteFormat_Double;
+	write.Value = _data;
+	write.Integer = 0;
+
+	m_pending.push_back(write);
+}
+
+
+void SISParamSession::commit(SISCommand * _ctx)
+{
+	STACK;
+
+	// Writes are reported as not executed, unless their reaction confirms otherwise
+	m_results.assign(m_pending.size(), SISPARAMSESSION_NOT_EXECUTED);
+	if (m_pending.empty()) return;
+
+	// Attributes and list headers are fetched before entering the parameterization level, so that nothing is left to
+	// be read in there. Errors are kept per parameter and reported per write.
+	std::map<UINT32, UINT32> attributes;
+	std::map<UINT32, USHORT> errors;
+	read_attributes(attributes, errors);
+
+	std::vector<SISProtocol::SercosRequest> requests;
+	std::vector<UINT64> targets;
+	build_listsizes(attributes, errors, requests, targets);
+	build_writes(attributes, errors, requests, targets);
+
+	// Requests that are not transceived keep this code
+	for (std::vector<SISProtocol::SercosRequest>::iterator it = requests.begin(); it != requests.end(); ++it)
+		it->Error = SISPARAMSESSION_NOT_EXECUTED;
+
+	if (m_paramlevel)
+		// Enter parameterization level 1 (S-0-0420) // Command C0400
+		// Cancellation is possible until here. Afterwards, the parameterization level has to be left regularly.
+		m_sis->execute_command(TGM::SercosParamS, 420, _ctx);
+
+	std::string failed;
+	int status = 0;
+	try
+	{
+		m_sis->transceive_sequential(requests);
+	}
+	catch (...)
+	{
+		// Results of the writes that have been transceived so far
+		collect_results(errors, requests, targets, failed, status);
+		m_pending.clear();
+
+		if (m_paramlevel)
+			// Leave parameterization level 1 (S-0-0422) // Command C0200
+			m_sis->execute_command(TGM::SercosParamS, 422);
+
+		throw;
+	}
+
+	collect_results(errors, requests, targets, failed, status);
+	m_pending.clear();
+
+	if (m_paramlevel)
+		// Leave parameterization level 1 (S-0-0422) // Command C0200
+		m_sis->execute_command(TGM::SercosParamS, 422);
+
+	// Collect all failed writes, so that the caller gets the complete picture at once
+	if (!failed.empty())
+		throw SISProtocol::ExceptionGeneric(status, sformat("Writing parameters failed: %s", failed.c_str()));
+}
+
+
+void SISParamSession::discard()
+{
+	STACK;
+
+	m_pending.clear();
+}
+
+
+void SISParamSession::collect_results(const std::map<UINT32, USHORT>& _errors, const std::vector<SISProtocol::SercosRequest>& _requests, const std::vector<UINT64>& _targets, std::string& _failed, int& _status)
+{
+	STACK;
+
+	// Results per write call ...
+	std::map<UINT64, USHORT> target_errors;
+	for (size_t i = 0; i < _requests.size(); i++)
+		target_errors[_targets[i]] = _requests[i].Error;
+
+	for (size_t i = 0; i < m_pending.size(); i++)
+	{
+		const PendingWrite& write = m_pending[i];
+		USHORT error = 0;
+
+		std::map<UINT32, USHORT>::const_iterator it_param = _errors.find(write.get_param_key());
+		if (it_param != _errors.end()) error = it_param->second;
+
+		if (!error && write.IsList) error = target_errors[LISTSIZE_TARGET(write.get_param_key())];
+		if (!error) error = target_errors[write.get_target_key()];
+
+		m_results[i] = error;
+		if (!error) continue;
+
+		_failed.append(sformat("%c-0-%04d (0x%04X) ", write.ParamVar == TGM::SercosParamS ? 'S' : 'P', write.ParamNum, error));
+		_status = error;
+	}
+}
+
+
+void SISParamSession::read_attributes(std::map<UINT32, UINT32>& _attributes, std::map<UINT32, USHORT>& _errors)
+{
+	STACK;
+
+	// One attribute request per parameter, regardless of how many writes refer to it
+	std::map<UINT32, const PendingWrite*> params;
+	for (std::vector<PendingWrite>::const_iterator it = m_pending.begin(); it != m_pending.end(); ++it)
+		params[it->get_param_key()] = &(*it);
+
+	std::vector<SISProtocol::SercosRequest> requests;
+	for (std::map<UINT32, const PendingWrite*>::iterator it = params.begin(); it != params.end(); ++it)
+		requests.push_back(SISProtocol::SercosRequest(SISProtocol::SIS_SERVICE_SERCOS_PARAM_READ, it->second->ParamVar, it->second->ParamNum, TGM::Datablock_Attribute, TGM::Data(), 4));
+
+	m_sis->transceive_sequential(requests);
+
+	for (std::vector<SISProtocol::SercosRequest>::iterator it = requests.begin(); it != requests.end(); ++it)
+	{
+		UINT32 key = ((UINT32)it->ParamVar << 16) | it->ParamNum;
+
+		if (it->Error)
+			_errors[key] = it->Error;
+		else
+			_attributes[key] = it->Data.toUINT32();
+	}
+}
+
+
+void SISParamSession::build_listsizes(const std::map<UINT32, UINT32>& _attributes, std::map<UINT32, USHORT>& _errors, std::vector<SISProtocol::SercosRequest>& _requests, std::vector<UINT64>& _targets)
+{
+	STACK;
+
+	// Highest list element to be written per list
+	std::map<UINT32, const PendingWrite*> lists;
+	for (std::vector<PendingWrite>::const_iterator it = m_pending.begin(); it != m_pending.end(); ++it)
+	{
+		if (!it->IsList || _errors.count(it->get_param_key())) continue;
+
+		std::map<UINT32, const PendingWrite*>::iterator it_list = lists.find(it->get_param_key());
+		if (it_list == lists.end() || it_list->second->ElmPos < it->ElmPos)
+			lists[it->get_param_key()] = &(*it);
+	}
+
+	if (lists.empty()) return;
+
+	// Getting list headers ...
+	std::vector<SISProtocol::SercosRequest> headers;
+	for (std::map<UINT32, const PendingWrite*>::iterator it = lists.begin(); it != lists.end(); ++it)
+		headers.push_back(SISProtocol::SercosRequest(SISProtocol::SIS_SERVICE_SERCOS_LIST_READ, it->second->ParamVar, it->second->ParamNum, TGM::Datablock_OperationData, TGM::Data(), 4, 0, 4));
+
+	m_sis->transceive_sequential(headers);
+
+	// Updating list headers, if needed. Same sizing as SISProtocol::set_parameter_listsize(), but once per list.
+	std::map<UINT32, const PendingWrite*>::iterator it_list = lists.begin();
+	for (size_t i = 0; i < headers.size(); i++, ++it_list)
+	{
+		if (headers[i].Error)
+		{
+			_errors[it_list->first] = headers[i].Error;
+			continue;
+		}
+
+		size_t datalen = 1;
+		UINT8 scalefactor = 0;
+		SISProtocol::get_attribute_format(_attributes.at(it_list->first), scalefactor, datalen);
+
+		UINT32 param_header = headers[i].Data.toUINT32();
+		// Maximum possible size of parameter list
+		UINT16 param_size_max = param_header >> 16;
+		// Actual size of parameter list
+		UINT16 param_size_cur = param_header & 0xFFFF;
+		// Required size of parameter list
+		UINT16 param_size_new = static_cast<UINT16>(it_list->second->ElmPos * datalen);
+
+		if (param_size_new == param_size_cur || param_size_new > param_size_max) continue;
+
+		_requests.push_back(SISProtocol::SercosRequest(SISProtocol::SIS_SERVICE_SERCOS_LIST_WRITE, it_list->second->ParamVar, it_list->second->ParamNum, TGM::Datablock_OperationData, TGM::Data((UINT32)((param_size_max << 16) | param_size_new)), 0, 0, 4));
+		_targets.push_back(LISTSIZE_TARGET(it_list->first));
+	}
+}
+
+
+void SISParamSession::build_writes(const std::map<UINT32, UINT32>& _attributes, const std::map<UINT32, USHORT>& _errors, std::vector<SISProtocol::SercosRequest>& _requests, std::vector<UINT64>& _targets)
+{
+	STACK;
+
+	// Coalescing: Last write to a target wins. The map orders the targets by parameter and list element.
+	std::map<UINT64, const PendingWrite*> writes;
+	for (std::vector<PendingWrite>::const_iterator it = m_pending.begin(); it != m_pending.end(); ++it)
+		writes[it->get_target_key()] = &(*it);
+
+	for (std::map<UINT64, const PendingWrite*>::iterator it = writes.begin(); it != writes.end(); ++it)
+	{
+		const PendingWrite& write = *it->second;
+		if (_errors.count(write.get_param_key())) continue;
+
+		UINT32 attribute = _attributes.at(write.get_param_key());
+
+		if (write.IsList)
+		{
+			size_t datalen = 1;
+			UINT8 scalefactor = 0;
+			SISProtocol::get_attribute_format(attribute, scalefactor, datalen);
+
+			_requests.push_back(SISProtocol::SercosRequest(SISProtocol::SIS_SERVICE_SERCOS_LIST_WRITE, write.ParamVar, write.ParamNum, TGM::Datablock_OperationData, encode(write, attribute), 0, static_cast<USHORT>(write.ElmPos * datalen), static_cast<USHORT>(datalen)));
+		}
+		else
+			_requests.push_back(SISProtocol::SercosRequest(SISProtocol::SIS_SERVICE_SERCOS_PARAM_WRITE, write.ParamVar, write.ParamNum, TGM::Datablock_OperationData, encode(write, attribute), 0));
+
+		_targets.push_back(it->first);
+	}
+}
+
+
+TGM::Data SISParamSession::encode(const PendingWrite& _write, const UINT32 _attribute)
+{
+	STACK;
+
+	SISScaling scaling(_attribute);
+
+	switch (_write.Format)
+	{
+	case WriteFormat_Integer:	return scaling.encode(_write.Integer);
+	case WriteFormat_Raw:		return scaling.encode_raw(_write.Integer);
+	default:					return scaling.encode(_write.Value);
+	}
+}
@@ -0,0 +1,136 @@
+/// @file
+/// Contains the parameterization session that applies several parameter writes at once.
+
+#ifndef _SISPARAMSESSION_H_
+#define _SISPARAMSESSION_H_
+
+#include <Windows.h>
+#include <vector>
+#include <map>
+
+#include "debug.h"
+#include "helpers.h"
+#include "SISProtocol.h"
+#include "SISCommand.h"
+
+
+/// Result of a write that has not been executed, since the commit has been aborted before its reaction.
+#define SISPARAMSESSION_NOT_EXECUTED	0xFFFF
+
+
+/// Parameterization session that gathers parameter and list element writes and applies them at once.
+///
+/// Writes are gathered by write_parameter() and write_listelm() and applied by commit(): Writes to the same target
+/// are coalesced (last write wins) and ordered by parameter and list element. The attributes of all parameters and
+/// the list headers are read in batched telegrams, the list sizes are adjusted once per list, and all writes are
+/// transmitted in batched telegrams (SIS service 0x04).
+///
+/// By default, the writes are applied within parameterization level 1 (communication phase 2), which is required for
+/// parameters such as S-0-0032: The level is entered once (S-0-0420, C0400) and left once (S-0-0422, C0200).
+///
+/// @code{.cpp}
+/// SISParamSession session(SISProtocol_ref);
+/// session.write_parameter(TGM::SercosParamS, 32, (UINT64)0b111011);
+/// session.write_parameter(TGM::SercosParamS, 44, (UINT64)0b10);
+/// session.commit();
+/// @endcode.
+///
+/// @sa	SISProtocol::transceive_sequential
+class SISParamSession
+{
+public:
+	/// Constructor.
+	///
+	/// @param [in]	_sis	  	SIS protocol reference the session is applied to.
+	/// @param	   	_paramlevel	(Optional) True to apply the writes within parameterization level 1.
+	SISParamSession(SISProtocol * _sis, bool _paramlevel = true);
+	/// Destructor. Pending writes that have not been committed are discarded.
+	virtual ~SISParamSession();
+
+	void write_parameter(TGM::SercosParamVar _paramvar, USHORT _paramnum, const UINT32 _data);
+	void write_parameter(TGM::SercosParamVar _paramvar, USHORT _paramnum, const UINT64 _data);
+	void write_parameter(TGM::SercosParamVar _paramvar, USHORT _paramnum, const DOUBLE _data);
+
+	/// Gathers a write of the operation data as is, without decimal places applied. Values are kept exactly, including
+	/// 64-bit values that exceed the precision of DOUBLE.
+	///
+	/// @param	_paramvar	SERCOS Parameter variant (S, or P).
+	/// @param	_paramnum	SERCOS Parameter number.
+	/// @param	_raw	 	Operation data. Truncated to the data length of the parameter.
+	void write_parameter_raw(TGM::SercosParamVar _paramvar, USHORT _paramnum, const UINT64 _raw);
+
+	void write_listelm(TGM::SercosParamVar _paramvar, USHORT _paramnum, USHORT _elm_pos, const DOUBLE _data);
+
+	void commit(SISCommand * _ctx = NULL);
+	void discard();
+
+	/// Gets the number of pending writes.
+	///
+	/// @return	The number of pending writes.
+	size_t get_pending() const { return m_pending.size(); }
+
+	/// Gets the results of the last commit, one per write in the order of the write calls. A result is the SIS error
+	/// code of the write, or 0 if succeeded. Coalesced writes report the result of the write that superseded them.
+	/// Writes that have not been executed, since the commit has been aborted, report SISPARAMSESSION_NOT_EXECUTED.
+	///
+	/// @return	The results.
+	const std::vector<USHORT>& get_results() const { return m_results; }
+
+private:
+	/// Values that represent the formats of the values of pending writes.
+	typedef enum WriteFormat
+	{
+		/// Value is written, scaled by the decimal places of the parameter.
+		WriteFormat_Double,
+		/// Integer is written, scaled by the decimal places of the parameter without rounding (see SISScaling::encode()).
+		WriteFormat_Integer,
+		/// Integer is written as operation data as is.
+		WriteFormat_Raw
+	} WriteFormat;
+
+	/// Pending write of a parameter or list element.
+	typedef struct PendingWrite
+	{
+		/// SERCOS Parameter variant (S, or P).
+		TGM::SercosParamVar ParamVar;
+		/// SERCOS Parameter number.
+		USHORT ParamNum;
+		/// True if a list element is written.
+		bool IsList;
+		/// Position of the list element (list only).
+		USHORT ElmPos;
+		/// Format of the value to be written.
+		WriteFormat Format;
+		/// Value to be written, not yet scaled (WriteFormat_Double only).
+		DOUBLE Value;
+		/// Integer to be written (WriteFormat_Integer and WriteFormat_Raw only).
+		UINT64 Integer;
+
+		/// Gets the key of the parameter. Keys are ordered by parameter variant and number.
+		///
+		/// @return	The parameter key.
+		UINT32 get_param_key() const { return ((UINT32)ParamVar << 16) | ParamNum; }
+
+		/// Gets the key of the write target. Keys are ordered by parameter, and list element.
+		///
+		/// @return	The target key.
+		UINT64 get_target_key() const { return ((UINT64)get_param_key() << 32) | ((UINT64)IsList << 16) | ElmPos; }
+	} PendingWrite;
+
+	void read_attributes(std::map<UINT32, UINT32>& _attributes, std::map<UINT32, USHORT>& _errors);
+	void build_listsizes(const std::map<UINT32, UINT32>& _attributes, std::map<UINT32, USHORT>& _errors, std::vector<SISProtocol::SercosRequest>& _requests, std::vector<UINT64>& _targets);
+	void build_writes(const std::map<UINT32, UINT32>& _attributes, const std::map<UINT32, USHORT>& _errors, std::vector<SISProtocol::SercosRequest>& _requests, std::vector<UINT64>& _targets);
+
+	void collect_results(const std::map<UINT32, USHORT>& _errors, const std::vector<SISProtocol::SercosRequest>& _requests, const std::vector<UINT64>& _targets, std::string& _failed, int& _status);
+
+	static TGM::Data encode(const PendingWrite& _write, const UINT32 _attribute);
+
+private:
+	SISProtocol * m_sis;
+	bool m_paramlevel;
+
+	std::vector<PendingWrite> m_pending;
+	std::vector<USHORT> m_results;
+};
+
+#endif /* _SISPARAMSESSION_H_ */
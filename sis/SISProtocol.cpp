@@ -2,8 +2,25 @@
 
 
 
-SISProtocol::SISProtocol()
+SISProtocol::SISProtocol() :
+	m_serial(new CSerial()),
+	m_sequential_unsupported(false),
+	m_diag_num(0),
+	m_diag_valid(false),
+	m_baudrate_open(19200),
+	m_baudrate_sis(Baud_19200),
+	m_reconnect(false),
+	m_connecting(false),
+	m_baudrate(CSerial::EBaud19200),
+	m_last_exchange(0)
 {
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	m_frequency = frequency.QuadPart;
+
+	m_traffic.reset(get_timestamp());
+
+	memset(&m_health, 0, sizeof(m_health));
 }
 
 
@@ -12,34 +29,246 @@ SISProtocol::~SISProtocol()
 }
 
 
-void SISProtocol::open(const wchar_t * _port)
+void SISProtocol::open(const wchar_t * _port, const UINT32 _baudrate)
 {
 	STACK;
 
-	LPCTSTR cport = (LPCTSTR)_port;
+	// Another device might be connected than in a previous session
+	invalidate_scaling();
+
+	// Traffic is accounted per session
+	{
+		std::lock_guard<std::mutex> lock(mutex_traffic);
+		m_traffic.reset(get_timestamp());
+	}
+
+	// Baud rates supported by SIS
+	switch (_baudrate)
+	{
+	case 9600:		m_baudrate_sis = Baud_9600; break;
+	case 19200:		m_baudrate_sis = Baud_19200; break;
+	case 38400:		m_baudrate_sis = Baud_38400; break;
+	case 57600:		m_baudrate_sis = Baud_57600; break;
+	case 115200:	m_baudrate_sis = Baud_115200; break;
+	default:
+		throw SISProtocol::ExceptionGeneric(-1, sformat("Baud rate %u is not supported. Use 9600, 19200, 38400, 57600, or 115200.", _baudrate));
+	}
+
+	// Kept for reconnecting
+	m_port = _port;
+	m_baudrate_open = _baudrate;
+
+	connect();
+
+	std::lock_guard<std::mutex> lock(mutex_health);
+	m_health.Connected = 1;
+}
+
+
+void SISProtocol::connect()
+{
+	STACK;
+
+	LPCTSTR cport = (LPCTSTR)m_port.c_str();
 	CSerial::EBaudrate cbaudrate	= CSerial::EBaud19200;
 	CSerial::EDataBits cdata		= CSerial::EData8;
 	CSerial::EParity cparity		= CSerial::EParNone;
 	CSerial::EStopBits cstopbits	= CSerial::EStop1;
 	CSerial::EHandshake chandshake	= CSerial::EHandshakeOff;
 
-	try
+	if (CTCPSerial::IsURL(m_port.c_str()))
+	{
+		// Serial-to-Ethernet gateway
+		CTCPSerial * gateway = new CTCPSerial();
+		m_serial.reset(gateway);
+		gateway->Connect(m_port.c_str());
+	}
+	else
 	{
 		CSerial::CheckPort(cport);
 
-		m_serial.Open(cport, RS232_BUFFER, RS232_BUFFER, true /* overlapped */);
-		m_serial.Setup(cbaudrate, cdata, cparity, cstopbits);
-		m_serial.SetupHandshaking(chandshake);
+		m_serial.reset(new CSerial());
+		m_serial->Open(cport, RS232_BUFFER, RS232_BUFFER, true /* overlapped */);
+	}
+
+	m_serial->Setup(cbaudrate, cdata, cparity, cstopbits);
+	m_serial->SetupHandshaking(chandshake);
 
-		m_serial.SetMask(CSerial::EEventBreak |
-			CSerial::EEventError |
-			CSerial::EEventRecv);
+	m_serial->SetMask(CSerial::EEventBreak |
+		CSerial::EEventError |
+		CSerial::EEventRecv);
 
-		m_serial.SetupReadTimeouts(CSerial::EReadTimeoutNonblocking);
+	m_serial->SetupReadTimeouts(CSerial::EReadTimeoutNonblocking);
+
+	// Negotiation is opted in by requesting another baud rate than the default of the device. Otherwise, the port is
+	// just opened, and the device is expected to run with 19200 Baud.
+	if (m_baudrate_open == 19200)
+	{
+		m_baudrate = CSerial::EBaud19200;
+		return;
 	}
-	catch (CSerial::ExceptionGeneric &ex)
+
+	// Failed exchanges of the negotiation must not trigger a reconnect
+	m_connecting = true;
+
+	// Device starts with 19200 Baud, but might still run with another baud rate from a previous session. Thus, the
+	// requested baud rate is negotiated with 19200 Baud first, then with the requested one, then with the others.
+	// Raw gateways run with the baud rate of their configuration, which has to match the requested one.
+	const UINT32 candidates[] = { 19200, m_baudrate_open, 115200, 57600, 38400, 9600 };
+	const CTCPSerial * gateway = dynamic_cast<const CTCPSerial*>(m_serial.get());
+	const bool fixed = gateway && !gateway->HasLineControl();
+	for (size_t i = 0; i < sizeof(candidates) / sizeof(candidates[0]); i++)
 	{
-		throw;
+		if (fixed && i != 1) continue;
+		if (!fixed && i > 0 && (candidates[i] == 19200 || (i > 1 && candidates[i] == m_baudrate_open))) continue;
+
+		m_serial->Setup(static_cast<CSerial::EBaudrate>(candidates[i]), cdata, cparity, cstopbits);
+		m_baudrate = candidates[i];
+
+		// Bytes received with the previous baud rate are garbage
+		m_serial->Purge();
+
+		try
+		{
+			set_baudrate(m_baudrate_sis);
+			m_connecting = false;
+			return;
+		}
+		catch (SISProtocol::ExceptionTransceiveFailed &)
+		{
+			// No (valid) reaction with this baud rate
+		}
+		catch (...)
+		{
+			m_connecting = false;
+			throw;
+		}
+	}
+
+	m_connecting = false;
+
+	throw SISProtocol::ExceptionTransceiveFailed(ERROR_TIMEOUT, "Device did not respond with any supported baud rate.", true);
+}
+
+
+bool SISProtocol::recover(const BYTE _service, const bool _timeout, std::unique_lock<SISLinkArbiter>& _lock)
+{
+	STACK;
+
+	// Called with the link held. Exchanges of the negotiation and of the recovery itself are not recovered.
+	if (!m_reconnect || m_connecting || m_recovery != std::thread::id()) return false;
+
+	m_recovery = std::this_thread::get_id();
+
+	// A single timeout might be a reaction that got lost. Thus, the link is probed before it is taken as lost.
+	if (_timeout)
+	{
+		try
+		{
+			// Diagnostic number (S-0-0390)
+			transceive_param
+				<TGM::Header, TGM::Commands::SercosParam, TGM::Header, TGM::Reactions::SercosParam>
+				(TGM::SercosParamS, 390, SIS_SERVICE_SERCOS_PARAM_READ);
+
+			// Link is up. The failure is reported as is.
+			m_recovery = std::thread::id();
+			return false;
+		}
+		catch (SISProtocol::ExceptionGeneric &)
+		{
+		}
+		catch (CSerial::ExceptionGeneric &)
+		{
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_health);
+		m_health.Connected = 0;
+		m_health.Losses++;
+		m_health.LastLoss = GetTickCount64();
+	}
+
+	const bool reconnected = reconnect(_lock);
+	m_recovery = std::thread::id();
+
+	if (!reconnected) return false;
+
+	// Link is up again, but the failure is reported if the exchange must not be sent twice
+	if (!is_idempotent(_service)) return false;
+
+	std::lock_guard<std::mutex> lock(mutex_health);
+	m_health.Replays++;
+
+	return true;
+}
+
+
+bool SISProtocol::reconnect(std::unique_lock<SISLinkArbiter>& _lock)
+{
+	STACK;
+
+	ULONGLONG start = GetTickCount64();
+
+	for (size_t attempt = 0; attempt < SIS_RECONNECT_ATTEMPTS && GetTickCount64() - start < SIS_RECONNECT_TIMEOUT; attempt++)
+	{
+		if (attempt > 0)
+		{
+			// Link is released meanwhile, so that exchanges of other threads fail instead of waiting
+			_lock.unlock();
+			Sleep(SIS_RECONNECT_INTERVAL);
+			_lock.lock();
+
+			// Closed on purpose meanwhile
+			if (!m_reconnect) return false;
+		}
+
+		try
+		{
+			if (m_serial->IsOpen()) m_serial->Close();
+
+			connect();
+		}
+		catch (SISProtocol::ExceptionGeneric &)
+		{
+			continue;
+		}
+		catch (CSerial::ExceptionGeneric &)
+		{
+			// Port not (yet) available, e.g. while the adapter is re-enumerated
+			continue;
+		}
+
+		// Device might have been restarted
+		invalidate_diagnostic();
+
+		std::lock_guard<std::mutex> lock(mutex_health);
+		m_health.Connected = 1;
+		m_health.Reconnects++;
+		m_health.LastRecovery = static_cast<uint32_t>(GetTickCount64() - start);
+
+		return true;
+	}
+
+	return false;
+}
+
+
+bool SISProtocol::is_idempotent(const BYTE _service)
+{
+	// Parameters are read, or written with absolute values. Commands are started by writing the command parameter,
+	// which is idempotent as well. Sequential operations consist of such services only.
+	switch (_service)
+	{
+	case SIS_SERVICE_SEQUENTIALOP:
+	case SIS_SERVICE_SERCOS_PARAM_READ:
+	case SIS_SERVICE_SERCOS_LIST_READ:
+	case SIS_SERVICE_SERCOS_READ_PHASE:
+	case SIS_SERVICE_SERCOS_LIST_WRITE:
+	case SIS_SERVICE_SERCOS_PARAM_WRITE:
+		return true;
+	default:
+		return false;
 	}
 }
 
@@ -48,9 +277,19 @@ void SISProtocol::close()
 {
 	STACK;
 
+	std::lock_guard<SISLinkArbiter> lock(mutex_sis);
+
+	// Closed on purpose. Thus, no reconnect.
+	m_reconnect = false;
+
+	{
+		std::lock_guard<std::mutex> lock_health(mutex_health);
+		m_health.Connected = 0;
+	}
+
 	try
 	{
-		m_serial.Close();
+		m_serial->Close();
 	}
 	catch (CSerial::ExceptionGeneric &ex)
 	{
@@ -80,8 +319,96 @@ void SISProtocol::set_baudrate(BAUDRATE baudrate)
 	// Set payload size
 	tx_tgm.Mapping.Header.set_DatL(tx_tgm.Mapping.Payload.get_size());
 
-	// Transceive ...
-	transceiving(tx_tgm, rx_tgm);
+	// Calculate Checksum
+	tx_tgm.Mapping.Header.calc_checksum(&tx_tgm.Raw);
+
+	// Transceive ... Reaction is sent with the previous baud rate, the new baud rate applies afterwards.
+	SISResult result = transceiving(tx_tgm, rx_tgm);
+	if (!result.ok()) throw_result(result);
+
+	UINT32 rate = CSerial::EBaud19200;
+	switch (baudrate)
+	{
+	case Baud_9600:		rate = CSerial::EBaud9600; break;
+	case Baud_19200:	rate = CSerial::EBaud19200; break;
+	case Baud_38400:	rate = CSerial::EBaud38400; break;
+	case Baud_57600:	rate = CSerial::EBaud57600; break;
+	case Baud_115200:	rate = CSerial::EBaud115200; break;
+	}
+
+	std::lock_guard<SISLinkArbiter> lock(mutex_sis);
+
+	m_serial->Setup(static_cast<CSerial::EBaudrate>(rate), CSerial::EData8, CSerial::EParNone, CSerial::EStop1);
+	m_baudrate = rate;
+
+	// Bytes received with the previous baud rate are garbage
+	m_serial->Purge();
+}
+
+
+void SISProtocol::set_reconnect(bool _enable)
+{
+	STACK;
+
+	std::lock_guard<SISLinkArbiter> lock(mutex_sis);
+
+	m_reconnect = _enable;
+}
+
+
+SISLinkHealth SISProtocol::get_link_health()
+{
+	STACK;
+
+	std::lock_guard<std::mutex> lock(mutex_health);
+
+	return m_health;
+}
+
+
+SISLinkStats SISProtocol::get_link_stats(bool _reset)
+{
+	STACK;
+
+	std::lock_guard<std::mutex> lock(mutex_traffic);
+
+	LONGLONG now = get_timestamp();
+	SISLinkStats stats = m_traffic.get(now, m_frequency, m_baudrate);
+
+	if (_reset) m_traffic.reset(now);
+
+	return stats;
+}
+
+
+ULONGLONG SISProtocol::get_idle_time()
+{
+	STACK;
+
+	std::lock_guard<std::mutex> lock(mutex_timing);
+
+	return GetTickCount64() - m_last_exchange;
+}
+
+
+SISLinkTiming SISProtocol::get_link_timing(bool _reset)
+{
+	STACK;
+
+	std::lock_guard<std::mutex> lock(mutex_timing);
+
+	SISLinkTiming timing;
+	timing.Baudrate = m_baudrate;
+	timing.ToFirstByte = m_timing_firstbyte.get();
+	timing.ToAck = m_timing_ack.get();
+
+	if (_reset)
+	{
+		m_timing_firstbyte.reset();
+		m_timing_ack.reset();
+	}
+
+	return timing;
 }
 
 
@@ -89,19 +416,31 @@ void SISProtocol::read_parameter(TGM::SercosParamVar _paramvar, USHORT _paramnum
 {
 	STACK;
 
+	SISResult result = read_parameter_result(_paramvar, _paramnum, _rcvddata);
+	if (!result.ok()) throw_result(result);
+}
+
+
+SISResult SISProtocol::read_parameter_result(TGM::SercosParamVar _paramvar, USHORT _paramnum, UINT32 & _rcvddata)
+{
+	STACK;
+
 	// Fetching attributes for length and scale ...
-	size_t datalen = 1;
-	UINT8 scalefactor = 0;
-	get_parameter_attributes(_paramvar, _paramnum, scalefactor, datalen);
+	SISScaling scaling;
+	SISResult result = try_get_scaling(_paramvar, _paramnum, scaling);
+	if (!result.ok()) return result;
 
 	// Communication with Telegrams ...
-	auto rx_tgm = transceive_param
+	TGM::Map<TGM::Header, TGM::Reactions::SercosParam> rx_tgm;
+	result = try_transceive_param
 		<TGM::Header, TGM::Commands::SercosParam, TGM::Header, TGM::Reactions::SercosParam>
-		(_paramvar, _paramnum, SIS_SERVICE_SERCOS_PARAM_READ);
+		(rx_tgm, _paramvar, _paramnum, SIS_SERVICE_SERCOS_PARAM_READ);
+	if (!result.ok()) return result;
 
 	// Convert responsed Bytes ...
-	INT64 response = get_sized_data(rx_tgm.Mapping.Payload.Bytes, datalen);
-	_rcvddata = static_cast<UINT32>(response);
+	_rcvddata = static_cast<UINT32>(scaling.decode_raw(rx_tgm.Mapping.Payload.Bytes.Bytes));
+
+	return result;
 }
 
 
@@ -109,19 +448,31 @@ void SISProtocol::read_parameter(TGM::SercosParamVar _paramvar, USHORT _paramnum
 {
 	STACK;
 
+	SISResult result = read_parameter_result(_paramvar, _paramnum, _rcvddata);
+	if (!result.ok()) throw_result(result);
+}
+
+
+SISResult SISProtocol::read_parameter_result(TGM::SercosParamVar _paramvar, USHORT _paramnum, UINT64& _rcvddata)
+{
+	STACK;
+
 	// Fetching attributes for length and scale ...
-	size_t datalen = 1;
-	UINT8 scalefactor = 0;
-	get_parameter_attributes(_paramvar, _paramnum, scalefactor, datalen);
+	SISScaling scaling;
+	SISResult result = try_get_scaling(_paramvar, _paramnum, scaling);
+	if (!result.ok()) return result;
 
 	// Communication with Telegrams ...
-	auto rx_tgm = transceive_param
+	TGM::Map<TGM::Header, TGM::Reactions::SercosParam> rx_tgm;
+	result = try_transceive_param
 		<TGM::Header, TGM::Commands::SercosParam, TGM::Header, TGM::Reactions::SercosParam>
-		(_paramvar, _paramnum, SIS_SERVICE_SERCOS_PARAM_READ);
+		(rx_tgm, _paramvar, _paramnum, SIS_SERVICE_SERCOS_PARAM_READ);
+	if (!result.ok()) return result;
 
 	// Convert responsed Bytes ...
-	INT64 response = get_sized_data(rx_tgm.Mapping.Payload.Bytes, datalen);
-	_rcvddata = static_cast<UINT64>(response);
+	_rcvddata = static_cast<UINT64>(scaling.decode_raw(rx_tgm.Mapping.Payload.Bytes.Bytes));
+
+	return result;
 }
 
 
@@ -129,19 +480,31 @@ void SISProtocol::read_parameter(TGM::SercosParamVar _paramvar, USHORT _paramnum
 {
 	STACK;
 
+	SISResult result = read_parameter_result(_paramvar, _paramnum, _rcvddata);
+	if (!result.ok()) throw_result(result);
+}
+
+
+SISResult SISProtocol::read_parameter_result(TGM::SercosParamVar _paramvar, USHORT _paramnum, DOUBLE & _rcvddata)
+{
+	STACK;
+
 	// Fetching attributes for length and scale ...
-	size_t datalen = 1;
-	UINT8 scalefactor = 0;
-	get_parameter_attributes(_paramvar, _paramnum, scalefactor, datalen);
+	SISScaling scaling;
+	SISResult result = try_get_scaling(_paramvar, _paramnum, scaling);
+	if (!result.ok()) return result;
 
 	// Communication with Telegrams ...
-	auto rx_tgm = transceive_param
-					<TGM::Header, TGM::Commands::SercosParam, TGM::Header, TGM::Reactions::SercosParam>
-					(_paramvar, _paramnum, SIS_SERVICE_SERCOS_PARAM_READ);
+	TGM::Map<TGM::Header, TGM::Reactions::SercosParam> rx_tgm;
+	result = try_transceive_param
+		<TGM::Header, TGM::Commands::SercosParam, TGM::Header, TGM::Reactions::SercosParam>
+		(rx_tgm, _paramvar, _paramnum, SIS_SERVICE_SERCOS_PARAM_READ);
+	if (!result.ok()) return result;
 
 	// Convert responsed Bytes ...
-	INT64 response = get_sized_data(rx_tgm.Mapping.Payload.Bytes, datalen);
-	_rcvddata = (double)response / std::pow(10, scalefactor);
+	_rcvddata = scaling.decode(rx_tgm.Mapping.Payload.Bytes.Bytes);
+
+	return result;
 }
 
 
@@ -163,12 +526,10 @@ void SISProtocol::read_listelm(TGM::SercosParamVar _paramvar, USHORT _paramnum,
 	STACK;
 
 	// Fetching attributes for length and scale ...
-	size_t datalen = 1;
-	UINT8 scalefactor = 0;
-	get_parameter_attributes(_paramvar, _paramnum, scalefactor, datalen);
+	SISScaling scaling = get_scaling(_paramvar, _paramnum);
 
 	// Communication with Telegrams ...
-	USHORT SegmentSize = (USHORT)datalen;
+	USHORT SegmentSize = (USHORT)scaling.get_datalen();
 	USHORT ListOffset = _elm_pos * SegmentSize;
 
 	auto rx_tgm = transceive_list
@@ -176,8 +537,7 @@ void SISProtocol::read_listelm(TGM::SercosParamVar _paramvar, USHORT _paramnum,
 		(_paramvar, _paramnum, SIS_SERVICE_SERCOS_LIST_READ, SegmentSize, ListOffset);
 
 	// Response Bytes ...
-	INT64 response = get_sized_data(rx_tgm.Mapping.Payload.Bytes, datalen);
-	_rcvdelm = static_cast<UINT32>(response);
+	_rcvdelm = static_cast<UINT32>(scaling.decode_raw(rx_tgm.Mapping.Payload.Bytes.Bytes));
 }
 
 
@@ -186,12 +546,10 @@ void SISProtocol::read_listelm(TGM::SercosParamVar _paramvar, USHORT _paramnum,
 	STACK;
 
 	// Fetching attributes for length and scale ...
-	size_t datalen = 1;
-	UINT8 scalefactor = 0;
-	get_parameter_attributes(_paramvar, _paramnum, scalefactor, datalen);
+	SISScaling scaling = get_scaling(_paramvar, _paramnum);
 
 	// Communication with Telegrams ...
-	USHORT SegmentSize = (USHORT)datalen;
+	USHORT SegmentSize = (USHORT)scaling.get_datalen();
 	USHORT ListOffset = _elm_pos * SegmentSize;
 
 	auto rx_tgm = transceive_list
@@ -199,8 +557,7 @@ void SISProtocol::read_listelm(TGM::SercosParamVar _paramvar, USHORT _paramnum,
 		(_paramvar, _paramnum, SIS_SERVICE_SERCOS_LIST_READ, SegmentSize, ListOffset);
 
 	// Response Bytes ...
-	INT64 response = get_sized_data(rx_tgm.Mapping.Payload.Bytes, datalen);
-	_rcvdelm = static_cast<UINT64>(response);
+	_rcvdelm = static_cast<UINT64>(scaling.decode_raw(rx_tgm.Mapping.Payload.Bytes.Bytes));
 }
 
 
@@ -209,50 +566,65 @@ void SISProtocol::read_listelm(TGM::SercosParamVar _paramvar, USHORT _paramnum,
 	STACK;
 
 	// Fetching attributes for length and scale ...
-	size_t datalen = 1;
-	UINT8 scalefactor = 0;
-	get_parameter_attributes(_paramvar, _paramnum, scalefactor, datalen);
-		
+	SISScaling scaling = get_scaling(_paramvar, _paramnum);
+
 	// Communication with Telegrams ...
-	USHORT SegmentSize = (USHORT)datalen;
+	USHORT SegmentSize = (USHORT)scaling.get_datalen();
 	USHORT ListOffset = _elm_pos * SegmentSize;
 
 	auto rx_tgm = transceive_list
-					<TGM::Header, TGM::Commands::SercosList, TGM::Header, TGM::Reactions::SercosList>
-					(_paramvar, _paramnum, SIS_SERVICE_SERCOS_LIST_READ, SegmentSize, ListOffset);
+		<TGM::Header, TGM::Commands::SercosList, TGM::Header, TGM::Reactions::SercosList>
+		(_paramvar, _paramnum, SIS_SERVICE_SERCOS_LIST_READ, SegmentSize, ListOffset);
 
 	// Response Bytes ...
-	INT64 response = get_sized_data(rx_tgm.Mapping.Payload.Bytes, datalen);
-	_rcvdelm = (double)response / std::pow(10, scalefactor);
+	_rcvdelm = scaling.decode(rx_tgm.Mapping.Payload.Bytes.Bytes);
 }
 
 
-INT64 SISProtocol::get_sized_data(TGM::Data& rx_data, const size_t &datalen)
+void SISProtocol::read_diagnostic(UINT32& _diagnum, std::string& _diagmsg)
 {
 	STACK;
 
-	if (datalen == 1)
-	{
-		UINT8 Bytes = rx_data.toUINT8();
-		UINT64 mask = ((Bytes >> 7) & 1) ? 0xFFFFFFFFFFFFFF00 : 0;
-		return (INT64)(Bytes | mask);
-	}
-	else if (datalen == 2)
-	{
-		UINT16 Bytes = rx_data.toUINT16();
-		UINT64 mask = ((Bytes >> 15) & 1) ? 0xFFFFFFFFFFFF0000 : 0;
-		return (INT64)(Bytes | mask);
-	}
-	else if (datalen == 8) 
-	{
-		return (INT64)rx_data.toUINT64();
-	}		
-	else
+	_diagnum = read_diagnostic_num();
+
+	std::lock_guard<std::mutex> lock(mutex_diag);
+
+	// Diagnostic message (S-0-0095) is re-read only if the diagnostic number has changed
+	if (!m_diag_valid || m_diag_num != _diagnum)
 	{
-		UINT32 Bytes = rx_data.toUINT32();
-		UINT64 mask = ((Bytes >> 31) & 1) ? 0xFFFFFFFF00000000 : 0;
-		return (INT64)(Bytes | mask);
+		char msg[TGM_SIZEMAX_PAYLOAD + 1] = { 0 };
+		read_parameter(TGM::SercosParamS, 95, msg);
+
+		// Skipping list header (actual and maximum length)
+		m_diag_msg = std::string(msg + 4);
+		m_diag_num = _diagnum;
+		m_diag_valid = true;
 	}
+
+	_diagmsg = m_diag_msg;
+}
+
+
+UINT32 SISProtocol::read_diagnostic_num()
+{
+	STACK;
+
+	// Diagnostic number (S-0-0390) is a 4-byte value without decimal places. Thus, attributes are not fetched.
+	auto rx_tgm = transceive_param
+		<TGM::Header, TGM::Commands::SercosParam, TGM::Header, TGM::Reactions::SercosParam>
+		(TGM::SercosParamS, 390, SIS_SERVICE_SERCOS_PARAM_READ);
+
+	return rx_tgm.Mapping.Payload.Bytes.toUINT32();
+}
+
+
+void SISProtocol::invalidate_diagnostic()
+{
+	STACK;
+
+	std::lock_guard<std::mutex> lock(mutex_diag);
+
+	m_diag_valid = false;
 }
 
 
@@ -260,7 +632,34 @@ void SISProtocol::write_parameter(TGM::SercosParamVar _paramvar, USHORT _paramnu
 {
 	STACK;
 
-	write_parameter(_paramvar, _paramnum, static_cast<DOUBLE>(_data));
+	SISResult result = write_parameter_result(_paramvar, _paramnum, _data);
+	if (!result.ok()) throw_result(result);
+}
+
+
+SISResult SISProtocol::write_parameter_result(TGM::SercosParamVar _paramvar, USHORT _paramnum, const UINT32 _data)
+{
+	STACK;
+
+	// Fetching attributes for length and scale ...
+	SISScaling scaling;
+	SISResult result = try_get_scaling(_paramvar, _paramnum, scaling);
+	if (!result.ok()) return result;
+
+	// Preprocess Bytes ...
+	TGM::Data Bytes = scaling.encode(static_cast<UINT64>(_data));
+
+	// Communication with Telegrams ...
+	TGM::Map<TGM::Header, TGM::Reactions::SercosParam> rx_tgm;
+	result = try_transceive_param
+		<TGM::Header, TGM::Commands::SercosParam, TGM::Header, TGM::Reactions::SercosParam>
+		(rx_tgm, _paramvar, _paramnum, SIS_SERVICE_SERCOS_PARAM_WRITE, &Bytes);
+	if (!result.ok()) return result;
+
+	// Attributes of other parameters depend on scaling parameters
+	if (is_scaling_param(_paramvar, _paramnum)) invalidate_scaling();
+
+	return result;
 }
 
 
@@ -268,7 +667,34 @@ void SISProtocol::write_parameter(TGM::SercosParamVar _paramvar, USHORT _paramnu
 {
 	STACK;
 
-	write_parameter(_paramvar, _paramnum, static_cast<DOUBLE>(_data));
+	SISResult result = write_parameter_result(_paramvar, _paramnum, _data);
+	if (!result.ok()) throw_result(result);
+}
+
+
+SISResult SISProtocol::write_parameter_result(TGM::SercosParamVar _paramvar, USHORT _paramnum, const UINT64 _data)
+{
+	STACK;
+
+	// Fetching attributes for length and scale ...
+	SISScaling scaling;
+	SISResult result = try_get_scaling(_paramvar, _paramnum, scaling);
+	if (!result.ok()) return result;
+
+	// Preprocess Bytes ...
+	TGM::Data Bytes = scaling.encode(_data);
+
+	// Communication with Telegrams ...
+	TGM::Map<TGM::Header, TGM::Reactions::SercosParam> rx_tgm;
+	result = try_transceive_param
+		<TGM::Header, TGM::Commands::SercosParam, TGM::Header, TGM::Reactions::SercosParam>
+		(rx_tgm, _paramvar, _paramnum, SIS_SERVICE_SERCOS_PARAM_WRITE, &Bytes);
+	if (!result.ok()) return result;
+
+	// Attributes of other parameters depend on scaling parameters
+	if (is_scaling_param(_paramvar, _paramnum)) invalidate_scaling();
+
+	return result;
 }
 
 
@@ -276,116 +702,524 @@ void SISProtocol::write_parameter(TGM::SercosParamVar _paramvar, USHORT _paramnu
 {
 	STACK;
 
+	SISResult result = write_parameter_result(_paramvar, _paramnum, _data);
+	if (!result.ok()) throw_result(result);
+}
+
+
+SISResult SISProtocol::write_parameter_result(TGM::SercosParamVar _paramvar, USHORT _paramnum, const DOUBLE _data)
+{
+	STACK;
+
 	// Fetching attributes for length and scale ...
-	size_t datalen = 1;
-	UINT8 scalefactor = 0;
-	get_parameter_attributes(_paramvar, _paramnum, scalefactor, datalen);
+	SISScaling scaling;
+	SISResult result = try_get_scaling(_paramvar, _paramnum, scaling);
+	if (!result.ok()) return result;
 
 	// Preprocess Bytes ...
-	UINT64 inval = static_cast<UINT64>(_data * std::pow(10, scalefactor));
+	TGM::Data Bytes = scaling.encode(_data);
+
+	// Communication with Telegrams ...
+	TGM::Map<TGM::Header, TGM::Reactions::SercosParam> rx_tgm;
+	result = try_transceive_param
+		<TGM::Header, TGM::Commands::SercosParam, TGM::Header, TGM::Reactions::SercosParam>
+		(rx_tgm, _paramvar, _paramnum, SIS_SERVICE_SERCOS_PARAM_WRITE, &Bytes);
+	if (!result.ok()) return result;
+
+	// Attributes of other parameters depend on scaling parameters
+	if (is_scaling_param(_paramvar, _paramnum)) invalidate_scaling();
+
+	return result;
+}
+
+
+void SISProtocol::write_listelm(TGM::SercosParamVar _paramvar, USHORT _paramnum, USHORT _elm_pos, const UINT32 _rcvdelm, const bool _retain)
+{
+	STACK;
+
+	// Fetching attributes for length and scale ...
+	SISScaling scaling = get_scaling(_paramvar, _paramnum);
+	size_t datalen = scaling.get_datalen();
+
+	// Re-adjusting list size, if needed. Elements behind are cut off, unless retained.
+	set_parameter_listsize(_paramvar, _paramnum, datalen, _elm_pos, _retain);
+
+	TGM::Data Bytes = scaling.encode(static_cast<UINT64>(_rcvdelm));
+
+	// Communication with Telegrams ...
+	USHORT SegmentSize	= (USHORT)datalen;
+	USHORT ListOffset	= _elm_pos * SegmentSize;
+
+	transceive_list
+		<TGM::Header, TGM::Commands::SercosList, TGM::Header, TGM::Reactions::SercosList>
+		(_paramvar, _paramnum, SIS_SERVICE_SERCOS_LIST_WRITE, SegmentSize, ListOffset, &Bytes);
+}
+
+
+void SISProtocol::write_listelm(TGM::SercosParamVar _paramvar, USHORT _paramnum, USHORT _elm_pos, const UINT64 _rcvdelm, const bool _retain)
+{
+	STACK;
+
+	// Fetching attributes for length and scale ...
+	SISScaling scaling = get_scaling(_paramvar, _paramnum);
+	size_t datalen = scaling.get_datalen();
+
+	// Re-adjusting list size, if needed. Elements behind are cut off, unless retained.
+	set_parameter_listsize(_paramvar, _paramnum, datalen, _elm_pos, _retain);
+
+	TGM::Data Bytes = scaling.encode(_rcvdelm);
+
+	// Communication with Telegrams ...
+	USHORT SegmentSize	= (USHORT)datalen;
+	USHORT ListOffset	= _elm_pos * SegmentSize;
+
+	transceive_list
+		<TGM::Header, TGM::Commands::SercosList, TGM::Header, TGM::Reactions::SercosList>
+		(_paramvar, _paramnum, SIS_SERVICE_SERCOS_LIST_WRITE, SegmentSize, ListOffset, &Bytes);
+}
+
+
+void SISProtocol::write_listelm(TGM::SercosParamVar _paramvar, USHORT _paramnum, USHORT _elm_pos, const DOUBLE _rcvdelm, const bool _retain)
+{
+	STACK;
+
+	// Fetching attributes for length and scale ...
+	SISScaling scaling = get_scaling(_paramvar, _paramnum);
+	size_t datalen = scaling.get_datalen();
+
+	// Re-adjusting list size, if needed. Elements behind are cut off, unless retained.
+	set_parameter_listsize(_paramvar, _paramnum, datalen, _elm_pos, _retain);
+
+	TGM::Data Bytes = scaling.encode(_rcvdelm);
 
 	// Communication with Telegrams ...
+	USHORT SegmentSize	= (USHORT)datalen;
+	USHORT ListOffset	= _elm_pos * SegmentSize;
+
+	transceive_list
+		<TGM::Header, TGM::Commands::SercosList, TGM::Header, TGM::Reactions::SercosList>
+		(_paramvar, _paramnum, SIS_SERVICE_SERCOS_LIST_WRITE, SegmentSize, ListOffset, &Bytes);
+}
+
+
+void SISProtocol::execute_command(TGM::SercosParamVar _paramvar, USHORT _paramnum, SISCommand * _ctx)
+{
+	STACK;
+
+	TGM::SercosCommandrequest cmd;
+	TGM::SercosCommandstatus Status = TGM::Commandstatus_Busy;
+	bool canceled = false;
+	ULONGLONG start;
+
+	// Do not start the command at all, if cancellation has been requested in the meantime
+	if (_ctx && _ctx->is_cancel_requested())
+		throw ExceptionGeneric(TGM::Commandstatus_Canceled, "Command execution has been canceled before start.");
+
+	// Start command ...
+	cmd = TGM::Commandrequest_Set;
+	try
+	{
+		write_parameter(_paramvar, _paramnum, static_cast<UINT64>(cmd));
+	}
+	catch (SISProtocol::ExceptionSISError &ex)
+	{
+		if (ex.get_errorcode() == 0x700C)
+			throw SISProtocol::ExceptionGeneric(-1, "Command cannot be executed, because it is write-protected. Release the drive torque (disable drive), or restart the Indradrive system.");
+		else
+			throw;
+	}
+	
+	start = GetTickCount64();
+	while (true)
+	{
+		// Interrupt the running command, if cancellation has been requested
+		if (_ctx && _ctx->is_cancel_requested() && !canceled)
+		{
+			cmd = TGM::Commandrequest_Cancel;
+			write_parameter(_paramvar, _paramnum, static_cast<UINT64>(cmd));
+			canceled = true;
+		}
+
+		get_parameter_status(_paramvar, _paramnum, Status);
+		if (Status != TGM::Commandstatus_Busy) break;
+
+		if (GetTickCount64() - start > SIS_COMMAND_TIMEOUT) throw ExceptionGeneric(-1, "Command execution caused a continuous busy loop. Please restart the Indradrive system.");
+		Sleep(SIS_COMMAND_POLL_INTERVAL);
+	}
+
+	if (Status != TGM::Commandstatus_OK && !canceled)
+		throw ExceptionGeneric(static_cast<int>(Status), sformat("Command execution failed with status code %d. Command executation canceled or not possible due to released operation state of the drive.", Status));
+
+	
+	// Delete command ...
+	cmd = TGM::Commandrequest_NotSet;
+	write_parameter(_paramvar, _paramnum, static_cast<UINT64>(cmd));
+	
+	wait_command_status(_paramvar, _paramnum, Status);
+
+	if (Status != TGM::Commandstatus_NotSet)
+		throw ExceptionGeneric(static_cast<int>(Status), sformat("Command execution failed with status code %d. Command executation canceled or not possible due to released operation state of the drive.", Status));
+
+	if (canceled)
+		throw ExceptionGeneric(TGM::Commandstatus_Canceled, "Command execution has been canceled.");
+}
+
+
+SISCommand * SISProtocol::execute_command_async(TGM::SercosParamVar _paramvar, USHORT _paramnum)
+{
+	STACK;
+
+	return new SISCommand([this, _paramvar, _paramnum](SISCommand& _cmd)
+	{
+		execute_command(_paramvar, _paramnum, &_cmd);
+	});
+}
+
+
+void SISProtocol::wait_command_status(const TGM::SercosParamVar _paramvar, const USHORT & _paramnum, TGM::SercosCommandstatus& _datastatus)
+{
+	STACK;
+
+	ULONGLONG start = GetTickCount64();
+	while (true)
+	{
+		get_parameter_status(_paramvar, _paramnum, _datastatus);
+		if (_datastatus != TGM::Commandstatus_Busy) break;
+
+		if (GetTickCount64() - start > SIS_COMMAND_TIMEOUT) throw ExceptionGeneric(-1, "Command execution caused a continuous busy loop. Please restart the Indradrive system.");
+		Sleep(SIS_COMMAND_POLL_INTERVAL);
+	}
+}
+
+
+void SISProtocol::transceive_sequential(std::vector<SercosRequest>& _requests)
+{
+	STACK;
+
+	// Attributes of other parameters depend on scaling parameters
+	bool scaling = false;
+	for (size_t i = 0; i < _requests.size(); i++)
+		scaling |= _requests[i].Service == SIS_SERVICE_SERCOS_PARAM_WRITE && is_scaling_param(_requests[i].ParamVar, _requests[i].ParamNum);
+
+	size_t first = 0;
+	while (first < _requests.size())
+	{
+		// Gather as many requests as fit into both the command and the reaction telegram
+		size_t last = first;
+		size_t tx_len = 0;
+		size_t rx_len = 1; // Overall status byte
+		while (last < _requests.size())
+		{
+			size_t tx_add = 1 + _requests[last].get_request_size();
+			size_t rx_add = 1 + _requests[last].get_reaction_size();
+
+			if (tx_len + tx_add > TGM_SIZEMAX_PAYLOAD || rx_len + rx_add > TGM_SIZEMAX_PAYLOAD) break;
+
+			tx_len += tx_add;
+			rx_len += rx_add;
+			last++;
+		}
+
+		// Single requests are not worth the overhead of a sequential telegram (or do not fit into one at all)
+		if (last - first < 2 || m_sequential_unsupported || !transceive_sequential_chunk(_requests, first, last))
+		{
+			transceive_single(_requests[first]);
+			first++;
+			continue;
+		}
+
+		first = last;
+	}
+
+	if (scaling) invalidate_scaling();
+}
+
+
+void SISProtocol::read_parameters_data(const TGM::SercosParamVar _paramvars[], const USHORT _paramnums[], std::vector<SISScaling>& _scalings, std::vector<SercosRequest>& _reads, std::vector<size_t>& _indices, USHORT _errors[], const size_t _len)
+{
+	STACK;
+
+	// Attributes are read only for parameters whose scaling is not known yet
+	_scalings.assign(_len, SISScaling());
+	std::vector<SercosRequest> attributes;
+	std::vector<size_t> pending;
+	{
+		std::lock_guard<std::mutex> lock(mutex_scaling);
+
+		for (size_t i = 0; i < _len; i++)
+		{
+			_errors[i] = 0;
+
+			auto it = m_scaling.find(((UINT32)_paramvars[i] << 16) | _paramnums[i]);
+			if (it != m_scaling.end())
+			{
+				_scalings[i] = it->second;
+				continue;
+			}
+
+			attributes.push_back(SercosRequest(SIS_SERVICE_SERCOS_PARAM_READ, _paramvars[i], _paramnums[i], TGM::Datablock_Attribute, TGM::Data(), 4));
+			pending.push_back(i);
+		}
+	}
+
+	transceive_sequential(attributes);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_scaling);
+
+		for (size_t k = 0; k < pending.size(); k++)
+		{
+			size_t i = pending[k];
+
+			_errors[i] = attributes[k].Error;
+			if (_errors[i]) continue;
+
+			_scalings[i] = SISScaling(attributes[k].Data.toUINT32());
+			m_scaling[((UINT32)_paramvars[i] << 16) | _paramnums[i]] = _scalings[i];
+		}
+	}
+
+	// Values are requested with their actual length, so that as many as possible fit into a telegram
+	_reads.clear();
+	_indices.clear();
+	for (size_t i = 0; i < _len; i++)
+	{
+		if (_errors[i]) continue;
+
+		_reads.push_back(SercosRequest(SIS_SERVICE_SERCOS_PARAM_READ, _paramvars[i], _paramnums[i], TGM::Datablock_OperationData, TGM::Data(), static_cast<USHORT>(_scalings[i].get_datalen())));
+		_indices.push_back(i);
+	}
+
+	transceive_sequential(_reads);
+}
+
+
+void SISProtocol::read_parameters(const TGM::SercosParamVar _paramvars[], const USHORT _paramnums[], DOUBLE _values[], USHORT _errors[], const size_t _len)
+{
+	STACK;
+
+	std::vector<SISScaling> scalings;
+	std::vector<SercosRequest> reads;
+	std::vector<size_t> indices;
+	for (size_t i = 0; i < _len; i++) _values[i] = 0;
+
+	read_parameters_data(_paramvars, _paramnums, scalings, reads, indices, _errors, _len);
+
+	for (size_t k = 0; k < reads.size(); k++)
+	{
+		size_t i = indices[k];
+
+		_errors[i] = reads[k].Error;
+		if (_errors[i]) continue;
+
+		_values[i] = scalings[i].decode(reads[k].Data.Bytes);
+	}
+}
+
+
+void SISProtocol::read_parameters(const TGM::SercosParamVar _paramvars[], const USHORT _paramnums[], UINT64 _values[], USHORT _errors[], const size_t _len)
+{
+	STACK;
+
+	std::vector<SISScaling> scalings;
+	std::vector<SercosRequest> reads;
+	std::vector<size_t> indices;
+	for (size_t i = 0; i < _len; i++) _values[i] = 0;
+
+	read_parameters_data(_paramvars, _paramnums, scalings, reads, indices, _errors, _len);
+
+	for (size_t k = 0; k < reads.size(); k++)
+	{
+		size_t i = indices[k];
+
+		_errors[i] = reads[k].Error;
+		if (_errors[i]) continue;
+
+		_values[i] = scalings[i].decode_unsigned(reads[k].Data.Bytes);
+	}
+}
+
+
+void SISProtocol::read_list(TGM::SercosParamVar _paramvar, USHORT _paramnum, std::vector<BYTE>& _data, const size_t _maxlen)
+{
+	STACK;
+
+	// Preempted by other exchanges at each telegram
+	SISPriorityScope priority(SISPriority_Bulk);
+
+	// List header: Actual length (bits 15...0) and maximum length (bits 31...16) in bytes
+	std::vector<SercosRequest> header(1, SercosRequest(SIS_SERVICE_SERCOS_LIST_READ, _paramvar, _paramnum, TGM::Datablock_OperationData, TGM::Data(), 4, 0, 4));
+	transceive_sequential(header);
+
+	if (header[0].Error)
+		throw ExceptionGeneric(header[0].Error, sformat("Reading the list header of %c-0-%04u failed (0x%04X).", _paramvar == TGM::SercosParamS ? 'S' : 'P', _paramnum, header[0].Error));
+
+	// List offsets are 16 bits wide, and include the list header
+	size_t len = std::min<size_t>(header[0].Data.toUINT32() & 0xFFFF, std::min<size_t>(_maxlen, 0xFFFF - 4));
+
+	// One segment per telegram
+	std::vector<SercosRequest> segments;
+	for (size_t offset = 0; offset < len; offset += SIS_LIST_SEGMENT_SIZE)
+	{
+		USHORT size = static_cast<USHORT>(std::min<size_t>(SIS_LIST_SEGMENT_SIZE, len - offset));
+		segments.push_back(SercosRequest(SIS_SERVICE_SERCOS_LIST_READ, _paramvar, _paramnum, TGM::Datablock_OperationData, TGM::Data(), size, static_cast<USHORT>(4 + offset), size));
+	}
+
+	transceive_sequential(segments);
+
+	_data.assign(len, 0);
+	for (size_t k = 0; k < segments.size(); k++)
+	{
+		if (segments[k].Error)
+			throw ExceptionGeneric(segments[k].Error, sformat("Reading %c-0-%04u at offset %u failed (0x%04X).", _paramvar == TGM::SercosParamS ? 'S' : 'P', _paramnum, segments[k].ListOffset, segments[k].Error));
+
+		memcpy(&_data[segments[k].ListOffset - 4], segments[k].Data.Bytes, std::min<size_t>(segments[k].SegmentSize, segments[k].Data.Size));
+	}
+}
+
+
+bool SISProtocol::transceive_sequential_chunk(std::vector<SercosRequest>& _requests, const size_t _first, const size_t _last)
+{
+	STACK;
+
+	// Build Telegrams ...
 	TGM::Data Bytes;
-	set_sized_data(Bytes, datalen, inval);
+	for (size_t i = _first; i < _last; i++)
+	{
+		SercosRequest& req = _requests[i];
+
+		TGM::Bitfields::SercosParamControl	ParamControl(req.Datablock);
+		TGM::Bitfields::SercosParamIdent	ParamIdent(req.ParamVar, req.ParamNum);
+
+		// Length of the single request: Service, payload head, and data
+		Bytes << (BYTE)req.get_request_size();
+		Bytes << req.Service;
+
+		// Payload head of the single request. Mapping structs are packed, thus the head is taken over as is.
+		if (req.is_list())
+		{
+			TGM::Commands::SercosList head(ParamControl, SIS_ADDR_SLAVE, ParamIdent, req.ListOffset, req.SegmentSize);
+			for (size_t b = 0; b < head.get_head_size(); b++) Bytes << ((BYTE*)&head)[b];
+		}
+		else
+		{
+			TGM::Commands::SercosParam head(ParamControl, SIS_ADDR_SLAVE, ParamIdent);
+			for (size_t b = 0; b < head.get_head_size(); b++) Bytes << ((BYTE*)&head)[b];
+		}
+
+		// Payload data of the single request
+		for (size_t b = 0; b < req.Data.Size; b++) Bytes << req.Data.Bytes[b];
+	}
 
-	transceive_param
-		<TGM::Header, TGM::Commands::SercosParam, TGM::Header, TGM::Reactions::SercosParam>
-		(_paramvar, _paramnum, SIS_SERVICE_SERCOS_PARAM_WRITE, &Bytes);
-}
+	// Mapping for SEND Telegram
+	TGM::Map<TGM::Header, TGM::Commands::Sequential>
+		tx_tgm(
+			// Init header
+			TGM::Header(SIS_ADDR_MASTER, SIS_ADDR_SLAVE, SIS_SERVICE_SEQUENTIALOP, TGM::Bitfields::HeaderControl(TGM::TypeCommand)),
+			// Init payload
+			TGM::Commands::Sequential(Bytes)
+		);
 
+	// Set payload size
+	tx_tgm.Mapping.Header.set_DatL(tx_tgm.Mapping.Payload.get_size());
 
-void SISProtocol::write_listelm(TGM::SercosParamVar _paramvar, USHORT _paramnum, USHORT _elm_pos, const UINT32 _rcvdelm)
-{
-	STACK;
+	// Calculate Checksum
+	tx_tgm.Mapping.Header.calc_checksum(&tx_tgm.Raw);
 
-	DOUBLE buf = static_cast<DOUBLE>(_rcvdelm);
-	write_listelm(_paramvar, _paramnum, _elm_pos, buf);
-}
+	if (!check_boundaries(tx_tgm))
+		throw SISProtocol::ExceptionGeneric(-1, "Boundaries are out of spec. Telegram is not ready to be sent.");
 
+	// Mapping for RECEPTION Telegram
+	TGM::Map<TGM::Header, TGM::Reactions::Sequential> rx_tgm;
 
-void SISProtocol::write_listelm(TGM::SercosParamVar _paramvar, USHORT _paramnum, USHORT _elm_pos, const UINT64 _rcvdelm)
-{
-	STACK;
+	//  Transceive ...
+	SISResult result = transceiving(tx_tgm, rx_tgm);
+	if (!result.ok()) throw_result(result);
+
+	// Split up reactions: [k][service][status][control][unit address][data or error code] ...
+	// The reaction is validated completely first, so that the requests are left untouched for a fallback.
+	TGM::Data& rx_data = rx_tgm.Mapping.Payload.Bytes;
+	std::vector<size_t> positions;
+	size_t pos = 0;
+	for (size_t i = _first; i < _last; i++)
+	{
+		size_t len = (pos < rx_data.Size) ? rx_data.Bytes[pos] : 0;
 
-	DOUBLE buf = static_cast<DOUBLE>(_rcvdelm);
-	write_listelm(_paramvar, _paramnum, _elm_pos, buf);
-}
+		// Malformed reaction: Device does not process sequential telegrams. Falling back to single requests.
+		if (len < 4 || pos + 1 + len > rx_data.Size || rx_data.Bytes[pos + 1] != _requests[i].Service)
+		{
+			m_sequential_unsupported = true;
+			return false;
+		}
 
+		positions.push_back(pos);
+		pos += 1 + len;
+	}
 
-void SISProtocol::write_listelm(TGM::SercosParamVar _paramvar, USHORT _paramnum, USHORT _elm_pos, const DOUBLE _rcvdelm)
-{
-	STACK;
+	for (size_t i = _first; i < _last; i++)
+	{
+		SercosRequest& req = _requests[i];
 
-	// Fetching attributes for length and scale ...
-	size_t datalen		= 0;
-	UINT8 scalefactor	= 0;
-	get_parameter_attributes(_paramvar, _paramnum, scalefactor, datalen);
+		pos = positions[i - _first];
+		BYTE status = rx_data.Bytes[pos + 2];
+		const BYTE * data = rx_data.Bytes + pos + 5;
+		size_t datalen = rx_data.Bytes[pos] - 4;
 
-	UINT64 inval = static_cast<UINT64>(_rcvdelm * std::pow(10, scalefactor));
+		// Request and reaction, each with its length byte
+		account_param(TGM::Bitfields::SercosParamIdent(req.ParamVar, req.ParamNum).Value, 1 + req.get_request_size(), 1 + rx_data.Bytes[pos]);
 
-	// Re-adjusting list size, if needed
-	set_parameter_listsize(_paramvar, _paramnum, datalen, _elm_pos);
-	
-	TGM::Data Bytes;
-	set_sized_data(Bytes, datalen, inval);
+		// On error, the request data is left untouched, so that the request can be repeated
+		req.Error = 0;
+		if (status)
+			req.Error = (datalen >= 2) ? (USHORT)(data[0] | (data[1] << 8)) : (USHORT)0xFFFF;
+		else
+		{
+			req.Data.clear();
+			for (size_t b = 0; b < datalen; b++) req.Data << data[b];
+		}
+	}
 
-	// Communication with Telegrams ...
-	USHORT SegmentSize	= (USHORT)datalen;
-	USHORT ListOffset	= _elm_pos * SegmentSize;
+	// Busy device: Repeat the affected requests one by one (like transceiving() does for single requests)
+	for (size_t i = _first; i < _last; i++)
+	{
+		USHORT error = _requests[i].Error;
+		if (error == 0x800C || error == 0x800B || error == 0x8001)
+			transceive_single(_requests[i]);
+	}
 
-	transceive_list
-		<TGM::Header, TGM::Commands::SercosList, TGM::Header, TGM::Reactions::SercosList>
-		(_paramvar, _paramnum, SIS_SERVICE_SERCOS_LIST_WRITE, SegmentSize, ListOffset, &Bytes);
+	return true;
 }
 
 
-void SISProtocol::execute_command(TGM::SercosParamVar _paramvar, USHORT _paramnum)
+void SISProtocol::transceive_single(SercosRequest& _request)
 {
-	TGM::SercosCommandrequest cmd;
-	TGM::SercosCommandstatus Status = TGM::Commandstatus_Busy;
-	int iterations;
+	STACK;
 
-	// Start command ...
-	cmd = TGM::Commandrequest_Set;
 	try
 	{
-		write_parameter(_paramvar, _paramnum, static_cast<UINT64>(cmd));
-	}
-	catch (SISProtocol::ExceptionSISError &ex)
-	{
-		if (ex.get_errorcode() == 0x700C)
-			throw SISProtocol::ExceptionGeneric(-1, "Command cannot be executed, because it is write-protected. Release the drive torque (disable drive), or restart the Indradrive system.");
-		else
-			throw;
-	}
-	
-	iterations = 0;
-	do
-	{
-		get_parameter_status(_paramvar, _paramnum, Status);
+		if (_request.is_list())
+		{
+			auto rx_tgm = transceive_list
+				<TGM::Header, TGM::Commands::SercosList, TGM::Header, TGM::Reactions::SercosList>
+				(_request.ParamVar, _request.ParamNum, _request.Service, _request.SegmentSize, _request.ListOffset, &_request.Data, _request.Datablock);
 
-		if (iterations > MAX_COMMANDCHECK_ITERATIONS) throw ExceptionGeneric(-1, "Command execution caused a continuous busy loop. Please restart the Indradrive system.");
-	} while (Status == TGM::Commandstatus_Busy);
+			_request.Data = rx_tgm.Mapping.Payload.Bytes;
+		}
+		else
+		{
+			auto rx_tgm = transceive_param
+				<TGM::Header, TGM::Commands::SercosParam, TGM::Header, TGM::Reactions::SercosParam>
+				(_request.ParamVar, _request.ParamNum, _request.Service, &_request.Data, _request.Datablock);
 
-	if (Status != TGM::Commandstatus_OK)
-		throw ExceptionGeneric(static_cast<int>(Status), sformat("Command execution failed with status code %d. Command executation canceled or not possible due to released operation state of the drive.", Status));
+			_request.Data = rx_tgm.Mapping.Payload.Bytes;
+		}
 
-	
-	// Delete command ...
-	cmd = TGM::Commandrequest_NotSet;
-	write_parameter(_paramvar, _paramnum, static_cast<UINT64>(cmd));
-	
-	Status = TGM::Commandstatus_Busy;
-	iterations = 0;
-	do
+		_request.Error = 0;
+	}
+	catch (SISProtocol::ExceptionSISError &ex)
 	{
-		get_parameter_status(_paramvar, _paramnum, Status);
-
-		if (iterations > MAX_COMMANDCHECK_ITERATIONS) throw ExceptionGeneric(-1, "Command execution caused a continuous busy loop. Please restart the Indradrive system.");
-	} while (Status == TGM::Commandstatus_Busy);
-
-	if (Status != TGM::Commandstatus_NotSet)
-		throw ExceptionGeneric(static_cast<int>(Status), sformat("Command execution failed with status code %d. Command executation canceled or not possible due to released operation state of the drive.", Status));
+		_request.Error = static_cast<USHORT>(ex.get_errorcode());
+	}
 }
 
 
@@ -405,20 +1239,20 @@ void SISProtocol::get_parameter_status(const TGM::SercosParamVar _paramvar, cons
 }
 
 
-void SISProtocol::set_sized_data(TGM::Data& tx_data, const size_t &datalen, UINT64 & _rcvdelm)
+template <class TCHeader, class TCPayload, class TRHeader, class TRPayload>
+TGM::Map<TRHeader, TRPayload> SISProtocol::transceive_param(TGM::SercosParamVar _paramvar, const USHORT &_paramnum, BYTE _service, TGM::Data const * const _data, TGM::SercosDatablock _attribute)
 {
-	STACK; 
+	TGM::Map<TRHeader, TRPayload> rx_tgm;
 
-	if (datalen == 1) tx_data = TGM::Data((UINT8)_rcvdelm);
-	else if (datalen == 2) tx_data = TGM::Data((UINT16)_rcvdelm);
-	else if (datalen == 4) tx_data = TGM::Data((UINT32)_rcvdelm);
-	else if (datalen == 8) tx_data = TGM::Data((UINT64)_rcvdelm);
-	else tx_data = TGM::Data((UINT8&)_rcvdelm);
+	SISResult result = try_transceive_param<TCHeader, TCPayload, TRHeader, TRPayload>(rx_tgm, _paramvar, _paramnum, _service, _data, _attribute);
+	if (!result.ok()) throw_result(result);
+
+	return rx_tgm;
 }
 
 
 template <class TCHeader, class TCPayload, class TRHeader, class TRPayload>
-TGM::Map<TRHeader, TRPayload> SISProtocol::transceive_param(TGM::SercosParamVar _paramvar, const USHORT &_paramnum, BYTE _service, TGM::Data const * const _data, TGM::SercosDatablock _attribute)
+SISResult SISProtocol::try_transceive_param(TGM::Map<TRHeader, TRPayload>& _rx_tgm, TGM::SercosParamVar _paramvar, const USHORT &_paramnum, BYTE _service, TGM::Data const * const _data, TGM::SercosDatablock _attribute)
 {
 	// Build Telegrams ...
 	TGM::Bitfields::SercosParamControl	ParamControl(_attribute);
@@ -440,18 +1274,20 @@ TGM::Map<TRHeader, TRPayload> SISProtocol::transceive_param(TGM::SercosParamVar
 	tx_tgm.Mapping.Header.calc_checksum(&tx_tgm.Raw);
 
 	if (!check_boundaries(tx_tgm))
-		throw SISProtocol::ExceptionGeneric(-1, "Boundaries are out of spec. Telegram is not ready to be sent.");
-	
-	// Mapping for RECEPTION Telegram
-	TGM::Map<TRHeader, TRPayload> rx_tgm;
+		return SISResult(SISResult_Generic, -1, "Boundaries are out of spec. Telegram is not ready to be sent.");
 	
 	//  Transceive ...
 	// Send and receive
-	transceiving<	TCHeader, TCPayload,
+	SISResult result = transceiving<	TCHeader, TCPayload,
 		TRHeader, TRPayload >
-		(tx_tgm, rx_tgm);
+		(tx_tgm, _rx_tgm);
+	if (!result.ok()) return result;
 
-	return rx_tgm;
+	account_param(ParamIdent.Value,
+		tx_tgm.Mapping.Header.get_size() + tx_tgm.Mapping.Payload.get_size(),
+		_rx_tgm.Mapping.Header.get_size() + _rx_tgm.Mapping.Header.DatL);
+
+	return result;
 }
 
 
@@ -517,28 +1353,98 @@ TGM::Map<TRHeader, TRPayload> SISProtocol::transceive_list(TGM::SercosParamVar _
 	
 	//  Transceive ...
 	// Send and receive
-	transceiving<	TCHeader, TCPayload,
+	SISResult result = transceiving<	TCHeader, TCPayload,
 		TRHeader, TRPayload >
 		(tx_tgm, rx_tgm);
+	if (!result.ok()) throw_result(result);
+
+	account_param(ParamNum.Value,
+		tx_tgm.Mapping.Header.get_size() + tx_tgm.Mapping.Payload.get_size(),
+		rx_tgm.Mapping.Header.get_size() + rx_tgm.Mapping.Header.DatL);
 
 	return rx_tgm;
 }
 
 
-void SISProtocol::get_parameter_attributes(TGM::SercosParamVar _paramvar, const USHORT &_paramnum, UINT8& _scalefactor, size_t& _datalen)
+void SISProtocol::invalidate_scaling()
+{
+	STACK;
+
+	std::lock_guard<std::mutex> lock(mutex_scaling);
+
+	m_scaling.clear();
+}
+
+
+bool SISProtocol::is_scaling_param(const TGM::SercosParamVar _paramvar, const USHORT _paramnum)
+{
+	if (_paramvar != TGM::SercosParamS) return false;
+
+	switch (_paramnum)
+	{
+	case 44: case 45: case 46:				// Velocity data scaling type, factor, exponent
+	case 76: case 77: case 78: case 79:		// Position data scaling type, factor, exponent, rotational resolution
+	case 86: case 93: case 94:				// Torque/force data scaling type, factor, exponent
+	case 160: case 161: case 162:			// Acceleration data scaling type, factor, exponent
+		return true;
+	default:
+		return false;
+	}
+}
+
+
+SISScaling SISProtocol::get_scaling(TGM::SercosParamVar _paramvar, const USHORT &_paramnum)
+{
+	STACK;
+
+	SISScaling scaling;
+	SISResult result = try_get_scaling(_paramvar, _paramnum, scaling);
+	if (!result.ok()) throw_result(result);
+
+	return scaling;
+}
+
+
+SISResult SISProtocol::try_get_scaling(TGM::SercosParamVar _paramvar, const USHORT &_paramnum, SISScaling& _scaling)
 {
 	STACK;
 
+	UINT32 key = ((UINT32)_paramvar << 16) | _paramnum;
+	{
+		std::lock_guard<std::mutex> lock(mutex_scaling);
+
+		auto it = m_scaling.find(key);
+		if (it != m_scaling.end())
+		{
+			_scaling = it->second;
+			return SISResult();
+		}
+	}
+
 	// Communication with Telegrams ...
 	BYTE service = SIS_SERVICE_SERCOS_PARAM_READ;
 
-	auto rx_tgm = transceive_param
+	TGM::Map<TGM::Header, TGM::Reactions::SercosParam> rx_tgm;
+	SISResult result = try_transceive_param
 					<TGM::Header, TGM::Commands::SercosParam, TGM::Header, TGM::Reactions::SercosParam>
-					(_paramvar, _paramnum, service, new TGM::Data(), TGM::Datablock_Attribute);
+					(rx_tgm, _paramvar, _paramnum, service, new TGM::Data(), TGM::Datablock_Attribute);
+	if (!result.ok()) return result;
 
 	// Read back Datablock ...
-	UINT32 attr = rx_tgm.Mapping.Payload.Bytes.toUINT32();
-	TGM::Bitfields::SercosParamAttribute sercos_attribute(attr);
+	_scaling = SISScaling(rx_tgm.Mapping.Payload.Bytes.toUINT32());
+
+	std::lock_guard<std::mutex> lock(mutex_scaling);
+	m_scaling[key] = _scaling;
+
+	return result;
+}
+
+
+void SISProtocol::get_attribute_format(const UINT32 _attribute, UINT8& _scalefactor, size_t& _datalen)
+{
+	STACK;
+
+	TGM::Bitfields::SercosParamAttribute sercos_attribute(_attribute);
 
 	_datalen = 1;
 	if (sercos_attribute.Bits.DataLen == TGM::Datalen_2ByteList) _datalen = 2;
@@ -553,12 +1459,63 @@ void SISProtocol::get_parameter_attributes(TGM::SercosParamVar _paramvar, const
 
 
 template <class TCHeader, class TCPayload, class TRHeader, class TRPayload>
-void SISProtocol::transceiving(TGM::Map<TCHeader, TCPayload>& tx_tgm, TGM::Map<TRHeader, TRPayload>& rx_tgm)
+SISResult SISProtocol::transceiving(TGM::Map<TCHeader, TCPayload>& tx_tgm, TGM::Map<TRHeader, TRPayload>& rx_tgm, LONGLONG _t_request)
+{
+	STACK;
+
+	// Time of request. Retries and replays keep the time of the initial request.
+	const bool retry = (_t_request != 0);
+	if (!retry) _t_request = get_timestamp();
+
+	std::unique_lock<SISLinkArbiter> lock(mutex_sis);
+
+	// Link is released between the attempts of a reconnect, but not available to other threads until restored
+	if (m_recovery != std::thread::id() && m_recovery != std::this_thread::get_id())
+		return SISResult(SISResult_Transceive, ERROR_BUSY, "Link is being recovered. Transceive has been aborted.");
+
+	SISResult result;
+	try
+	{
+		result = exchange(tx_tgm, rx_tgm, _t_request, retry);
+
+		// SIS errors are complete reactions of a working link
+		if (result.get_kind() != SISResult_Transceive) return result;
+
+		drain();
+
+		// Incomplete reactions are not caused by a lost link
+		if (result.get_status() == -1 || !recover(tx_tgm.Mapping.Header.Service, result.get_status() == ERROR_TIMEOUT, lock)) return result;
+	}
+	catch (CSerial::ExceptionGeneric &)
+	{
+		drain();
+
+		if (!recover(tx_tgm.Mapping.Header.Service, false, lock)) throw;
+	}
+
+	// Replay once on the restored link
+	try
+	{
+		result = exchange(tx_tgm, rx_tgm, _t_request, true);
+	}
+	catch (CSerial::ExceptionGeneric &)
+	{
+		drain();
+		throw;
+	}
+
+	if (result.get_kind() == SISResult_Transceive) drain();
+
+	return result;
+}
+
+
+template <class TCHeader, class TCPayload, class TRHeader, class TRPayload>
+SISResult SISProtocol::exchange(TGM::Map<TCHeader, TCPayload>& tx_tgm, TGM::Map<TRHeader, TRPayload>& rx_tgm, LONGLONG _t_request, bool _retry)
 {
 	STACK;
 
-	// Lock mutex to set the semaphore, so that the SIS access be reentrant
-	mutex_sis.lock();
+	// Called with the link held by transceiving()
 
 	// Transceiver lengths
 	size_t tx_payload_len = tx_tgm.Mapping.Payload.get_size();
@@ -567,12 +1524,20 @@ void SISProtocol::transceiving(TGM::Map<TCHeader, TCPayload>& tx_tgm, TGM::Map<T
 	// Receiver lengths
 	size_t rx_header_len = tx_tgm.Mapping.Header.get_size();
 	size_t rx_payload_len = 0;
-	
-	// Clear buffers
-	m_serial.Purge();	
 
-	// Write ...
-	m_serial.Write(tx_tgm.Raw.Bytes, tx_header_len + tx_payload_len);
+	if (!_retry)
+	{
+		std::lock_guard<std::mutex> lock_timing(mutex_timing);
+		m_timing_firstbyte.record(static_cast<double>(get_timestamp() - _t_request) * 1e6 / m_frequency);
+	}
+
+	// Write ... Buffers are not purged, since failed exchanges are drained. Stale bytes are discarded by the parser.
+	m_serial->Write(tx_tgm.Raw.Bytes, tx_header_len + tx_payload_len);
+
+	{
+		std::lock_guard<std::mutex> lock_traffic(mutex_traffic);
+		m_traffic.record_tx(tx_tgm.Mapping.Header.Service, SISLinkArbiter::get_priority(), tx_header_len + tx_payload_len, m_baudrate);
+	}
 	
 	// Read ...
 	bool bContd = true;
@@ -582,24 +1547,25 @@ void SISProtocol::transceiving(TGM::Map<TCHeader, TCPayload>& tx_tgm, TGM::Map<T
 	do
 	{
 		// Wait for an event
-		m_serial.WaitEvent(0, RS232_READ_TIMEOUT);
+		if (m_serial->WaitEvent(0, RS232_READ_TIMEOUT) == ERROR_TIMEOUT)
+			return SISResult(SISResult_Transceive, ERROR_TIMEOUT, sformat("No reaction received within %d ms. Transceive has been aborted.", RS232_READ_TIMEOUT));
 
 		// Save event
-		const CSerial::EEvent event = m_serial.GetEventType();
+		const CSerial::EEvent event = m_serial->GetEventType();
 
 		// Handle Break event
 		if (event & CSerial::EEventBreak)
-			throw SISProtocol::ExceptionTransceiveFailed(CSerial::EEventBreak, "Break event occurred. Transceive has been aborted.", true);
+			return SISResult(SISResult_Transceive, CSerial::EEventBreak, "Break event occurred. Transceive has been aborted.");
 
 		// Handle error event
 		if (event & CSerial::EEventError)
-			throw_rs232_error_events(m_serial.GetError());
+			return get_rs232_error(m_serial->GetError());
 
 		// Handle Bytes receive event
 		if (event & CSerial::EEventRecv)
 		{
-			// Read header Bytes
-			m_serial.Read(rx_tgm.Raw.Bytes + rcvd_rcnt, RS232_BUFFER - rcvd_rcnt, &rcvd_cur, 0, RS232_READ_TIMEOUT);
+			// Read Bytes
+			m_serial->Read(rx_tgm.Raw.Bytes + rcvd_rcnt, RS232_BUFFER - rcvd_rcnt, &rcvd_cur, 0, RS232_READ_TIMEOUT);
 
 			// Loop back if nothing received
 			if (rcvd_cur == 0) continue;
@@ -607,49 +1573,194 @@ void SISProtocol::transceiving(TGM::Map<TCHeader, TCPayload>& tx_tgm, TGM::Map<T
 			// Hold back number of already received bytes
 			rcvd_rcnt += rcvd_cur;
 
-			// It is assumed that if the number of received bytes is bigger than 4,
-			// which is the position of the payload length, the length can be read out.
-			if (rcvd_rcnt > 4)
+			// Loop back until the reaction to this command has been received completely
+			const size_t rx_len = frame_reaction(tx_tgm.Raw.Bytes, rx_tgm.Raw.Bytes, rcvd_rcnt);
+			if (rx_len == 0) continue;
+
+			rx_payload_len = rx_len - rx_header_len;
+
+			// Length of payload is shorter than the payload head --> No payload received
+			if (rx_payload_len < rx_tgm.Mapping.Payload.get_head_size())
+			{
+				std::string tx_hexstream = hexprint_bytestream(tx_tgm.Raw.Bytes, tx_header_len + tx_payload_len);
+				std::string rx_hexstream = hexprint_bytestream(rx_tgm.Raw.Bytes, rx_len);
+				return SISResult(SISResult_Transceive, -1, sformat("Reception Telegram received without payload, but just the header.\nRecption Header bytestream: %s.\nCommand Telegram bytestream was: %s.", rx_hexstream.c_str(), tx_hexstream.c_str()));
+			}
+
+			rx_tgm.Mapping.Payload.Bytes.set_size(rx_payload_len - rx_tgm.Mapping.Payload.get_head_size());
+
+			// Complete Telegram received
 			{
-				rx_payload_len = rx_tgm.Mapping.Header.DatL;
-				rx_tgm.Mapping.Payload.Bytes.set_size(rx_payload_len - rx_tgm.Mapping.Payload.get_head_size());
+				std::lock_guard<std::mutex> lock_traffic(mutex_traffic);
+				m_traffic.record_rx(tx_tgm.Mapping.Header.Service, SISLinkArbiter::get_priority(), rx_len, m_baudrate);
 			}
 
-			// Length of payload is zero --> No payload received
-			if (rx_payload_len == 0)
+			if (rx_tgm.Mapping.Payload.has_error())
 			{
-				std::string tx_hexstream = hexprint_bytestream(tx_tgm.Raw.Bytes, tx_header_len + tx_payload_len);
-				std::string rx_hexstream = hexprint_bytestream(rx_tgm.Raw.Bytes, rx_header_len);
-				throw SISProtocol::ExceptionTransceiveFailed(-1, sformat("Reception Telegram received without payload, but just the header.\nRecption Header bytestream: %s.\nCommand Telegram bytestream was: %s.", rx_hexstream.c_str(), tx_hexstream.c_str()), true);
+				USHORT error = rx_tgm.Mapping.Payload.Error;
+
+				if (error == 0x800C || error == 0x800B || error == 0x8001)
+					return transceiving<TCHeader, TCPayload, TRHeader, TRPayload>(tx_tgm, rx_tgm, _t_request);
+				else
+					return SISResult(SISResult_SISError, rx_tgm.Mapping.Payload.Status, std::string(), rx_tgm.Mapping.Payload.Error, tx_tgm.Raw.Bytes, tx_header_len + tx_payload_len);
 			}
 				
+			bContd = false;
+		}
+		
+	} while (bContd);
 
-			// Complete Telegram received
-			if (rx_header_len + rx_payload_len <= rcvd_rcnt)
+	std::lock_guard<std::mutex> lock_timing(mutex_timing);
+	m_timing_ack.record(static_cast<double>(get_timestamp() - _t_request) * 1e6 / m_frequency);
+	m_last_exchange = GetTickCount64();
+
+	return SISResult();
+}
+
+
+void SISProtocol::account_param(const USHORT _ident, const size_t _txbytes, const size_t _rxbytes)
+{
+	std::lock_guard<std::mutex> lock(mutex_traffic);
+
+	m_traffic.record_param(_ident, _txbytes, _rxbytes, m_baudrate);
+}
+
+
+void SISProtocol::drain()
+{
+	STACK;
+
+	// Called with the link held
+	if (!m_serial || !m_serial->IsOpen()) return;
+
+	try
+	{
+		m_serial->Purge();
+
+		// Late reactions might still be on their way
+		BYTE buffer[RS232_BUFFER];
+		DWORD drained = 0;
+		const ULONGLONG start = GetTickCount64();
+		while (GetTickCount64() - start < RS232_READ_TIMEOUT)
+		{
+			if (m_serial->WaitEvent(0, RS232_DRAIN_QUIET) == ERROR_TIMEOUT) break;
+			if (!(m_serial->GetEventType() & CSerial::EEventRecv)) continue;
+
+			DWORD rcvd = 0;
+			m_serial->Read(buffer, sizeof(buffer), &rcvd, 0, RS232_DRAIN_QUIET);
+			drained += rcvd;
+		}
+
+		if (drained)
+		{
+			std::lock_guard<std::mutex> lock(mutex_health);
+			m_health.Discarded++;
+		}
+	}
+	catch (CSerial::ExceptionGeneric &)
+	{
+		// Port is lost. Nothing left to be drained.
+	}
+}
+
+
+size_t SISProtocol::frame_reaction(const BYTE * _tx, BYTE * _rx, DWORD& _len)
+{
+	const TGM::Header& tx = *reinterpret_cast<const TGM::Header*>(_tx);
+
+	while (_len > 0)
+	{
+		size_t drop = 1;
+
+		// Synchronize to the start symbol
+		if (_rx[0] == tx.StZ)
+		{
+			if (_len < TGM_SIZE_HEADER) return 0;
+
+			const TGM::Header& rx = *reinterpret_cast<const TGM::Header*>(_rx);
+			const size_t len = TGM_SIZE_HEADER + rx.DatL;
+
+			TGM::Bitfields::HeaderControl cntrl;
+			cntrl.Value = rx.Cntrl;
+
+			// Header of a reaction telegram, i.e. duplicated length and telegram type. Otherwise, the start symbol
+			// was part of another telegram.
+			if (rx.DatL == rx.DatLW && rx.DatL <= TGM_SIZEMAX_PAYLOAD && cntrl.Bits.Type == TGM::TypeReaction)
 			{
-				if (rx_tgm.Mapping.Payload.Status)
+				if (_len < len) return 0;
+
+				// Sum of all bytes including the checksum is zero
+				BYTE sum = 0;
+				for (size_t i = 0; i < len; i++) sum += _rx[i];
+
+				if (sum == 0)
 				{
-					std::string tx_hexstream = hexprint_bytestream(tx_tgm.Raw.Bytes, tx_header_len + tx_payload_len);
-					
-					USHORT error = rx_tgm.Mapping.Payload.Error;
-
-					if (error == 0x800C || error == 0x800B || error == 0x8001)
-					{
-						mutex_sis.unlock();
-						transceiving<TCHeader, TCPayload, TRHeader, TRPayload>(tx_tgm, rx_tgm);
-					}
-					else
-						throw SISProtocol::ExceptionSISError(rx_tgm.Mapping.Payload.Status, rx_tgm.Mapping.Payload.Error, tx_hexstream);
+					if (correlates(tx, _rx, len)) return len;
+
+					// Intact telegram, but a late reaction to another command
+					drop = len;
 				}
-					
-				bContd = false;
 			}
 		}
-		
-	} while (bContd);
 
-	// Unlock mutex to unset the semaphore
-	mutex_sis.unlock();
+		if (drop > 1)
+		{
+			std::lock_guard<std::mutex> lock(mutex_health);
+			m_health.Discarded++;
+		}
+
+		_len -= static_cast<DWORD>(drop);
+		memmove(_rx, _rx + drop, _len);
+	}
+
+	return 0;
+}
+
+
+bool SISProtocol::correlates(const TGM::Header& _tx, const BYTE * _rx, const size_t _len)
+{
+	const TGM::Header& rx = *reinterpret_cast<const TGM::Header*>(_rx);
+
+	// Same service, and addresses swapped. Slaves that are addressed peer-to-peer react with their own address.
+	if (rx.Service != _tx.Service || rx.AdrE != _tx.AdrS) return false;
+	if (_tx.AdrE != SIS_ADDR_PEER && rx.AdrS != _tx.AdrE) return false;
+
+	switch (_tx.Service)
+	{
+	case SIS_SERVICE_SERCOS_PARAM_READ:
+	case SIS_SERVICE_SERCOS_LIST_READ:
+	case SIS_SERVICE_SERCOS_PARAM_WRITE:
+	case SIS_SERVICE_SERCOS_LIST_WRITE:
+	{
+		// Reaction does not echo the parameter ident, but the control byte and the unit address. Head of the command:
+		// Control, UnitAddr, ... Head of the reaction: Status, Control, UnitAddr. Error reactions might not echo the
+		// datablock.
+		if (_len < TGM_SIZE_HEADER + 3) return false;
+
+		const BYTE * tx_head = reinterpret_cast<const BYTE*>(&_tx) + TGM_SIZE_HEADER;
+		const BYTE * rx_head = _rx + TGM_SIZE_HEADER;
+
+		if (rx_head[2] != tx_head[1]) return false;
+
+		TGM::Bitfields::SercosParamControl tx_control(tx_head[0]);
+		TGM::Bitfields::SercosParamControl rx_control(rx_head[1]);
+		if (rx_head[0] == 0 && rx_control.Bits.Datablock != tx_control.Bits.Datablock) return false;
+		break;
+	}
+	default:
+		break;
+	}
+
+	return true;
+}
+
+
+LONGLONG SISProtocol::get_timestamp()
+{
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+
+	return counter.QuadPart;
 }
 
 
@@ -677,37 +1788,53 @@ std::string SISProtocol::hexprint_bytestream(const BYTE * _bytestream, const siz
 	return buf;
 }
 
-void SISProtocol::throw_rs232_error_events(CSerial::EError _err)
+SISResult SISProtocol::get_rs232_error(CSerial::EError _err)
 {
 	STACK;
 
 	switch (_err)
 	{
 	case CSerial::EErrorBreak:
-		throw SISProtocol::ExceptionTransceiveFailed(CSerial::EErrorBreak, "Break condition occurred. Transceive has been aborted.", true);
+		return SISResult(SISResult_Transceive, CSerial::EErrorBreak, "Break condition occurred. Transceive has been aborted.");
 
 	case CSerial::EErrorFrame:
-		throw SISProtocol::ExceptionTransceiveFailed(CSerial::EErrorFrame, "Framing error occurred. Transceive has been aborted.", true);
+		return SISResult(SISResult_Transceive, CSerial::EErrorFrame, "Framing error occurred. Transceive has been aborted.");
 
 	case CSerial::EErrorIOE:
-		throw SISProtocol::ExceptionTransceiveFailed(CSerial::EErrorIOE, "IO device error occurred. Transceive has been aborted.", true);
+		return SISResult(SISResult_Transceive, CSerial::EErrorIOE, "IO device error occurred. Transceive has been aborted.");
 
 	case CSerial::EErrorMode:
-		throw SISProtocol::ExceptionTransceiveFailed(CSerial::EErrorMode, "Unsupported mode detected. Transceive has been aborted.", true);
+		return SISResult(SISResult_Transceive, CSerial::EErrorMode, "Unsupported mode detected. Transceive has been aborted.");
 
 	case CSerial::EErrorOverrun:
-		throw SISProtocol::ExceptionTransceiveFailed(CSerial::EErrorOverrun, "Buffer overrun detected. Transceive has been aborted.", true);
+		return SISResult(SISResult_Transceive, CSerial::EErrorOverrun, "Buffer overrun detected. Transceive has been aborted.");
 
 	case CSerial::EErrorRxOver:
-		throw SISProtocol::ExceptionTransceiveFailed(CSerial::EErrorRxOver, "Input buffer overflow detected. Transceive has been aborted.", true);
+		return SISResult(SISResult_Transceive, CSerial::EErrorRxOver, "Input buffer overflow detected. Transceive has been aborted.");
 
 	case CSerial::EErrorParity:
-		throw SISProtocol::ExceptionTransceiveFailed(CSerial::EErrorParity, "Input parity occurred. Transceive has been aborted.", true);
+		return SISResult(SISResult_Transceive, CSerial::EErrorParity, "Input parity occurred. Transceive has been aborted.");
 
 	case CSerial::EErrorTxFull:
-		throw SISProtocol::ExceptionTransceiveFailed(CSerial::EErrorTxFull, "Output buffer full. Transceive has been aborted.", true);
+		return SISResult(SISResult_Transceive, CSerial::EErrorTxFull, "Output buffer full. Transceive has been aborted.");
+
+	default:
+		return SISResult(SISResult_Transceive, CSerial::EErrorBreak, "Unknown error occurred. Transceive has been aborted.");
+	}
+}
+
+
+void SISProtocol::throw_result(const SISResult& _result)
+{
+	switch (_result.get_kind())
+	{
+	case SISResult_Transceive:
+		throw SISProtocol::ExceptionTransceiveFailed(_result, true);
+
+	case SISResult_SISError:
+		throw SISProtocol::ExceptionSISError(_result);
 
 	default:
-		throw SISProtocol::ExceptionTransceiveFailed(CSerial::EErrorBreak, "Unknown error occurred. Transceive has been aborted.", true);
+		throw SISProtocol::ExceptionGeneric(_result, false);
 	}
 }
\ No newline at end of file
@@ -2,36 +2,91 @@
 #define _SISPROTOCOL_H_
 
 #include <Windows.h>
+#include <stdint.h>
 #include <string>
+#include <vector>
 #include <mutex>
+#include <map>
+#include <memory>
 
 #include "debug.h"
 #include "helpers.h"
 #include "RS232.h"
+#include "TCPSerial.h"
 #include "Telegrams.h"
+#include "SISCommand.h"
+#include "SISTiming.h"
+#include "SISResult.h"
+#include "SISScaling.h"
+#include "SISLinkArbiter.h"
+#include "SISLinkStats.h"
 
 
 
 #define RS232_BUFFER			254
 #define RS232_READ_LOOPS_MAX	100
 #define RS232_READ_TIMEOUT		1000
+/// Time in [ms] the line has to stay idle until a failed exchange is drained (see SISProtocol::drain()).
+#define RS232_DRAIN_QUIET		20
 
 
 /// Defines address master.
 #define SIS_ADDR_MASTER			0x00
 /// Defines sis address slave. '128' is used for peer-to-peer communication.
 #define SIS_ADDR_SLAVE			0x01
+/// Defines sis address for peer-to-peer communication. The slave reacts with its own address.
+#define SIS_ADDR_PEER			128
 /// Address unit. For Indradrive, this value can be found at P-0-4022.
 #define SIS_ADDR_UNIT			0x01
 
 
-/// Defines the maximum iterations of checking the successful executing of a Indradrive command
-#define MAX_COMMANDCHECK_ITERATIONS 300
+/// Defines the maximum time in [ms] of checking the successful executing of a Indradrive command
+#define SIS_COMMAND_TIMEOUT			60000
+/// Delay in [ms] between two checks of the command status, so that the time limit does not depend on the baud rate
+#define SIS_COMMAND_POLL_INTERVAL	10
+
+
+/// Size of the list segments in [bytes] that are read per telegram by read_list(). Multiple of all data lengths, and
+/// fits into the payload of a list reaction telegram.
+#define SIS_LIST_SEGMENT_SIZE	240
+
+
+/// Maximum number of attempts to reopen the port after the link has been lost (see set_reconnect()).
+#define SIS_RECONNECT_ATTEMPTS	20
+/// Delay in [ms] between two attempts to reopen the port, e.g. while an USB-serial adapter is re-enumerated.
+#define SIS_RECONNECT_INTERVAL	50
+/// Time in [ms] after the link loss until which attempts to reopen the port are started.
+#define SIS_RECONNECT_TIMEOUT	10000
+
+
+#pragma pack(push,1)
+/// Health of the serial link, as observed by the transparent reconnect (see SISProtocol::set_reconnect()).
+typedef struct SISLinkHealth
+{
+	/// 1 if the link is up, 0 if it has been lost and could not be restored yet.
+	uint8_t Connected;
+	/// Number of link losses, i.e. exchanges that failed due to timeouts, line errors, or port errors.
+	uint32_t Losses;
+	/// Number of successful reconnects.
+	uint32_t Reconnects;
+	/// Number of exchanges that have been replayed after a reconnect.
+	uint32_t Replays;
+	/// Duration of the last reconnect in [ms], including the baud rate negotiation.
+	uint32_t LastRecovery;
+	/// Time stamp of the last link loss in [ms] since system start, or 0 if none.
+	uint64_t LastLoss;
+	/// Number of received telegrams that have been discarded: Late reactions to previous commands, or corrupt frames.
+	uint32_t Discarded;
+} SISLinkHealth;
+#pragma pack(pop)
 
 
 /// Class to hold functions an members for the SIS protocol support.
 class SISProtocol
 {
+	/// Drives exchanges by overlapped I/O on the link, and the serial port of the protocol.
+	friend class SISReactor;
+
 public:
 	/// Generic exception handling for SIS Protocol.
 	class ExceptionGeneric;
@@ -70,6 +125,77 @@ public:
 		Baud_115200 = 0b00001000
 	} BAUDRATE;
 
+	/// Single SERCOS parameter request to be processed by transceive_sequential().
+	typedef struct SercosRequest
+	{
+		/// SIS service: SIS_SERVICE_SERCOS_PARAM_READ, SIS_SERVICE_SERCOS_PARAM_WRITE, SIS_SERVICE_SERCOS_LIST_READ,
+		/// or SIS_SERVICE_SERCOS_LIST_WRITE.
+		BYTE Service;
+		/// SERCOS Parameter variant (S, or P).
+		TGM::SercosParamVar ParamVar;
+		/// SERCOS Parameter number.
+		USHORT ParamNum;
+		/// Datablock to be accessed (e.g. operation data or attribute).
+		TGM::SercosDatablock Datablock;
+		/// List offset in bytes (list services only).
+		USHORT ListOffset;
+		/// Segment size in bytes (list services only).
+		USHORT SegmentSize;
+		/// Expected maximum size of the reaction data in bytes. Used to fit the requests into the telegrams.
+		USHORT ReplySize;
+		/// Data to be written. After successful transceiving, it holds the received data.
+		TGM::Data Data;
+		/// SIS error code after transceiving, or 0 if the request succeeded.
+		USHORT Error;
+
+		/// Constructor.
+		///
+		/// @param	_service		(Optional) SIS service, defined by SIS_SERVICES.
+		/// @param	_paramvar   	(Optional) SERCOS Parameter variant (S, or P).
+		/// @param	_paramnum   	(Optional) SERCOS Parameter number.
+		/// @param	_datablock  	(Optional) Datablock to be accessed.
+		/// @param	_data			(Optional) Data to be written.
+		/// @param	_replysize  	(Optional) Expected maximum size of the reaction data in bytes.
+		/// @param	_listoffset 	(Optional) List offset in bytes (list services only).
+		/// @param	_segmentsize	(Optional) Segment size in bytes (list services only).
+		SercosRequest(
+			BYTE _service = SIS_SERVICE_SERCOS_PARAM_READ,
+			TGM::SercosParamVar _paramvar = TGM::SercosParamS,
+			USHORT _paramnum = 0,
+			TGM::SercosDatablock _datablock = TGM::Datablock_OperationData,
+			TGM::Data _data = TGM::Data(),
+			USHORT _replysize = 8,
+			USHORT _listoffset = 0,
+			USHORT _segmentsize = 0) :
+
+			Service(_service),
+			ParamVar(_paramvar),
+			ParamNum(_paramnum),
+			Datablock(_datablock),
+			ListOffset(_listoffset),
+			SegmentSize(_segmentsize),
+			ReplySize(_replysize),
+			Data(_data),
+			Error(0)
+		{}
+
+		/// Query if the request addresses a list segment.
+		///
+		/// @return	True if list service, false if not.
+		bool is_list() const { return Service == SIS_SERVICE_SERCOS_LIST_READ || Service == SIS_SERVICE_SERCOS_LIST_WRITE; }
+
+		/// Gets the size of the request within a sequential command telegram: service byte, payload head and data.
+		///
+		/// @return	The request size.
+		size_t get_request_size() const { return 1 + (is_list() ? 9 : 5) + Data.Size; }
+
+		/// Gets the maximum size of the reaction within a sequential reaction telegram: service byte, status, payload
+		/// head and data (at least the 2 bytes of an error code).
+		///
+		/// @return	The reaction size.
+		size_t get_reaction_size() const { return 1 + 3 + std::max<size_t>(ReplySize, 2); }
+	} SercosRequest;
+
 	/// Default constructor.
 	SISProtocol();
 	/// Destructor.
@@ -77,11 +203,46 @@ public:
 
 	
 
-	void open(const wchar_t * _port = L"COM1");
+	void open(const wchar_t * _port = L"COM1", const UINT32 _baudrate = 19200);
 	void close();
 
 	void set_baudrate(BAUDRATE baudrate);
 
+	/// Gets the baud rate of the serial line.
+	///
+	/// @return	The baud rate.
+	UINT32 get_baudrate() const { return m_baudrate; }
+
+	/// Enables or disables the transparent reconnect. If enabled, an exchange that fails due to a lost link (timeout,
+	/// line error, or port error) closes the port, and reopens it with the port and baud rate of open(). A timeout is
+	/// taken as link loss only if a probe (S-0-0390) fails as well. The baud rate is renegotiated, since the device
+	/// might have been restarted with 19200 Baud. The failed exchange is replayed if it is idempotent (reading or
+	/// writing parameters). Attempts are started within SIS_RECONNECT_TIMEOUT. The link is released between the
+	/// attempts, and exchanges of other threads fail meanwhile instead of waiting.
+	///
+	/// @param	_enable	True to enable, false to disable.
+	void set_reconnect(bool _enable);
+
+	/// Gets the health of the serial link.
+	///
+	/// @return	The link health.
+	SISLinkHealth get_link_health();
+
+	/// Gets the traffic on the serial link since open() or the last reset: Bytes and telegrams per SIS service,
+	/// priority class and parameter, and the resulting utilisation of the line.
+	///
+	/// @param	_reset	(Optional) If true, the counters are reset after reading.
+	///
+	/// @return	The traffic snapshot.
+	SISLinkStats get_link_stats(bool _reset = false);
+
+	/// Gets the time since the last successful exchange.
+	///
+	/// @return	The idle time in [ms].
+	ULONGLONG get_idle_time();
+
+	SISLinkTiming get_link_timing(bool _reset = false);
+
 	void read_parameter(TGM::SercosParamVar _paramvar, USHORT _paramnum, UINT32& _rcvddata);
 	void read_parameter(TGM::SercosParamVar _paramvar, USHORT _paramnum, UINT64& _rcvddata);
 	void read_parameter(TGM::SercosParamVar _paramvar, USHORT _paramnum, DOUBLE& _rcvddata);
@@ -95,17 +256,77 @@ public:
 	void write_parameter(TGM::SercosParamVar _paramvar, USHORT _paramnum, const UINT64 _data);
 	void write_parameter(TGM::SercosParamVar _paramvar, USHORT _paramnum, const DOUBLE _data);
 	
-	void write_listelm(TGM::SercosParamVar _paramvar, USHORT _paramnum, USHORT _elm_pos, const UINT32 _rcvdelm);
-	void write_listelm(TGM::SercosParamVar _paramvar, USHORT _paramnum, USHORT _elm_pos, const UINT64 _rcvdelm);
-	void write_listelm(TGM::SercosParamVar _paramvar, USHORT _paramnum, USHORT _elm_pos, const DOUBLE _rcvdelm);
+	void write_listelm(TGM::SercosParamVar _paramvar, USHORT _paramnum, USHORT _elm_pos, const UINT32 _rcvdelm, const bool _retain = false);
+	void write_listelm(TGM::SercosParamVar _paramvar, USHORT _paramnum, USHORT _elm_pos, const UINT64 _rcvdelm, const bool _retain = false);
+	void write_listelm(TGM::SercosParamVar _paramvar, USHORT _paramnum, USHORT _elm_pos, const DOUBLE _rcvdelm, const bool _retain = false);
 
-	void execute_command(TGM::SercosParamVar _paramvar, USHORT _paramnum);
+	/// Reads a parameter, but reports failures as result instead of throwing. Failed exchanges do not raise exceptions
+	/// at all, and the error message is not formatted until SISResult::get_message() is called.
+	template <typename T> SISResult try_read_parameter(TGM::SercosParamVar _paramvar, USHORT _paramnum, T& _rcvddata) throw();
+	/// Writes a parameter, but reports failures as result instead of throwing. Failed exchanges do not raise exceptions
+	/// at all, and the error message is not formatted until SISResult::get_message() is called.
+	template <typename T> SISResult try_write_parameter(TGM::SercosParamVar _paramvar, USHORT _paramnum, const T _data) throw();
+
+	void execute_command(TGM::SercosParamVar _paramvar, USHORT _paramnum, SISCommand * _ctx = NULL);
+	SISCommand * execute_command_async(TGM::SercosParamVar _paramvar, USHORT _paramnum);
+
+	void transceive_sequential(std::vector<SercosRequest>& _requests);
+
+	/// Reads several single-value parameters in batched telegrams (SIS service 0x04): The attributes of all
+	/// parameters are read first, followed by the values of all parameters whose attributes are available.
+	///
+	/// @param	_paramvars	SERCOS Parameter variants (S, or P).
+	/// @param	_paramnums	SERCOS Parameter numbers.
+	/// @param	_values   	Values, scaled by the decimal places of the parameters. 0 if failed.
+	/// @param	_errors   	SIS error codes per parameter, or 0 if succeeded.
+	/// @param	_len	  	Number of parameters.
+	void read_parameters(const TGM::SercosParamVar _paramvars[], const USHORT _paramnums[], DOUBLE _values[], USHORT _errors[], const size_t _len);
+
+	/// Reads several single-value parameters in batched telegrams (SIS service 0x04), like the overload above, but
+	/// delivers the operation data as integers, so that 64-bit values are kept exactly.
+	///
+	/// @param	_paramvars	SERCOS Parameter variants (S, or P).
+	/// @param	_paramnums	SERCOS Parameter numbers.
+	/// @param	_values   	Operation data without decimal places applied, zero-extended by the data length of the
+	/// 					parameters. 0 if failed.
+	/// @param	_errors   	SIS error codes per parameter, or 0 if succeeded.
+	/// @param	_len	  	Number of parameters.
+	void read_parameters(const TGM::SercosParamVar _paramvars[], const USHORT _paramnums[], UINT64 _values[], USHORT _errors[], const size_t _len);
+
+	/// Reads a whole list parameter in segments of SIS_LIST_SEGMENT_SIZE bytes, with as few telegrams as possible
+	/// (SIS service 0x04). The list header is read first to determine the actual length of the list.
+	///
+	/// @param	_paramvar	SERCOS Parameter variant (S, or P).
+	/// @param	_paramnum	SERCOS Parameter number.
+	/// @param	_data	 	List data in [bytes], without list header.
+	/// @param	_maxlen  	(Optional) Maximum number of bytes to be read.
+	void read_list(TGM::SercosParamVar _paramvar, USHORT _paramnum, std::vector<BYTE>& _data, const size_t _maxlen = 0xFFFF);
+
+	void read_diagnostic(UINT32& _diagnum, std::string& _diagmsg);
+	UINT32 read_diagnostic_num();
+	void invalidate_diagnostic();
+
+	/// Clears the cached scalings, so that the attributes are read again on next use. The decimal places of
+	/// velocity, position, acceleration and torque data depend on their scaling parameters (e.g. S-0-0044), so that
+	/// writes of them invalidate the cache by themselves.
+	void invalidate_scaling();
+
+	static void get_attribute_format(const UINT32 _attribute, UINT8& _scalefactor, size_t& _datalen);
+
+	/// Gets the scaling of a parameter. The attribute is read from the device on first use only, and cached until the
+	/// next open(), or until a scaling parameter is written (see invalidate_scaling()).
+	///
+	/// @param	_paramvar	SERCOS Parameter variant (S, or P).
+	/// @param	_paramnum	SERCOS Parameter number.
+	///
+	/// @return	The scaling descriptor.
+	SISScaling get_scaling(TGM::SercosParamVar _paramvar, const USHORT &_paramnum);
 
 
 private:
 
-	inline void get_parameter_attributes(TGM::SercosParamVar _paramvar, const USHORT &_paramnum, UINT8& _scalefactor, size_t& _datalen);
 	inline void get_parameter_status(const TGM::SercosParamVar _paramvar, const USHORT &_paramnum, TGM::SercosCommandstatus& _datastatus);
+	inline void wait_command_status(const TGM::SercosParamVar _paramvar, const USHORT &_paramnum, TGM::SercosCommandstatus& _datastatus);
 
 	/// Transceive parameter.
 	///
@@ -126,33 +347,142 @@ private:
 	template <class TCHeader, class TCPayload, class TRHeader, class TRPayload>
 	TGM::Map<TRHeader, TRPayload> transceive_param(TGM::SercosParamVar _paramvar, const USHORT &_paramnum, BYTE _service, TGM::Data const * const _data = new TGM::Data(), TGM::SercosDatablock _attribute = TGM::Datablock_OperationData);
 
+	/// Transceive parameter, but reports failures as result instead of throwing (see transceive_param()).
+	///
+	/// @param [out]	_rx_tgm	Reception telegram. Valid if succeeded.
+	///
+	/// @return	The result of the exchange.
+	template <class TCHeader, class TCPayload, class TRHeader, class TRPayload>
+	SISResult try_transceive_param(TGM::Map<TRHeader, TRPayload>& _rx_tgm, TGM::SercosParamVar _paramvar, const USHORT &_paramnum, BYTE _service, TGM::Data const * const _data = new TGM::Data(), TGM::SercosDatablock _attribute = TGM::Datablock_OperationData);
+
 	template <class TCHeader, class TCPayload, class TRHeader, class TRPayload>
 	TGM::Map<TRHeader, TRPayload> transceive_list(TGM::SercosParamVar _paramvar, const USHORT &_paramnum, BYTE _service, USHORT & _element_size, USHORT & _list_offset, TGM::Data const * const _data = new TGM::Data(), TGM::SercosDatablock _attribute = TGM::Datablock_OperationData);
 
+	void transceive_single(SercosRequest& _request);
+
+	/// Gets the scaling of a parameter (see get_scaling()), but reports failures as result instead of throwing.
+	SISResult try_get_scaling(TGM::SercosParamVar _paramvar, const USHORT &_paramnum, SISScaling& _scaling);
+
+	/// Reads and writes single parameters. Failures are returned, so that try_read_parameter() and
+	/// try_write_parameter() do not raise exceptions. read_parameter() and write_parameter() throw them.
+	SISResult read_parameter_result(TGM::SercosParamVar _paramvar, USHORT _paramnum, UINT32& _rcvddata);
+	SISResult read_parameter_result(TGM::SercosParamVar _paramvar, USHORT _paramnum, UINT64& _rcvddata);
+	SISResult read_parameter_result(TGM::SercosParamVar _paramvar, USHORT _paramnum, DOUBLE& _rcvddata);
+	SISResult write_parameter_result(TGM::SercosParamVar _paramvar, USHORT _paramnum, const UINT32 _data);
+	SISResult write_parameter_result(TGM::SercosParamVar _paramvar, USHORT _paramnum, const UINT64 _data);
+	SISResult write_parameter_result(TGM::SercosParamVar _paramvar, USHORT _paramnum, const DOUBLE _data);
+	void read_parameters_data(const TGM::SercosParamVar _paramvars[], const USHORT _paramnums[], std::vector<SISScaling>& _scalings, std::vector<SercosRequest>& _reads, std::vector<size_t>& _indices, USHORT _errors[], const size_t _len);
+	bool transceive_sequential_chunk(std::vector<SercosRequest>& _requests, const size_t _first, const size_t _last);
+
 	template <class THeader, class TPayload>
 	inline bool check_boundaries(TGM::Map<THeader, TPayload>& _tgm);
 
 	static std::string hexprint_bytestream(const BYTE * _bytestream, const size_t _len);
 
-	inline INT64 get_sized_data(TGM::Data& rx_data, const size_t &datalen);
-	inline void set_sized_data(TGM::Data& tx_data, const size_t &datalen, UINT64& _rcvdelm);
+	static bool is_scaling_param(const TGM::SercosParamVar _paramvar, const USHORT _paramnum);
+
 	inline void set_parameter_listsize(TGM::SercosParamVar param_variant, USHORT& param_number, const size_t& datalen, const USHORT& segment_position, bool retain_following_segments = false);
 
 private:
 
+	/// Sends a command telegram and receives its reaction, recovering the link if lost. Failed exchanges are returned
+	/// as result, so that they do not cost exceptions. Only failures of the port itself are thrown (CSerial).
+	///
+	/// @return	The result of the exchange.
 	template <class TCHeader, class TCPayload, class TRHeader, class TRPayload>
-	void transceiving(TGM::Map<TCHeader, TCPayload>& tx_tgm, TGM::Map<TRHeader, TRPayload>& rx_tgm);
+	SISResult transceiving(TGM::Map<TCHeader, TCPayload>& tx_tgm, TGM::Map<TRHeader, TRPayload>& rx_tgm, LONGLONG _t_request = 0);
 
-	static void throw_rs232_error_events(CSerial::EError _err);
+	template <class TCHeader, class TCPayload, class TRHeader, class TRPayload>
+	SISResult exchange(TGM::Map<TCHeader, TCPayload>& tx_tgm, TGM::Map<TRHeader, TRPayload>& rx_tgm, LONGLONG _t_request, bool _retry);
 
-private:
-	CSerial m_serial;
+	void connect();
+	bool recover(const BYTE _service, const bool _timeout, std::unique_lock<SISLinkArbiter>& _lock);
+	bool reconnect(std::unique_lock<SISLinkArbiter>& _lock);
+	static bool is_idempotent(const BYTE _service);
+
+	LONGLONG get_timestamp();
+
+	void account_param(const USHORT _ident, const size_t _txbytes, const size_t _rxbytes);
+
+	/// Discards the bytes received after a failed exchange, until the line stays idle for RS232_DRAIN_QUIET (at most
+	/// RS232_READ_TIMEOUT). Reactions do not tell which parameter they refer to, so that a late reaction to the
+	/// failed exchange would be taken for the reaction to the next one.
+	void drain();
+	size_t frame_reaction(const BYTE * _tx, BYTE * _rx, DWORD& _len);
+	static bool correlates(const TGM::Header& _tx, const BYTE * _rx, const size_t _len);
 
-	std::mutex mutex_sis;
+	static SISResult get_rs232_error(CSerial::EError _err);
+
+	/// Throws the exception that corresponds to a failed result.
+	///
+	/// @param	_result	The result. Must not be succeeded.
+	static void throw_result(const SISResult& _result);
+
+private:
+	/// Serial port, or TCP gateway (CTCPSerial). Created on connect by the port name.
+	std::unique_ptr<CSerial> m_serial;
+
+	/// Grants the link by the priority class of the calling thread. Recursive, so that a reconnect can renegotiate
+	/// the baud rate while holding the link.
+	SISLinkArbiter mutex_sis;
+
+	/// Port of open().
+	std::wstring m_port;
+	/// Baud rate of open().
+	UINT32 m_baudrate_open;
+	/// Baud rate of open(), as SIS baud rate mask.
+	BAUDRATE m_baudrate_sis;
+	/// Set if the transparent reconnect is enabled.
+	bool m_reconnect;
+	/// Set while the port is opened, and the baud rate is negotiated.
+	bool m_connecting;
+	/// Thread that recovers the link, or no thread. Exchanges of other threads fail meanwhile.
+	std::thread::id m_recovery;
+	/// Health of the serial link.
+	SISLinkHealth m_health;
+
+	std::mutex mutex_health;
+
+	/// Set if the device does not support SIS service 0x04 (sequential list of services).
+	bool m_sequential_unsupported;
+
+	/// Diagnostic number (S-0-0390) the cached diagnostic message belongs to.
+	UINT32 m_diag_num;
+	/// Cached diagnostic message (S-0-0095), without list header.
+	std::string m_diag_msg;
+	/// Set if the cached diagnostic message is valid.
+	bool m_diag_valid;
+
+	std::mutex mutex_diag;
+
+	/// Scaling descriptors of the parameters used so far, by ((paramvar << 16) | paramnum).
+	std::map<UINT32, SISScaling> m_scaling;
+
+	std::mutex mutex_scaling;
+
+	/// Baud rate of the serial line.
+	UINT32 m_baudrate;
+	/// Performance counter ticks per second.
+	LONGLONG m_frequency;
+	/// Latency from the request of an exchange until the command telegram is handed to the serial port.
+	SISLatencyHistogram m_timing_firstbyte;
+	/// Latency from the request of an exchange until the reaction telegram is received completely.
+	SISLatencyHistogram m_timing_ack;
+	/// Time of the last successful exchange in [ms] since system start.
+	ULONGLONG m_last_exchange;
+
+	std::mutex mutex_timing;
+
+	/// Traffic on the serial link.
+	SISLinkCounter m_traffic;
+
+	std::mutex mutex_traffic;
 };
 
 /// Generic exceptions for SIS protocol.
 ///
+/// The exception carries a SISResult, so that the message is formatted only if what() is called.
+///
 /// @sa	std::exception
 class SISProtocol::ExceptionGeneric : public std::exception
 {
@@ -164,28 +494,32 @@ public:
 		const std::string _trace_log,
 		bool _warning = false) :
 
-		m_status(_status),
-		m_message(_trace_log),
-		warning(_warning)
+		warning(_warning),
+		m_result(SISResult_Generic, _status, _trace_log)
 	{}
 
 	virtual const char* what() const throw ()
 	{
-#ifdef NDEBUG
-		return str2char(sformat("SIS Protocol exception caused: %s ### STATUS=0x%04x (%d) ### MESSAGE='%s'", Stack::GetTraceString().c_str(), m_status, m_status, m_message.c_str()));
-#else
-		const char* ex = str2char(sformat("SIS Protocol exception caused: %s ### STATUS=0x%04x (%d) ### MESSAGE='%s'", Stack::GetTraceString().c_str(), m_status, m_status, m_message.c_str()));
-		OutputDebugStringA((LPCSTR)ex);
-		return ex;
-#endif
+		return m_result.get_message();
 	}
 
-	int get_status() { return m_status; }
+	int get_status() { return m_result.get_status(); }
 
-protected:
-	int m_status;
+	/// Gets the result that describes the failure.
+	///
+	/// @return	The result.
+	const SISResult& get_result() const { return m_result; }
+
+	ExceptionGeneric(
+		const SISResult& _result,
+		bool _warning) :
 
-	std::string m_message;
+		warning(_warning),
+		m_result(_result)
+	{}
+
+protected:
+	SISResult m_result;
 };
 
 /// Specific exception handling of SIS Protocol transceiving failed.
@@ -199,20 +533,15 @@ public:
 		const std::string _message,
 		bool _warning = false) :
 
-		ExceptionGeneric(_status, _message, _warning)
+		ExceptionGeneric(SISResult(SISResult_Transceive, _status, _message), _warning)
 	{}
-	~ExceptionTransceiveFailed() throw() {}
+	ExceptionTransceiveFailed(
+		const SISResult& _result,
+		bool _warning = false) :
 
-	virtual const char* what() const throw ()
-	{
-#ifdef NDEBUG
-		return str2char(sformat("SIS Protocol reception fail caused: STATUS=0x%04x (%d) ### MESSAGE='%s'", m_status, m_status, m_message.c_str()));
-#else
-		const char* ex = str2char(sformat("SIS Protocol reception fail caused: STATUS=0x%04x (%d) ### MESSAGE='%s'", m_status, m_status, m_message.c_str()));
-		OutputDebugStringA((LPCSTR)ex);
-		return ex;
-#endif
-	}
+		ExceptionGeneric(_result, _warning)
+	{}
+	~ExceptionTransceiveFailed() throw() {}
 };
 
 /// Specific exception handling of SIS Protocol error codes.
@@ -224,31 +553,65 @@ public:
 	ExceptionSISError(
 		int _status,
 		int _code,
-		const std::string _bytestream,
+		const BYTE * _bytestream,
+		const size_t _len,
+		bool _warning = false) :
+
+		ExceptionGeneric(SISResult(SISResult_SISError, _status, std::string(), _code, _bytestream, _len), _warning)
+	{}
+	ExceptionSISError(
+		const SISResult& _result,
 		bool _warning = false) :
 
-		ExceptionGeneric(_status, std::string(), _warning),
-		m_errorcode(_code),
-		m_bytestream(_bytestream)
+		ExceptionGeneric(_result, _warning)
 	{}
 	~ExceptionSISError() throw() {}
 
-	virtual const char* what() const throw ()
+	int get_errorcode() { return m_result.get_errorcode(); }
+};
+
+
+template <typename T>
+SISResult SISProtocol::try_read_parameter(TGM::SercosParamVar _paramvar, USHORT _paramnum, T& _rcvddata) throw()
+{
+	try
+	{
+		return read_parameter_result(_paramvar, _paramnum, _rcvddata);
+	}
+	catch (SISProtocol::ExceptionGeneric &ex)
+	{
+		return ex.get_result();
+	}
+	catch (CSerial::ExceptionGeneric &ex)
+	{
+		return SISResult(SISResult_Serial, ex.get_status(), ex.m_message);
+	}
+	catch (...)
 	{
-#ifdef NDEBUG
-		return str2char(sformat("(Return code: %d) SIS Protocol Error code returned has been received: 0x%04X.\nOriginal Telegram bytestream: %s", m_status, m_errorcode, m_bytestream.c_str()));
-#else
-		const char* ex = str2char(sformat("(Return code: %d) SIS Protocol Error code returned has been received: 0x%04X.\nOriginal Telegram bytestream: %s", m_status, m_errorcode, m_bytestream.c_str()));
-		OutputDebugStringA((LPCSTR)ex);
-		return ex;
-#endif
+		return SISResult(SISResult_Generic, -1, "Reading the parameter failed unexpectedly.");
 	}
+}
 
-	int get_errorcode() { return m_errorcode; }
 
-protected:
-	int m_errorcode;
-	std::string m_bytestream;
-};
+template <typename T>
+SISResult SISProtocol::try_write_parameter(TGM::SercosParamVar _paramvar, USHORT _paramnum, const T _data) throw()
+{
+	try
+	{
+		return write_parameter_result(_paramvar, _paramnum, _data);
+	}
+	catch (SISProtocol::ExceptionGeneric &ex)
+	{
+		return ex.get_result();
+	}
+	catch (CSerial::ExceptionGeneric &ex)
+	{
+		return SISResult(SISResult_Serial, ex.get_status(), ex.m_message);
+	}
+	catch (...)
+	{
+		return SISResult(SISResult_Generic, -1, "Writing the parameter failed unexpectedly.");
+	}
+}
 
 #endif /* _SISPROTOCOL_H_ */
\ No newline at end of file
@@ -0,0 +1,536 @@
+#include "SISReactor.h"
+
+#include <algorithm>
+#include <memory>
+
+
+
+SISReactor::SISReactor() :
+	m_stop(false),
+	m_tick(GetTickCount64() / SISREACTOR_TICK),
+	m_generation(0)
+{
+	m_wakeup = CreateEvent(NULL, FALSE, FALSE, NULL);
+	if (!m_wakeup)
+		throw SISProtocol::ExceptionGeneric(GetLastError(), "Wakeup event of the reactor could not be created.");
+
+	m_thread = std::thread(&SISReactor::run, this);
+}
+
+
+SISReactor::~SISReactor()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_reactor);
+
+		m_stop = true;
+		for (std::vector<Link*>::iterator it = m_links.begin(); it != m_links.end(); ++it)
+			(*it)->Detaching = true;
+	}
+	SetEvent(m_wakeup);
+
+	if (m_thread.joinable())
+		m_thread.join();
+
+	CloseHandle(m_wakeup);
+}
+
+
+void SISReactor::attach(SISProtocol * _sis, const std::vector<SISReactorParam>& _params, const DWORD _interval)
+{
+	STACK;
+
+	if (_params.empty() || _params.size() > SISREACTOR_PARAMS_MAX)
+		throw SISProtocol::ExceptionGeneric(-1, sformat("Number of parameters must be 1 ... %u.", SISREACTOR_PARAMS_MAX));
+
+	if (!_interval)
+		throw SISProtocol::ExceptionGeneric(-1, "Sampling interval must be greater than 0 ms.");
+
+	// Overlapped I/O is driven on the serial port itself, which gateways do not provide
+	{
+		std::lock_guard<SISLinkArbiter> lock(_sis->mutex_sis);
+		if (dynamic_cast<CTCPSerial*>(_sis->m_serial.get()))
+			throw SISProtocol::ExceptionGeneric(-1, "Links over TCP gateways cannot be attached to the reactor.");
+	}
+
+	std::unique_ptr<Link> link(new Link());
+	link->Sis = _sis;
+	link->Params = _params;
+	link->Samples.resize(_params.size());
+	link->Interval = _interval;
+	link->Status = State_Idle;
+	link->Cycling = false;
+
+	// Scaling is read in by the calling thread, so that the reactor thread never blocks on the link
+	for (std::vector<SISReactorParam>::const_iterator it = _params.begin(); it != _params.end(); ++it)
+		link->Scalings.push_back(_sis->get_scaling(it->ParamVar ? TGM::SercosParamP : TGM::SercosParamS, it->ParamNum));
+
+	link->Overlapped.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+	if (!link->Overlapped.hEvent)
+		throw SISProtocol::ExceptionGeneric(GetLastError(), "Completion event of the link could not be created.");
+
+	std::lock_guard<std::mutex> lock(mutex_reactor);
+
+	if (find(_sis) != m_links.end() || m_links.size() >= SISREACTOR_LINKS_MAX)
+	{
+		CloseHandle(link->Overlapped.hEvent);
+		throw SISProtocol::ExceptionGeneric(-1, sformat("Link is attached already, or %u links are attached.", SISREACTOR_LINKS_MAX));
+	}
+
+	// First cycle starts with the next tick
+	link->Due = GetTickCount64();
+	arm(link.get(), link->Due);
+
+	m_links.push_back(link.release());
+}
+
+
+bool SISReactor::detach(SISProtocol * _sis)
+{
+	STACK;
+
+	std::unique_lock<std::mutex> lock(mutex_reactor);
+
+	std::vector<Link*>::iterator it = find(_sis);
+	if (it == m_links.end()) return false;
+
+	(*it)->Detaching = true;
+	SetEvent(m_wakeup);
+
+	m_detached.wait(lock, [&] { return find(_sis) == m_links.end(); });
+
+	return true;
+}
+
+
+size_t SISReactor::read(SISProtocol * _sis, SISReactorSample _samples[], const size_t _len)
+{
+	STACK;
+
+	std::lock_guard<std::mutex> lock(mutex_reactor);
+
+	std::vector<Link*>::iterator it = find(_sis);
+	if (it == m_links.end())
+		throw SISProtocol::ExceptionGeneric(-1, "Link is not attached to the reactor.");
+
+	size_t count = std::min(_len, (*it)->Samples.size());
+	std::copy((*it)->Samples.begin(), (*it)->Samples.begin() + count, _samples);
+
+	return count;
+}
+
+
+size_t SISReactor::get_count()
+{
+	std::lock_guard<std::mutex> lock(mutex_reactor);
+
+	return m_links.size();
+}
+
+
+void SISReactor::run()
+{
+	STACK;
+
+	// Sampling must not delay commands of the application
+	SISPriorityScope priority(SISPriority_Poll);
+
+	std::vector<HANDLE> events;
+
+	while (true)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_reactor);
+
+			if (m_stop && m_links.empty()) break;
+
+			events.assign(1, m_wakeup);
+			for (std::vector<Link*>::iterator it = m_links.begin(); it != m_links.end(); ++it)
+				if ((*it)->Status != State_Idle) events.push_back((*it)->Overlapped.hEvent);
+		}
+
+		WaitForMultipleObjects(static_cast<DWORD>(events.size()), events.data(), FALSE, SISREACTOR_TICK);
+
+		std::lock_guard<std::mutex> lock(mutex_reactor);
+
+		const ULONGLONG now = GetTickCount64();
+
+		// All links are checked, since the wait reports the first completion only
+		for (size_t i = 0; i < m_links.size();)
+		{
+			Link * link = m_links[i];
+
+			if (link->Status != State_Idle && HasOverlappedIoCompleted(&link->Overlapped))
+				complete(link, now);
+
+			if (link->Detaching && remove(link)) continue;
+			i++;
+		}
+
+		expire(now);
+	}
+}
+
+
+void SISReactor::expire(const ULONGLONG _now)
+{
+	const ULONGLONG tick = _now / SISREACTOR_TICK;
+
+	// Each slot is visited once per tick. After a stall of a revolution or more, each slot is visited once.
+	ULONGLONG first = m_tick + 1;
+	if (tick - m_tick > SISREACTOR_SLOTS) first = tick - SISREACTOR_SLOTS + 1;
+
+	std::vector<Timer> due;
+
+	for (ULONGLONG t = first; t <= tick; t++)
+	{
+		std::vector<Timer>& slot = m_wheel[t % SISREACTOR_SLOTS];
+
+		for (size_t i = 0; i < slot.size();)
+		{
+			// Timers that have been re-armed are void. Timers beyond this revolution stay.
+			if (slot[i].Generation == slot[i].Target->Timer && slot[i].Deadline > _now)
+			{
+				i++;
+				continue;
+			}
+
+			if (slot[i].Generation == slot[i].Target->Timer)
+				due.push_back(slot[i]);
+
+			slot[i] = slot.back();
+			slot.pop_back();
+		}
+	}
+
+	m_tick = tick;
+
+	for (std::vector<Timer>::iterator it = due.begin(); it != due.end(); ++it)
+		if (it->Generation == it->Target->Timer) fire(it->Target, _now);
+}
+
+
+void SISReactor::arm(Link * _link, const ULONGLONG _deadline)
+{
+	Timer timer;
+	timer.Target = _link;
+	timer.Generation = _link->Timer = ++m_generation;
+	timer.Deadline = _deadline;
+
+	// Slots up to the current tick have been visited already, and are not visited again until the next revolution.
+	// Past deadlines are thus armed for the next tick.
+	const ULONGLONG tick = std::max<ULONGLONG>(_deadline / SISREACTOR_TICK, m_tick + 1);
+
+	m_wheel[tick % SISREACTOR_SLOTS].push_back(timer);
+}
+
+
+void SISReactor::fire(Link * _link, const ULONGLONG _now)
+{
+	switch (_link->Status)
+	{
+	case State_Idle:
+		if (_link->Detaching) break;
+
+		// Otherwise, the cycle has been postponed within, and is resumed
+		if (!_link->Cycling)
+		{
+			_link->Cycling = true;
+			_link->Current = 0;
+		}
+
+		begin_cycle(_link, _now);
+		break;
+	case State_Writing:
+	case State_Waiting:
+	case State_Reading:
+		// No reaction in time
+		_link->Samples[_link->Current].Error = SISREACTOR_ERROR_LINK;
+		cancel(_link);
+		break;
+	case State_Cancelling:
+		break;
+	}
+}
+
+
+void SISReactor::begin_cycle(Link * _link, const ULONGLONG _now)
+{
+	// Link is taken per telegram. Held by the application, or by a reconnect: Postponed by a tick.
+	if (!_link->Sis->mutex_sis.try_lock())
+	{
+		_link->Status = State_Idle;
+		arm(_link, _now + SISREACTOR_TICK);
+		return;
+	}
+
+	_link->Locked = true;
+	_link->Port = _link->Sis->m_serial->GetCommHandle();
+
+	if (!_link->Sis->m_serial->IsOpen())
+	{
+		fail(_link, SISREACTOR_ERROR_LINK, _now);
+		return;
+	}
+
+	send(_link, _now);
+}
+
+
+void SISReactor::end_cycle(Link * _link, const ULONGLONG _now)
+{
+	release(_link);
+
+	_link->Status = State_Idle;
+	_link->Cycling = false;
+
+	for (std::vector<SISReactorSample>::iterator it = _link->Samples.begin(); it != _link->Samples.end(); ++it)
+		it->Cycles++;
+
+	// Phase of the interval is kept. Cycles that have been missed are skipped.
+	_link->Due += _link->Interval;
+	if (_link->Due <= _now)
+		_link->Due += ((_now - _link->Due) / _link->Interval + 1) * _link->Interval;
+
+	arm(_link, _link->Due);
+}
+
+
+void SISReactor::release(Link * _link)
+{
+	if (!_link->Locked) return;
+
+	_link->Sis->mutex_sis.unlock();
+	_link->Locked = false;
+}
+
+
+void SISReactor::send(Link * _link, const ULONGLONG _now)
+{
+	const SISReactorParam& param = _link->Params[_link->Current];
+
+	// Build Telegram, as SISProtocol::transceive_param() does
+	TGM::Bitfields::SercosParamControl control(TGM::Datablock_OperationData);
+	TGM::Bitfields::SercosParamIdent ident(param.ParamVar ? TGM::SercosParamP : TGM::SercosParamS, param.ParamNum);
+
+	TGM::Header header(SIS_ADDR_MASTER, SIS_ADDR_SLAVE, SISProtocol::SIS_SERVICE_SERCOS_PARAM_READ, TGM::Bitfields::HeaderControl(TGM::TypeCommand));
+	TGM::Commands::SercosParam payload(control, SIS_ADDR_SLAVE, ident);
+
+	_link->Tx.Mapping.Header = header;
+	_link->Tx.Mapping.Payload = payload;
+	_link->Tx.Mapping.Header.set_DatL(_link->Tx.Mapping.Payload.get_size());
+	_link->Tx.Mapping.Header.calc_checksum(&_link->Tx.Raw);
+
+	_link->Received = 0;
+	_link->Status = State_Writing;
+	arm(_link, _now + RS232_READ_TIMEOUT);
+
+	prepare(_link);
+	if (!WriteFile(_link->Port, _link->Tx.Raw.Bytes, static_cast<DWORD>(_link->Tx.Mapping.Header.get_size() + _link->Tx.Mapping.Payload.get_size()), NULL, &_link->Overlapped) && GetLastError() != ERROR_IO_PENDING)
+		fail(_link, SISREACTOR_ERROR_LINK, _now);
+}
+
+
+void SISReactor::wait_event(Link * _link, const ULONGLONG _now)
+{
+	_link->Status = State_Waiting;
+
+	prepare(_link);
+	if (!WaitCommEvent(_link->Port, &_link->EventMask, &_link->Overlapped) && GetLastError() != ERROR_IO_PENDING)
+		fail(_link, SISREACTOR_ERROR_LINK, _now);
+}
+
+
+void SISReactor::receive(Link * _link, const ULONGLONG _now)
+{
+	_link->Status = State_Reading;
+
+	// Read timeouts of the port are non-blocking, i.e. the read completes with the bytes received so far
+	prepare(_link);
+	if (!ReadFile(_link->Port, _link->Rx.Raw.Bytes + _link->Received, RS232_BUFFER - _link->Received, NULL, &_link->Overlapped) && GetLastError() != ERROR_IO_PENDING)
+		fail(_link, SISREACTOR_ERROR_LINK, _now);
+}
+
+
+void SISReactor::complete(Link * _link, const ULONGLONG _now)
+{
+	DWORD bytes = 0;
+	const BOOL succeeded = GetOverlappedResult(_link->Port, &_link->Overlapped, &bytes, FALSE);
+
+	switch (_link->Status)
+	{
+	case State_Idle:
+		break;
+
+	case State_Cancelling:
+		end_cycle(_link, _now);
+		break;
+
+	case State_Writing:
+		if (!succeeded)
+		{
+			fail(_link, SISREACTOR_ERROR_LINK, _now);
+			break;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(_link->Sis->mutex_traffic);
+			_link->Sis->m_traffic.record_tx(SISProtocol::SIS_SERVICE_SERCOS_PARAM_READ, SISPriority_Poll, bytes, _link->Sis->m_baudrate);
+		}
+
+		wait_event(_link, _now);
+		break;
+
+	case State_Waiting:
+		if (!succeeded || (_link->EventMask & (CSerial::EEventBreak | CSerial::EEventError)))
+		{
+			DWORD errors = 0;
+			ClearCommError(_link->Port, &errors, NULL);
+
+			fail(_link, SISREACTOR_ERROR_LINK, _now);
+			break;
+		}
+
+		if (_link->EventMask & CSerial::EEventRecv)
+			receive(_link, _now);
+		else
+			wait_event(_link, _now);
+		break;
+
+	case State_Reading:
+		if (!succeeded)
+		{
+			fail(_link, SISREACTOR_ERROR_LINK, _now);
+			break;
+		}
+
+		_link->Received += bytes;
+
+		// Stale reactions of timed out cycles are discarded by the parser
+		{
+			const size_t len = _link->Sis->frame_reaction(_link->Tx.Raw.Bytes, _link->Rx.Raw.Bytes, _link->Received);
+
+			if (len)
+				evaluate(_link, len, _now);
+			else
+				wait_event(_link, _now);
+		}
+		break;
+	}
+}
+
+
+void SISReactor::evaluate(Link * _link, const size_t _len, const ULONGLONG _now)
+{
+	SISProtocol * sis = _link->Sis;
+	SISReactorSample& sample = _link->Samples[_link->Current];
+
+	const size_t head_len = _link->Rx.Mapping.Payload.get_head_size();
+
+	{
+		std::lock_guard<std::mutex> lock(sis->mutex_traffic);
+		sis->m_traffic.record_rx(SISProtocol::SIS_SERVICE_SERCOS_PARAM_READ, SISPriority_Poll, _len, sis->m_baudrate);
+	}
+
+	sis->account_param(_link->Tx.Mapping.Payload.ParamNum,
+		_link->Tx.Mapping.Header.get_size() + _link->Tx.Mapping.Payload.get_size(), _len);
+
+	{
+		std::lock_guard<std::mutex> lock(sis->mutex_timing);
+		sis->m_last_exchange = _now;
+	}
+
+	if (_len < TGM_SIZE_HEADER + head_len)
+		sample.Error = SISREACTOR_ERROR_LINK;
+	else if (_link->Rx.Mapping.Payload.has_error())
+	{
+		USHORT error = _link->Rx.Mapping.Payload.Error;
+
+		// Device is busy: Repeated with the next telegram
+		if (error == 0x800C || error == 0x800B || error == 0x8001)
+		{
+			release(_link);
+			begin_cycle(_link, _now);
+			return;
+		}
+
+		sample.Error = error;
+	}
+	else
+	{
+		_link->Rx.Mapping.Payload.Bytes.set_size(_len - TGM_SIZE_HEADER - head_len);
+
+		sample.Value = _link->Scalings[_link->Current].decode(_link->Rx.Mapping.Payload.Bytes.Bytes);
+		sample.Error = 0;
+		sample.Timestamp = _now;
+	}
+
+	if (++_link->Current < _link->Params.size())
+	{
+		// Exchanges of the application are served between the telegrams
+		release(_link);
+		begin_cycle(_link, _now);
+	}
+	else
+		end_cycle(_link, _now);
+}
+
+
+void SISReactor::fail(Link * _link, const USHORT _error, const ULONGLONG _now)
+{
+	// No operation is pending. Remaining parameters are left for the next cycle.
+	_link->Samples[_link->Current].Error = _error;
+
+	end_cycle(_link, _now);
+}
+
+
+void SISReactor::cancel(Link * _link)
+{
+	// Cycle is ended by the completion of the cancelled operation
+	_link->Status = State_Cancelling;
+	CancelIoEx(_link->Port, &_link->Overlapped);
+}
+
+
+void SISReactor::prepare(Link * _link)
+{
+	HANDLE event = _link->Overlapped.hEvent;
+
+	memset(&_link->Overlapped, 0, sizeof(_link->Overlapped));
+	_link->Overlapped.hEvent = event;
+
+	ResetEvent(event);
+}
+
+
+bool SISReactor::remove(Link * _link)
+{
+	// Pending operation is aborted first, so that the overlapped structure is not in use anymore
+	if (_link->Status != State_Idle)
+	{
+		if (_link->Status != State_Cancelling) cancel(_link);
+		return false;
+	}
+
+	m_links.erase(std::find(m_links.begin(), m_links.end(), _link));
+
+	for (size_t s = 0; s < SISREACTOR_SLOTS; s++)
+	{
+		std::vector<Timer>& slot = m_wheel[s];
+		slot.erase(std::remove_if(slot.begin(), slot.end(), [&](const Timer& _timer) { return _timer.Target == _link; }), slot.end());
+	}
+
+	CloseHandle(_link->Overlapped.hEvent);
+	delete _link;
+
+	m_detached.notify_all();
+
+	return true;
+}
+
+
+std::vector<SISReactor::Link*>::iterator SISReactor::find(SISProtocol * _sis)
+{
+	return std::find_if(m_links.begin(), m_links.end(), [&](const Link * _link) { return _link->Sis == _sis; });
+}
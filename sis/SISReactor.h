@@ -0,0 +1,203 @@
+/// @file
+/// Contains the reactor that samples parameters of many drives cyclically from a single thread.
+
+#ifndef _SISREACTOR_H_
+#define _SISREACTOR_H_
+
+#include <Windows.h>
+#include <stdint.h>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+#include "debug.h"
+#include "SISProtocol.h"
+#include "SISScaling.h"
+
+
+/// Maximum number of links served by a reactor. One wait slot is taken by the wakeup event.
+#define SISREACTOR_LINKS_MAX		(MAXIMUM_WAIT_OBJECTS - 1)
+/// Maximum number of parameters sampled per link.
+#define SISREACTOR_PARAMS_MAX		16
+/// Default sampling interval in [ms].
+#define SISREACTOR_INTERVAL_DEFAULT	100
+/// Resolution of the timer wheel in [ms].
+#define SISREACTOR_TICK				10
+/// Number of slots of the timer wheel. Timeouts beyond one revolution stay in their slot for further revolutions.
+#define SISREACTOR_SLOTS			256
+/// Error code of a sample that could not be read due to the link: Timeout, line error, or closed port.
+#define SISREACTOR_ERROR_LINK		0xFFFF
+
+
+#pragma pack(push,1)
+/// Parameter sampled by the reactor.
+typedef struct SISReactorParam
+{
+	/// Parameter variant: 0 for S-Parameter, 1 for P-Parameter.
+	uint8_t ParamVar;
+	/// Parameter number, e.g. 40 for S-0-0040.
+	uint16_t ParamNum;
+} SISReactorParam;
+
+/// Last sample of a parameter.
+typedef struct SISReactorSample
+{
+	/// Value of the last successful read, scaled by the decimal places of the parameter.
+	double_t Value;
+	/// SIS error code of the last read, SISREACTOR_ERROR_LINK if the link failed, or 0 if succeeded.
+	uint16_t Error;
+	/// Time stamp of the last successful read in [ms] since system start, or 0 if none.
+	uint64_t Timestamp;
+	/// Number of completed sampling cycles of the link.
+	uint32_t Cycles;
+} SISReactorSample;
+#pragma pack(pop)
+
+
+/// Reactor that samples parameters of many drives cyclically from a single thread.
+///
+/// Each attached link is driven by a state machine (idle, writing, waiting for a receive event, reading) on overlapped
+/// I/O of its serial port. A single thread waits for the completions of all links at once, and advances the state
+/// machine of each completed link without blocking. Reaction timeouts and sampling intervals are kept in a timer
+/// wheel, so that the thread wakes only per SISREACTOR_TICK. Thus, dozens of drives on separate ports are served by a
+/// single thread instead of one thread per port.
+///
+/// The link of a drive is taken per telegram by SISLinkArbiter::try_lock(), and released after each reaction, so that
+/// exchanges of the application wait for one telegram of the reactor at most. Telegrams are postponed by one tick
+/// while the application holds the link.
+///
+/// Links over TCP gateways (CTCPSerial) are not supported, since they lack overlapped I/O.
+///
+/// @code{.cpp}
+/// SISReactor reactor;
+/// reactor.attach(SISProtocol_ref1, params, 100);
+/// reactor.attach(SISProtocol_ref2, params, 100);
+/// reactor.read(SISProtocol_ref1, samples, params.size());
+/// @endcode
+class SISReactor
+{
+public:
+	/// Constructor. The reactor thread is started.
+	SISReactor();
+	/// Destructor. All links are detached, and the reactor thread is stopped.
+	virtual ~SISReactor();
+
+	/// Attaches a link. The scaling of the parameters is read in before, by the calling thread.
+	///
+	/// @param [in]	_sis	 	SIS protocol reference of the drive. Has to be opened.
+	/// @param	   	_params  	Parameters to be sampled (up to SISREACTOR_PARAMS_MAX).
+	/// @param	   	_interval	Sampling interval in [ms].
+	void attach(SISProtocol * _sis, const std::vector<SISReactorParam>& _params, const DWORD _interval = SISREACTOR_INTERVAL_DEFAULT);
+
+	/// Detaches a link. Waits until a pending sampling cycle has been aborted, and the link has been released.
+	///
+	/// @param [in]	_sis	SIS protocol reference of the drive.
+	///
+	/// @return	True if the link was attached, false otherwise.
+	bool detach(SISProtocol * _sis);
+
+	/// Reads the last samples of a link.
+	///
+	/// @param [in]	_sis	 	SIS protocol reference of the drive.
+	/// @param [out]	_samples	Samples, in order of the parameters of attach().
+	/// @param	   	_len	 	Number of elements of _samples.
+	///
+	/// @return	Number of samples that have been read.
+	size_t read(SISProtocol * _sis, SISReactorSample _samples[], const size_t _len);
+
+	/// Gets the number of attached links.
+	///
+	/// @return	The number of links.
+	size_t get_count();
+
+private:
+	/// Values that represent the states of a link.
+	typedef enum State
+	{
+		/// Waiting for the next sampling cycle, or for the link to become free.
+		State_Idle,
+		/// Command telegram is being written.
+		State_Writing,
+		/// Waiting for a receive event.
+		State_Waiting,
+		/// Received bytes are being read.
+		State_Reading,
+		/// Pending operation is being cancelled due to a timeout or detach.
+		State_Cancelling
+	} State;
+
+	/// Link served by the reactor.
+	typedef struct Link
+	{
+		SISProtocol * Sis;
+		std::vector<SISReactorParam> Params;
+		std::vector<SISScaling> Scalings;
+		std::vector<SISReactorSample> Samples;
+		DWORD Interval;
+
+		State Status;
+		bool Detaching;
+		/// Set while a sampling cycle is in progress. The link is released between the telegrams of a cycle.
+		bool Cycling;
+		/// Serial port handle of the pending cycle, and the SIS link being held.
+		HANDLE Port;
+		bool Locked;
+		/// Parameter being read within the cycle.
+		size_t Current;
+		/// Start of the next sampling cycle in [ms] since system start.
+		ULONGLONG Due;
+		/// Generation of the armed timer. Timers of older generations are void.
+		uint64_t Timer;
+
+		/// Overlapped operation: Only one is pending at a time.
+		OVERLAPPED Overlapped;
+		DWORD EventMask;
+		TGM::Map<TGM::Header, TGM::Commands::SercosParam> Tx;
+		TGM::Map<TGM::Header, TGM::Reactions::SercosParam> Rx;
+		DWORD Received;
+	} Link;
+
+	/// Entry of the timer wheel.
+	typedef struct Timer
+	{
+		Link * Target;
+		uint64_t Generation;
+		ULONGLONG Deadline;
+	} Timer;
+
+	void run();
+	void expire(const ULONGLONG _now);
+	void arm(Link * _link, const ULONGLONG _deadline);
+	void fire(Link * _link, const ULONGLONG _now);
+
+	void begin_cycle(Link * _link, const ULONGLONG _now);
+	void end_cycle(Link * _link, const ULONGLONG _now);
+	void release(Link * _link);
+	void send(Link * _link, const ULONGLONG _now);
+	void wait_event(Link * _link, const ULONGLONG _now);
+	void receive(Link * _link, const ULONGLONG _now);
+	void complete(Link * _link, const ULONGLONG _now);
+	void evaluate(Link * _link, const size_t _len, const ULONGLONG _now);
+	void fail(Link * _link, const USHORT _error, const ULONGLONG _now);
+	void cancel(Link * _link);
+	void prepare(Link * _link);
+	bool remove(Link * _link);
+
+	std::vector<Link*>::iterator find(SISProtocol * _sis);
+
+private:
+	std::thread m_thread;
+	bool m_stop;
+	HANDLE m_wakeup;
+
+	std::mutex mutex_reactor;
+	std::condition_variable m_detached;
+	std::vector<Link*> m_links;
+
+	std::vector<Timer> m_wheel[SISREACTOR_SLOTS];
+	ULONGLONG m_tick;
+	uint64_t m_generation;
+};
+
+#endif /* _SISREACTOR_H_ */
@@ -0,0 +1,60 @@
+#include "SISResult.h"
+
+#include "debug.h"
+#include "helpers.h"
+
+
+
+SISResult::SISResult() :
+	m_kind(SISResult_OK),
+	m_status(0),
+	m_errorcode(0)
+{
+}
+
+
+SISResult::SISResult(const SISResultKind _kind, const int _status, const std::string& _context, const int _errorcode, const BYTE * _bytestream, const size_t _len) :
+	m_kind(_kind),
+	m_status(_status),
+	m_errorcode(_errorcode),
+	m_context(_context)
+{
+	if (_bytestream) m_bytestream.assign(_bytestream, _bytestream + _len);
+}
+
+
+const char * SISResult::get_message() const
+{
+	if (!m_message.empty() || m_kind == SISResult_OK) return m_message.c_str();
+
+	switch (m_kind)
+	{
+	case SISResult_Transceive:
+		m_message = sformat("SIS Protocol reception fail caused: STATUS=0x%04x (%d) ### MESSAGE='%s'", m_status, m_status, m_context.c_str());
+		break;
+
+	case SISResult_SISError:
+	{
+		std::string hexstream;
+		for (size_t i = 0; i < m_bytestream.size(); i++)
+			hexstream.append(sformat("%02X ", m_bytestream[i]));
+
+		m_message = sformat("(Return code: %d) SIS Protocol Error code returned has been received: 0x%04X.\nOriginal Telegram bytestream: %s", m_status, m_errorcode, hexstream.c_str());
+		break;
+	}
+
+	case SISResult_Serial:
+		m_message = sformat("CSerial exception caused %s: STATUS=%d, MESSAGE='%s'", Stack::GetTraceString().c_str(), m_status, m_context.c_str());
+		break;
+
+	default:
+		m_message = sformat("SIS Protocol exception caused: %s ### STATUS=0x%04x (%d) ### MESSAGE='%s'", Stack::GetTraceString().c_str(), m_status, m_status, m_context.c_str());
+		break;
+	}
+
+#ifndef NDEBUG
+	OutputDebugStringA((LPCSTR)m_message.c_str());
+#endif
+
+	return m_message.c_str();
+}
@@ -0,0 +1,79 @@
+/// @file
+/// Contains the result type of SIS operations, which carries error codes and context without formatting them.
+
+#ifndef _SISRESULT_H_
+#define _SISRESULT_H_
+
+#include <Windows.h>
+#include <string>
+#include <vector>
+
+
+/// Values that represent the kinds of SIS results.
+enum SISResultKind
+{
+	/// Operation succeeded.
+	SISResult_OK = 0,
+	/// Generic failure of the SIS protocol.
+	SISResult_Generic = 1,
+	/// Transceiving failed (timeout, line errors, or malformed telegrams).
+	SISResult_Transceive = 2,
+	/// Drive returned a SIS error code.
+	SISResult_SISError = 3,
+	/// Failure of the serial port.
+	SISResult_Serial = 4
+};
+
+
+/// Result of a SIS operation: Error codes plus structured context.
+///
+/// Failures are frequent in noisy environments (retries, timeouts), so the context is kept raw and formatted into a
+/// message only when get_message() is called. The message is cached afterwards.
+class SISResult
+{
+public:
+	SISResult();
+	SISResult(const SISResultKind _kind, const int _status, const std::string& _context, const int _errorcode = 0, const BYTE * _bytestream = NULL, const size_t _len = 0);
+
+	/// Checks if the operation succeeded.
+	///
+	/// @return	True if succeeded, false if failed.
+	bool ok() const { return m_kind == SISResult_OK; }
+
+	/// Gets the kind of the result.
+	///
+	/// @return	The kind.
+	SISResultKind get_kind() const { return m_kind; }
+
+	/// Gets the status code: SIS status, Win32 system error code, or -1 if unspecified.
+	///
+	/// @return	The status.
+	int get_status() const { return m_status; }
+
+	/// Gets the SIS error code returned by the drive (SISResult_SISError only).
+	///
+	/// @return	The error code.
+	int get_errorcode() const { return m_errorcode; }
+
+	/// Gets the raw command telegram that caused the failure, if any.
+	///
+	/// @return	The bytestream.
+	const std::vector<BYTE>& get_bytestream() const { return m_bytestream; }
+
+	/// Gets the message of the result. Formatted on the first call, and cached afterwards.
+	///
+	/// @return	The message. Empty if succeeded. Valid as long as the result exists.
+	const char * get_message() const;
+
+private:
+	SISResultKind m_kind;
+	int m_status;
+	int m_errorcode;
+	std::string m_context;
+	std::vector<BYTE> m_bytestream;
+
+	/// Formatted message. Empty until requested by get_message().
+	mutable std::string m_message;
+};
+
+#endif /* _SISRESULT_H_ */
@@ -0,0 +1,151 @@
+#include "SISScaling.h"
+
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+#include "SISProtocol.h"
+
+
+
+static const INT64 pow10_int[SISSCALING_POW10] =
+{
+	1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL, 100000000LL, 1000000000LL,
+	10000000000LL, 100000000000LL, 1000000000000LL, 10000000000000LL, 100000000000000LL, 1000000000000000LL,
+	10000000000000000LL, 100000000000000000LL, 1000000000000000000LL
+};
+
+
+template <typename T>
+static void decode_list_typed(const BYTE * _bytes, DOUBLE _values[], const size_t _count, const DOUBLE _scale)
+{
+	for (size_t i = 0; i < _count; i++)
+	{
+		T raw;
+		memcpy(&raw, _bytes + i * sizeof(T), sizeof(T));
+		_values[i] = static_cast<DOUBLE>(raw) / _scale;
+	}
+}
+
+
+template <typename T>
+static void encode_list_typed(const DOUBLE _values[], BYTE * _bytes, const size_t _count, const DOUBLE _scale)
+{
+	for (size_t i = 0; i < _count; i++)
+	{
+		T raw = static_cast<T>(llround(_values[i] * _scale));
+		memcpy(_bytes + i * sizeof(T), &raw, sizeof(T));
+	}
+}
+
+
+SISScaling::SISScaling() :
+	m_datalen(4),
+	m_scalefactor(0),
+	m_factor(1),
+	m_scale(1)
+{
+}
+
+
+SISScaling::SISScaling(const UINT32 _attribute)
+{
+	UINT8 scalefactor = 0;
+	SISProtocol::get_attribute_format(_attribute, scalefactor, m_datalen);
+
+	m_scalefactor = std::min<UINT8>(scalefactor, SISSCALING_POW10 - 1);
+	m_factor = pow10_int[m_scalefactor];
+	m_scale = static_cast<DOUBLE>(m_factor);
+}
+
+
+SISScaling::SISScaling(const size_t _datalen, const UINT8 _scalefactor) :
+	m_datalen(_datalen),
+	m_scalefactor(std::min<UINT8>(_scalefactor, SISSCALING_POW10 - 1))
+{
+	m_factor = pow10_int[m_scalefactor];
+	m_scale = static_cast<DOUBLE>(m_factor);
+}
+
+
+INT64 SISScaling::decode_raw(const BYTE * _bytes) const
+{
+	switch (m_datalen)
+	{
+	case 1: { int8_t raw; memcpy(&raw, _bytes, 1); return raw; }
+	case 2: { int16_t raw; memcpy(&raw, _bytes, 2); return raw; }
+	case 4: { int32_t raw; memcpy(&raw, _bytes, 4); return raw; }
+	default: { int64_t raw; memcpy(&raw, _bytes, 8); return raw; }
+	}
+}
+
+
+UINT64 SISScaling::decode_unsigned(const BYTE * _bytes) const
+{
+	UINT64 raw = 0;
+	memcpy(&raw, _bytes, std::min<size_t>(m_datalen, sizeof(raw)));
+
+	return raw;
+}
+
+
+DOUBLE SISScaling::decode(const BYTE * _bytes) const
+{
+	INT64 raw = decode_raw(_bytes);
+
+	// Division (instead of multiplying by 10^-n) is correctly rounded for the exactly representable powers of ten
+	return is_integer() ? static_cast<DOUBLE>(raw) : static_cast<DOUBLE>(raw) / m_scale;
+}
+
+
+TGM::Data SISScaling::encode_raw(const UINT64 _raw) const
+{
+	TGM::Data Bytes;
+	for (size_t b = 0; b < m_datalen; b++)
+		Bytes << (BYTE)((_raw >> (8 * b)) & 0xFF);
+
+	return Bytes;
+}
+
+
+TGM::Data SISScaling::encode(const DOUBLE _value) const
+{
+	// Negative values are kept in two's complement
+	return encode_raw(static_cast<UINT64>(llround(_value * m_scale)));
+}
+
+
+TGM::Data SISScaling::encode(const UINT64 _value) const
+{
+	return encode_raw(_value * static_cast<UINT64>(m_factor));
+}
+
+
+void SISScaling::decode_list(const BYTE * _bytes, DOUBLE _values[], const size_t _count) const
+{
+	switch (m_datalen)
+	{
+	case 1: decode_list_typed<int8_t>(_bytes, _values, _count, m_scale); break;
+	case 2: decode_list_typed<int16_t>(_bytes, _values, _count, m_scale); break;
+	case 4: decode_list_typed<int32_t>(_bytes, _values, _count, m_scale); break;
+	default: decode_list_typed<int64_t>(_bytes, _values, _count, m_scale); break;
+	}
+}
+
+
+void SISScaling::encode_list(const DOUBLE _values[], BYTE * _bytes, const size_t _count) const
+{
+	switch (m_datalen)
+	{
+	case 1: encode_list_typed<int8_t>(_values, _bytes, _count, m_scale); break;
+	case 2: encode_list_typed<int16_t>(_values, _bytes, _count, m_scale); break;
+	case 4: encode_list_typed<int32_t>(_values, _bytes, _count, m_scale); break;
+	default: encode_list_typed<int64_t>(_values, _bytes, _count, m_scale); break;
+	}
+}
+
+
+INT64 SISScaling::get_pow10(const UINT8 _scalefactor)
+{
+	return pow10_int[std::min<UINT8>(_scalefactor, SISSCALING_POW10 - 1)];
+}
@@ -0,0 +1,135 @@
+/// @file
+/// Contains the scaling descriptor that converts between SERCOS parameter data and values.
+
+#ifndef _SISSCALING_H_
+#define _SISSCALING_H_
+
+#include <Windows.h>
+#include <stdint.h>
+
+#include "Telegrams.h"
+
+
+/// Number of entries of the decimal scaling table: 10^0 ... 10^18, i.e. all powers of ten that fit into INT64.
+#define SISSCALING_POW10		19
+
+
+/// Conversion descriptor of a SERCOS parameter, resolved once from the parameter attribute.
+///
+/// Parameters without decimal places are converted by exact integer paths, so that 8-byte values do not lose
+/// precision above 2^53. Parameters with decimal places are scaled by tabled powers of ten instead of std::pow().
+/// List buffers are converted as a whole by loops that are specialized for the data length, so that the compiler can
+/// vectorize them.
+///
+/// @code{.cpp}
+/// SISScaling scaling = SISProtocol_ref->get_scaling(TGM::SercosParamS, 36);
+/// TGM::Data Bytes = scaling.encode(1000.0);
+/// DOUBLE speed = scaling.decode(Bytes.Bytes);
+/// @endcode
+class SISScaling
+{
+public:
+	/// Default constructor. 4-byte data without decimal places.
+	SISScaling();
+	/// Constructor.
+	///
+	/// @param	_attribute	SERCOS parameter attribute (Datablock_Attribute).
+	SISScaling(const UINT32 _attribute);
+	/// Constructor.
+	///
+	/// @param	_datalen		Data length in [bytes]: 1, 2, 4, or 8.
+	/// @param	_scalefactor	Decimal places.
+	SISScaling(const size_t _datalen, const UINT8 _scalefactor);
+
+	/// Gets the data length of the parameter, or of a list element, respectively.
+	///
+	/// @return	The data length in [bytes].
+	size_t get_datalen() const { return m_datalen; }
+
+	/// Gets the decimal places of the parameter.
+	///
+	/// @return	The scale factor.
+	UINT8 get_scalefactor() const { return m_scalefactor; }
+
+	/// Checks if the parameter has no decimal places, so that values are converted without floating point operations.
+	///
+	/// @return	True if integer, false if scaled.
+	bool is_integer() const { return m_scalefactor == 0; }
+
+	/// Decodes data bytes into the unscaled value, sign-extended by the data length.
+	///
+	/// @param	_bytes	Data bytes (little-endian), at least get_datalen() long.
+	///
+	/// @return	The unscaled value.
+	INT64 decode_raw(const BYTE * _bytes) const;
+
+	/// Decodes data bytes into the unscaled value, zero-extended by the data length.
+	///
+	/// @param	_bytes	Data bytes (little-endian), at least get_datalen() long.
+	///
+	/// @return	The unscaled value.
+	UINT64 decode_unsigned(const BYTE * _bytes) const;
+
+	/// Decodes data bytes into the value, scaled by the decimal places.
+	///
+	/// @param	_bytes	Data bytes (little-endian), at least get_datalen() long.
+	///
+	/// @return	The value.
+	DOUBLE decode(const BYTE * _bytes) const;
+
+	/// Encodes an unscaled value into data bytes of the data length.
+	///
+	/// @param	_raw	The unscaled value. Negative values are kept in two's complement.
+	///
+	/// @return	The data bytes.
+	TGM::Data encode_raw(const UINT64 _raw) const;
+
+	/// Encodes a value into data bytes. The value is scaled by the decimal places and rounded to the nearest integer.
+	///
+	/// @param	_value	The value.
+	///
+	/// @return	The data bytes.
+	TGM::Data encode(const DOUBLE _value) const;
+
+	/// Encodes an integer value into data bytes. The value is scaled by the decimal places exactly, without floating
+	/// point operations.
+	///
+	/// @param	_value	The value.
+	///
+	/// @return	The data bytes.
+	TGM::Data encode(const UINT64 _value) const;
+
+	/// Decodes a list buffer into values, scaled by the decimal places.
+	///
+	/// @param	_bytes 	List buffer (little-endian, without list header), at least _count * get_datalen() long.
+	/// @param	_values	Decoded values.
+	/// @param	_count 	Number of list elements.
+	void decode_list(const BYTE * _bytes, DOUBLE _values[], const size_t _count) const;
+
+	/// Encodes values into a list buffer. The values are scaled by the decimal places and rounded to the nearest
+	/// integer.
+	///
+	/// @param	_values	Values to be encoded.
+	/// @param	_bytes 	List buffer (little-endian, without list header), at least _count * get_datalen() long.
+	/// @param	_count 	Number of list elements.
+	void encode_list(const DOUBLE _values[], BYTE * _bytes, const size_t _count) const;
+
+	/// Gets a power of ten from the integer table.
+	///
+	/// @param	_scalefactor	Exponent. Limited to SISSCALING_POW10 - 1.
+	///
+	/// @return	10^_scalefactor.
+	static INT64 get_pow10(const UINT8 _scalefactor);
+
+private:
+	/// Data length in [bytes]: 1, 2, 4, or 8.
+	size_t m_datalen;
+	/// Decimal places, limited to SISSCALING_POW10 - 1.
+	UINT8 m_scalefactor;
+	/// 10^m_scalefactor as integer.
+	INT64 m_factor;
+	/// 10^m_scalefactor as floating point number.
+	DOUBLE m_scale;
+};
+
+#endif /* _SISSCALING_H_ */
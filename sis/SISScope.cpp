@@ -0,0 +1,108 @@
+#include "SISScope.h"
+
+#include "SISParamSession.h"
+
+
+
+SISScope::SISScope(SISProtocol * _sis) :
+	m_sis(_sis)
+{
+}
+
+
+SISScope::~SISScope()
+{
+}
+
+
+void SISScope::configure(const SISScopeConfig& _config)
+{
+	STACK;
+
+	SISParamSession session(m_sis, false);
+
+	// Signal selection (P-0-0023, P-0-0024) and trigger signal (P-0-0026) hold the IDN of the signal
+	for (size_t i = 0; i < SISSCOPE_CHANNELS; i++)
+	{
+		TGM::Bitfields::SercosParamIdent signal(_config.SignalVars[i] ? TGM::SercosParamP : TGM::SercosParamS, _config.SignalNums[i]);
+		session.write_parameter(TGM::SercosParamP, static_cast<USHORT>(23 + i), static_cast<UINT32>(signal.Value));
+	}
+
+	TGM::Bitfields::SercosParamIdent trigger(_config.TriggerVar ? TGM::SercosParamP : TGM::SercosParamS, _config.TriggerNum);
+	session.write_parameter(TGM::SercosParamP, 26, static_cast<UINT32>(trigger.Value));
+	session.write_parameter(TGM::SercosParamP, 27, static_cast<DOUBLE>(_config.TriggerLevel));
+	session.write_parameter(TGM::SercosParamP, 30, static_cast<UINT32>(_config.TriggerEdge));
+	session.write_parameter(TGM::SercosParamP, 31, static_cast<UINT32>(_config.Resolution));
+	session.write_parameter(TGM::SercosParamP, 32, static_cast<UINT32>(_config.Samples));
+	session.write_parameter(TGM::SercosParamP, 33, static_cast<UINT32>(_config.PostTrigger));
+
+	session.commit();
+}
+
+
+void SISScope::arm()
+{
+	STACK;
+
+	// Restart a previous recording, if any
+	m_sis->write_parameter(TGM::SercosParamP, 28, static_cast<UINT32>(0));
+	m_sis->write_parameter(TGM::SercosParamP, 28, static_cast<UINT32>(SISSCOPE_CTRL_ACTIVE | SISSCOPE_CTRL_TRIGGER));
+}
+
+
+UINT32 SISScope::get_status()
+{
+	STACK;
+
+	UINT32 status = 0;
+	m_sis->read_parameter(TGM::SercosParamP, 29, status);
+
+	return status;
+}
+
+
+void SISScope::wait(const DWORD _timeout)
+{
+	STACK;
+
+	ULONGLONG deadline = GetTickCount64() + _timeout;
+
+	while (!(get_status() & SISSCOPE_STAT_COMPLETE))
+	{
+		if (GetTickCount64() >= deadline)
+			throw SISProtocol::ExceptionGeneric(ERROR_TIMEOUT, sformat("Oscilloscope recording has not been completed within %u ms.", _timeout));
+
+		Sleep(SISSCOPE_WAIT_INTERVAL);
+	}
+}
+
+
+size_t SISScope::download(const uint8_t _channel, DOUBLE _values[], const size_t _len)
+{
+	STACK;
+
+	if (_channel >= SISSCOPE_CHANNELS)
+		throw SISProtocol::ExceptionGeneric(-1, sformat("Oscilloscope channel %u does not exist.", _channel));
+
+	// Recorded signal provides the decimal places, the memory list provides the data length
+	UINT32 ident = 0;
+	m_sis->read_parameter(TGM::SercosParamP, static_cast<USHORT>(23 + _channel), ident);
+
+	TGM::Bitfields::SercosParamIdent signal;
+	signal.Value = static_cast<USHORT>(ident);
+
+	USHORT list = static_cast<USHORT>(21 + _channel);
+	SISScaling scaling(
+		m_sis->get_scaling(TGM::SercosParamP, list).get_datalen(),
+		m_sis->get_scaling(signal.Bits.ParamVariant ? TGM::SercosParamP : TGM::SercosParamS, signal.Bits.ParamNumber).get_scalefactor());
+
+	size_t datalen = scaling.get_datalen();
+
+	std::vector<BYTE> data;
+	m_sis->read_list(TGM::SercosParamP, list, data, _len * datalen);
+
+	size_t count = data.size() / datalen;
+	scaling.decode_list(data.data(), _values, count);
+
+	return count;
+}
@@ -0,0 +1,110 @@
+/// @file
+/// Contains the oscilloscope access that records drive signals at the servo cycle and downloads them in bulk.
+
+#ifndef _SISSCOPE_H_
+#define _SISSCOPE_H_
+
+#include <Windows.h>
+#include <stdint.h>
+
+#include "debug.h"
+#include "SISProtocol.h"
+
+
+/// Number of oscilloscope channels.
+#define SISSCOPE_CHANNELS			2
+/// Polling interval in [ms] of the oscilloscope status word while waiting for the recording.
+#define SISSCOPE_WAIT_INTERVAL		10
+
+/// Oscilloscope control word (P-0-0028): Oscilloscope function active.
+#define SISSCOPE_CTRL_ACTIVE		(1 << 0)
+/// Oscilloscope control word (P-0-0028): Trigger active, i.e. the trigger event is awaited.
+#define SISSCOPE_CTRL_TRIGGER		(1 << 1)
+/// Oscilloscope status word (P-0-0029): Trigger event has occurred.
+#define SISSCOPE_STAT_TRIGGERED		(1 << 0)
+/// Oscilloscope status word (P-0-0029): Recording has been completed.
+#define SISSCOPE_STAT_COMPLETE		(1 << 1)
+
+
+#pragma pack(push,1)
+/// Configuration of the oscilloscope.
+typedef struct SISScopeConfig
+{
+	/// Parameter variants of the signals per channel (P-0-0023, P-0-0024): 0 for S-Parameter, 1 for P-Parameter.
+	uint8_t SignalVars[SISSCOPE_CHANNELS];
+	/// Parameter numbers of the signals per channel (P-0-0023, P-0-0024), e.g. 40 for S-0-0040.
+	uint16_t SignalNums[SISSCOPE_CHANNELS];
+	/// Parameter variant of the trigger signal (P-0-0026): 0 for S-Parameter, 1 for P-Parameter.
+	uint8_t TriggerVar;
+	/// Parameter number of the trigger signal (P-0-0026).
+	uint16_t TriggerNum;
+	/// Trigger level (P-0-0027).
+	double_t TriggerLevel;
+	/// Trigger edge (P-0-0030), as defined by the drive: e.g. 1 for rising, 2 for falling edge.
+	uint8_t TriggerEdge;
+	/// Time resolution in [us] (P-0-0031). Multiple of the servo cycle.
+	uint32_t Resolution;
+	/// Number of samples per channel (P-0-0032).
+	uint16_t Samples;
+	/// Number of samples recorded after the trigger event (P-0-0033).
+	uint16_t PostTrigger;
+} SISScopeConfig;
+#pragma pack(pop)
+
+
+/// Access to the internal oscilloscope of the drive.
+///
+/// The oscilloscope records up to SISSCOPE_CHANNELS signals at the servo cycle into memory lists (P-0-0021,
+/// P-0-0022). After the recording, the lists are downloaded by SISProtocol::read_list() in segments that fill whole
+/// telegrams, and decoded as a whole by the scaling of the recorded signals. Thus, traces with the resolution of the
+/// servo cycle are available even over slow serial links.
+///
+/// @code{.cpp}
+/// SISScope scope(SISProtocol_ref);
+/// scope.configure(config);
+/// scope.arm();
+/// scope.wait(5000);
+/// size_t count = scope.download(0, values, 1024);
+/// @endcode
+class SISScope
+{
+public:
+	/// Constructor.
+	///
+	/// @param [in]	_sis	SIS protocol reference of the drive.
+	SISScope(SISProtocol * _sis);
+	/// Destructor.
+	virtual ~SISScope();
+
+	/// Configures signals, trigger, and sampling of the oscilloscope. All parameters are written at once.
+	///
+	/// @param	_config	The configuration.
+	void configure(const SISScopeConfig& _config);
+
+	/// Arms the oscilloscope. Recording starts, and the trigger event is awaited.
+	void arm();
+
+	/// Reads the oscilloscope status word (P-0-0029).
+	///
+	/// @return	The status word. Refer to SISSCOPE_STAT_TRIGGERED and SISSCOPE_STAT_COMPLETE.
+	UINT32 get_status();
+
+	/// Waits until the recording has been completed.
+	///
+	/// @param	_timeout	Timeout in [ms]. Throws SISProtocol::ExceptionGeneric if exceeded.
+	void wait(const DWORD _timeout);
+
+	/// Downloads the recorded samples of a channel, scaled by the decimal places of the recorded signal.
+	///
+	/// @param	_channel	Channel (0 ... SISSCOPE_CHANNELS - 1).
+	/// @param	_values 	Recorded samples.
+	/// @param	_len		Number of elements of _values.
+	///
+	/// @return	Number of samples that have been downloaded.
+	size_t download(const uint8_t _channel, DOUBLE _values[], const size_t _len);
+
+private:
+	SISProtocol * m_sis;
+};
+
+#endif /* _SISSCOPE_H_ */
@@ -0,0 +1,123 @@
+#include "SISSpeedChannel.h"
+
+#include <string.h>
+
+
+
+SISSpeedChannel::SISSpeedChannel(SISProtocol * _sis) :
+	m_sis(_sis),
+	m_resolved(false)
+{
+	STACK;
+
+	// Control Mode (P-0-1200), Acceleration in rad/s^2 (P-0-1203), Speed in rpm (S-0-0036)
+	static const TGM::SercosParamVar paramvars[FieldCount] = { TGM::SercosParamP, TGM::SercosParamP, TGM::SercosParamS };
+	static const USHORT paramnums[FieldCount] = { 1200, 1203, 36 };
+
+	for (size_t i = 0; i < FieldCount; i++)
+	{
+		m_fields[i].ParamVar = paramvars[i];
+		m_fields[i].ParamNum = paramnums[i];
+		m_fields[i].Valid = false;
+	}
+
+	resolve();
+}
+
+
+SISSpeedChannel::~SISSpeedChannel()
+{
+}
+
+
+void SISSpeedChannel::write(const DOUBLE _speed, const DOUBLE _accel)
+{
+	STACK;
+
+	std::lock_guard<std::mutex> lock(mutex_channel);
+
+	// Setpoints overtake polls and bulk transfers waiting for the link
+	SISPriorityScope priority(SISPriority_Setpoint);
+
+	// Scaling parameters might have been written meanwhile
+	if (!m_resolved) resolve();
+
+	// Encoded values, same as written by speedcontrol_write() (SISProtocol::write_parameter()).
+	// Rotation direction - Positive _speed: Clockwise rotation, Negative _speed: Counter-clockwise rotation
+	TGM::Data values[FieldCount];
+	values[FieldDirection] = m_fields[FieldDirection].Scaling.encode(static_cast<UINT64>((stde::sgn<DOUBLE>(_speed) == 1 ? 0 : 1) << 10));
+	values[FieldAccel] = m_fields[FieldAccel].Scaling.encode(_accel);
+	values[FieldSpeed] = m_fields[FieldSpeed].Scaling.encode(abs(_speed));
+
+	// Changed fields only, in the order direction, acceleration, speed
+	std::vector<SISProtocol::SercosRequest> requests;
+	std::vector<size_t> fields;
+	for (size_t i = 0; i < FieldCount; i++)
+	{
+		if (m_fields[i].Valid && is_equal(m_fields[i].LastData, values[i])) continue;
+
+		requests.push_back(SISProtocol::SercosRequest(SISProtocol::SIS_SERVICE_SERCOS_PARAM_WRITE, m_fields[i].ParamVar, m_fields[i].ParamNum, TGM::Datablock_OperationData, values[i], 0));
+		fields.push_back(i);
+	}
+
+	if (requests.empty()) return;
+
+	try
+	{
+		m_sis->transceive_sequential(requests);
+	}
+	catch (...)
+	{
+		// State of the drive is unknown now
+		for (size_t i = 0; i < FieldCount; i++) m_fields[i].Valid = false;
+		throw;
+	}
+
+	std::string failed;
+	int status = 0;
+	for (size_t i = 0; i < requests.size(); i++)
+	{
+		Field& field = m_fields[fields[i]];
+
+		field.Valid = (requests[i].Error == 0);
+		field.LastData = values[fields[i]];
+		if (field.Valid) continue;
+
+		failed.append(sformat("%c-0-%04d (0x%04X) ", field.ParamVar == TGM::SercosParamS ? 'S' : 'P', field.ParamNum, requests[i].Error));
+		status = requests[i].Error;
+	}
+
+	if (!failed.empty())
+		throw SISProtocol::ExceptionGeneric(status, sformat("Writing speed setpoint failed: %s", failed.c_str()));
+}
+
+
+void SISSpeedChannel::invalidate()
+{
+	STACK;
+
+	std::lock_guard<std::mutex> lock(mutex_channel);
+
+	for (size_t i = 0; i < FieldCount; i++) m_fields[i].Valid = false;
+
+	// Resolved again by the next write, since the decimal places might have been changed (e.g. by S-0-0044)
+	m_resolved = false;
+}
+
+
+void SISSpeedChannel::resolve()
+{
+	STACK;
+
+	// Attributes are read only if not cached. The cache is cleared by writes of scaling parameters.
+	for (size_t i = 0; i < FieldCount; i++)
+		m_fields[i].Scaling = m_sis->get_scaling(m_fields[i].ParamVar, m_fields[i].ParamNum);
+
+	m_resolved = true;
+}
+
+
+bool SISSpeedChannel::is_equal(const TGM::Data& _a, const TGM::Data& _b)
+{
+	return _a.Size == _b.Size && memcmp(_a.Bytes, _b.Bytes, _a.Size) == 0;
+}
@@ -0,0 +1,76 @@
+/// @file
+/// Contains the speed setpoint channel that writes speed setpoints with a minimal number of telegrams.
+
+#ifndef _SISSPEEDCHANNEL_H_
+#define _SISSPEEDCHANNEL_H_
+
+#include <Windows.h>
+#include <vector>
+#include <mutex>
+
+#include "debug.h"
+#include "helpers.h"
+#include "SISProtocol.h"
+
+
+/// Speed setpoint channel for drive mode "Speed Control".
+///
+/// A setpoint consists of rotation direction (P-0-1200), acceleration (P-0-1203) and speed (S-0-0036). The scalings
+/// of these parameters are resolved on construction and after invalidate() (SISProtocol::get_scaling()), so that
+/// writing a setpoint does not need any attribute reads otherwise. Values are encoded like speedcontrol_write() does.
+/// Only fields whose encoded value differs from the last written one are transmitted; usually this is the speed only.
+/// Several changed fields are transmitted in a single telegram (SIS service 0x04).
+///
+/// @code{.cpp}
+/// SISSpeedChannel channel(SISProtocol_ref);
+/// channel.write(1000, 10);
+/// channel.write(1200, 10);	// Transmits S-0-0036 only
+/// @endcode.
+///
+/// @remarks	The channel assumes to be the only writer of these parameters. If they, or their scaling parameters
+/// 			(e.g. S-0-0044), are written by other means, invalidate() has to be called.
+class SISSpeedChannel
+{
+public:
+	/// Constructor. Resolves the scalings of P-0-1200, P-0-1203 and S-0-0036.
+	///
+	/// @param [in]	_sis	SIS protocol reference the setpoints are written to.
+	SISSpeedChannel(SISProtocol * _sis);
+	/// Destructor.
+	virtual ~SISSpeedChannel();
+
+	void write(const DOUBLE _speed, const DOUBLE _accel);
+	void invalidate();
+
+private:
+	/// Setpoint field with pre-resolved encoding.
+	typedef struct Field
+	{
+		/// SERCOS Parameter variant (S, or P).
+		TGM::SercosParamVar ParamVar;
+		/// SERCOS Parameter number.
+		USHORT ParamNum;
+		/// Scaling of the parameter.
+		SISScaling Scaling;
+		/// Encoded value that has been written last.
+		TGM::Data LastData;
+		/// True if LastValue holds the value that is present on the drive.
+		bool Valid;
+	} Field;
+
+	enum { FieldDirection = 0, FieldAccel = 1, FieldSpeed = 2, FieldCount = 3 };
+
+	void resolve();
+	static bool is_equal(const TGM::Data& _a, const TGM::Data& _b);
+
+private:
+	SISProtocol * m_sis;
+
+	Field m_fields[FieldCount];
+	/// Set if the scalings of the fields are up to date. Cleared by invalidate().
+	bool m_resolved;
+
+	std::mutex mutex_channel;
+};
+
+#endif /* _SISSPEEDCHANNEL_H_ */
@@ -0,0 +1,233 @@
+#include "SISSpeedStreamer.h"
+
+#include <mmsystem.h>
+
+#pragma comment(lib, "winmm.lib")
+
+
+
+SISSpeedStreamer::SISSpeedStreamer(SISProtocol * _sis) :
+	m_sis(_sis),
+	m_channel(NULL),
+	m_stop(true),
+	m_period(SISSTREAMER_PERIOD_DEFAULT),
+	m_jitter_sum(0)
+{
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	m_frequency = frequency.QuadPart;
+
+	memset(&m_stats, 0, sizeof(m_stats));
+}
+
+
+SISSpeedStreamer::~SISSpeedStreamer()
+{
+	stop();
+}
+
+
+void SISSpeedStreamer::start(DWORD _period)
+{
+	STACK;
+
+	stop();
+
+	if (!_period)
+		throw SISProtocol::ExceptionGeneric(0, "Streaming period must be greater than 0 ms.");
+
+	// Resolving the setpoint parameters before streaming, so that errors are reported to the caller
+	m_channel = new SISSpeedChannel(m_sis);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_streamer);
+
+		memset(&m_stats, 0, sizeof(m_stats));
+		m_stats.Running = 1;
+		m_jitter_sum = 0;
+		m_error.clear();
+	}
+
+	m_period = _period;
+	m_stop = false;
+
+	m_streamer = std::thread(&SISSpeedStreamer::run, this);
+}
+
+
+void SISSpeedStreamer::stop()
+{
+	STACK;
+
+	m_stop = true;
+
+	if (m_streamer.joinable())
+		m_streamer.join();
+
+	delete m_channel;
+	m_channel = NULL;
+
+	std::lock_guard<std::mutex> lock(mutex_streamer);
+	m_profile.clear();
+}
+
+
+void SISSpeedStreamer::enqueue(const UINT32 _time, const DOUBLE _speed, const DOUBLE _accel)
+{
+	STACK;
+
+	std::lock_guard<std::mutex> lock(mutex_streamer);
+
+	if (m_profile.size() >= SISSTREAMER_QUEUE_SIZE)
+		throw SISProtocol::ExceptionGeneric(0, sformat("Profile exceeds the maximum of %d pending setpoints.", SISSTREAMER_QUEUE_SIZE));
+
+	if (!m_profile.empty() && _time < m_profile.back().Time)
+		throw SISProtocol::ExceptionGeneric(0, sformat("Setpoint time %u ms is earlier than the previous setpoint (%u ms).", _time, m_profile.back().Time));
+
+	Setpoint setpoint;
+	setpoint.Time = _time;
+	setpoint.Speed = _speed;
+	setpoint.Accel = _accel;
+
+	m_profile.push_back(setpoint);
+}
+
+
+SISStreamStats SISSpeedStreamer::get_stats(std::string& _error)
+{
+	STACK;
+
+	std::lock_guard<std::mutex> lock(mutex_streamer);
+
+	SISStreamStats stats = m_stats;
+	stats.Pending = static_cast<uint32_t>(m_profile.size());
+	stats.JitterMean = m_stats.Periods ? m_jitter_sum / m_stats.Periods : 0;
+
+	_error = m_error;
+
+	return stats;
+}
+
+
+void SISSpeedStreamer::invalidate()
+{
+	STACK;
+
+	if (m_channel) m_channel->invalidate();
+}
+
+
+void SISSpeedStreamer::run()
+{
+	STACK;
+
+	SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+
+	// High resolution timers are available since Windows 10, version 1803. Otherwise, the system timer resolution is
+	// raised for the time of streaming.
+	bool coarse = false;
+	HANDLE timer = CreateWaitableTimerEx(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+	if (!timer)
+	{
+		timer = CreateWaitableTimer(NULL, TRUE, NULL);
+		timeBeginPeriod(1);
+		coarse = true;
+	}
+
+	const LONGLONG period = m_frequency * m_period / 1000;
+	const LONGLONG start = now();
+	LONGLONG cycle = 0;
+
+	while (!m_stop)
+	{
+		// Deadlines are derived from the start time, so that delays do not accumulate
+		const LONGLONG deadline = start + cycle * period;
+		wait_until(timer, deadline);
+		if (m_stop) break;
+
+		const LONGLONG t_wakeup = now();
+		const double jitter = static_cast<double>(t_wakeup - deadline) * 1e6 / m_frequency;
+		const UINT32 elapsed = static_cast<UINT32>((t_wakeup - start) * 1000 / m_frequency);
+
+		// Latest due setpoint. Setpoints that have been superseded within the same period are dropped.
+		bool due = false;
+		Setpoint setpoint;
+		{
+			std::lock_guard<std::mutex> lock(mutex_streamer);
+
+			while (!m_profile.empty() && m_profile.front().Time <= elapsed)
+			{
+				setpoint = m_profile.front();
+				m_profile.pop_front();
+				due = true;
+			}
+
+			m_stats.Periods++;
+			m_jitter_sum += jitter;
+			m_stats.JitterMax = std::max<double>(m_stats.JitterMax, jitter);
+		}
+
+		if (due)
+		{
+			try
+			{
+				m_channel->write(setpoint.Speed, setpoint.Accel);
+			}
+			catch (std::exception &ex)
+			{
+				std::lock_guard<std::mutex> lock(mutex_streamer);
+				m_error = ex.what();
+				break;
+			}
+
+			const double duration = static_cast<double>(now() - t_wakeup) * 1e6 / m_frequency;
+
+			std::lock_guard<std::mutex> lock(mutex_streamer);
+			m_stats.Sent++;
+			m_stats.SendMax = std::max<double>(m_stats.SendMax, duration);
+		}
+
+		// Periods whose deadline has already passed are skipped and counted as missed
+		cycle++;
+		const LONGLONG t_done = now();
+		if (t_done > start + cycle * period)
+		{
+			LONGLONG missed = (t_done - start) / period - cycle + 1;
+			cycle += missed;
+
+			std::lock_guard<std::mutex> lock(mutex_streamer);
+			m_stats.Missed += static_cast<uint32_t>(missed);
+		}
+	}
+
+	if (coarse) timeEndPeriod(1);
+	if (timer) CloseHandle(timer);
+
+	std::lock_guard<std::mutex> lock(mutex_streamer);
+	m_stats.Running = 0;
+}
+
+
+void SISSpeedStreamer::wait_until(HANDLE _timer, const LONGLONG _deadline)
+{
+	LONGLONG remaining = _deadline - now();
+	if (remaining <= 0) return;
+
+	// Due time in 100 ns intervals. Negative values represent relative time.
+	LARGE_INTEGER due;
+	due.QuadPart = -(remaining * 10000000 / m_frequency);
+
+	if (!_timer || !SetWaitableTimer(_timer, &due, 0, NULL, NULL, FALSE))
+		Sleep(static_cast<DWORD>(remaining * 1000 / m_frequency));
+	else
+		WaitForSingleObject(_timer, INFINITE);
+}
+
+
+LONGLONG SISSpeedStreamer::now() const
+{
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+
+	return counter.QuadPart;
+}
@@ -0,0 +1,111 @@
+/// @file
+/// Contains the speed setpoint streamer that emits a speed profile at a fixed period.
+
+#ifndef _SISSPEEDSTREAMER_H_
+#define _SISSPEEDSTREAMER_H_
+
+#include <Windows.h>
+#include <stdint.h>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <string>
+
+#include "debug.h"
+#include "helpers.h"
+#include "SISProtocol.h"
+#include "SISSpeedChannel.h"
+
+
+/// Maximum number of profile points held by the streamer.
+#define SISSTREAMER_QUEUE_SIZE		4096
+/// Default streaming period in [ms].
+#define SISSTREAMER_PERIOD_DEFAULT	10
+
+
+#pragma pack(push,1)
+/// Streaming statistics.
+typedef struct SISStreamStats
+{
+	/// Number of periods elapsed since start.
+	uint32_t Periods;
+	/// Number of setpoints that have been transmitted (unchanged setpoints are not transmitted).
+	uint32_t Sent;
+	/// Number of periods missed, since the previous period took longer than the period time.
+	uint32_t Missed;
+	/// Number of profile points not yet due.
+	uint32_t Pending;
+	/// Mean send jitter (delay of the send against its deadline) in [us].
+	double_t JitterMean;
+	/// Maximum send jitter in [us].
+	double_t JitterMax;
+	/// Maximum duration of a transmission in [us].
+	double_t SendMax;
+	/// 1 if streaming is running, 0 if stopped or failed.
+	uint8_t Running;
+} SISStreamStats;
+#pragma pack(pop)
+
+
+/// Speed setpoint streamer for drive mode "Speed Control".
+///
+/// The client enqueues a profile of timestamped setpoints. A dedicated thread with time-critical priority wakes up at
+/// a fixed period, using deadlines that are derived from the start time (no accumulation of delays), and writes the
+/// latest due setpoint by SISSpeedChannel. Send jitter and missed periods are measured.
+///
+/// @remarks	Streaming stops on the first communication error. The error is reported by get_stats().
+class SISSpeedStreamer
+{
+public:
+	/// Constructor.
+	///
+	/// @param [in]	_sis	SIS protocol reference the setpoints are written to.
+	SISSpeedStreamer(SISProtocol * _sis);
+	/// Destructor. Stops streaming.
+	virtual ~SISSpeedStreamer();
+
+	void start(DWORD _period = SISSTREAMER_PERIOD_DEFAULT);
+	void stop();
+
+	void enqueue(const UINT32 _time, const DOUBLE _speed, const DOUBLE _accel);
+	SISStreamStats get_stats(std::string& _error);
+
+	/// Invalidates the values last written by the streamer, so that its next write transmits all fields (see
+	/// SISSpeedChannel::invalidate()). Has no effect if streaming is not started.
+	void invalidate();
+
+private:
+	/// Profile point.
+	typedef struct Setpoint
+	{
+		/// Due time in [ms], relative to the start of streaming.
+		UINT32 Time;
+		/// Target speed in [1/min]. Sign represents the rotation direction.
+		DOUBLE Speed;
+		/// Target acceleration in [rad/s^2].
+		DOUBLE Accel;
+	} Setpoint;
+
+	void run();
+	void wait_until(HANDLE _timer, const LONGLONG _deadline);
+	LONGLONG now() const;
+
+private:
+	SISProtocol * m_sis;
+	SISSpeedChannel * m_channel;
+
+	std::thread m_streamer;
+	std::atomic<bool> m_stop;
+	DWORD m_period;
+	/// Performance counter ticks per second.
+	LONGLONG m_frequency;
+
+	std::mutex mutex_streamer;
+	std::deque<Setpoint> m_profile;
+	SISStreamStats m_stats;
+	double m_jitter_sum;
+	std::string m_error;
+};
+
+#endif /* _SISSPEEDSTREAMER_H_ */
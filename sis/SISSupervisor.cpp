@@ -0,0 +1,86 @@
+#include "SISSupervisor.h"
+
+
+
+SISSupervisor::SISSupervisor(SISProtocol * _sis) :
+	m_sis(_sis),
+	m_stop(true),
+	m_interval(SISSUPERVISOR_INTERVAL_DEFAULT)
+{
+}
+
+
+SISSupervisor::~SISSupervisor()
+{
+	stop();
+}
+
+
+void SISSupervisor::start(DWORD _interval)
+{
+	STACK;
+
+	stop();
+
+	m_interval = _interval;
+	m_stop = false;
+
+	m_sis->set_reconnect(true);
+
+	m_keeper = std::thread(&SISSupervisor::run, this);
+}
+
+
+void SISSupervisor::stop()
+{
+	STACK;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_supervisor);
+		m_stop = true;
+	}
+	m_wakeup.notify_all();
+
+	if (m_keeper.joinable())
+	{
+		m_keeper.join();
+		m_sis->set_reconnect(false);
+	}
+}
+
+
+void SISSupervisor::run()
+{
+	STACK;
+
+	while (!m_stop)
+	{
+		// Application exchanges serve as keepalive as well
+		if (m_sis->get_idle_time() >= m_interval)
+			keepalive();
+
+		// Waiting for next keepalive, but wake up immediately on stop()
+		std::unique_lock<std::mutex> lock(mutex_supervisor);
+		m_wakeup.wait_for(lock, std::chrono::milliseconds(m_interval), [this] { return (bool)m_stop; });
+	}
+}
+
+
+void SISSupervisor::keepalive()
+{
+	STACK;
+
+	SISPriorityScope priority(SISPriority_Poll);
+
+	try
+	{
+		// Fails only if the link could not be restored. Thus, the next keepalive tries again.
+		m_sis->read_diagnostic_num();
+	}
+	catch (SISProtocol::ExceptionGeneric &)
+	{
+	}
+	catch (CSerial::ExceptionGeneric &)
+	{
+	}
+}
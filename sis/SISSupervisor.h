@@ -0,0 +1,67 @@
+/// @file
+/// Contains the connection supervisor that detects link losses by keepalive reads, and restores the link.
+
+#ifndef _SISSUPERVISOR_H_
+#define _SISSUPERVISOR_H_
+
+#include <Windows.h>
+#include <stdint.h>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+
+#include "debug.h"
+#include "SISProtocol.h"
+
+
+/// Default keepalive interval in [ms].
+#define SISSUPERVISOR_INTERVAL_DEFAULT	500
+
+
+/// Connection supervisor that keeps the link of a drive alive.
+///
+/// While running, the transparent reconnect of the SIS protocol is enabled (see SISProtocol::set_reconnect()). If the
+/// link has been idle for the keepalive interval, the diagnostic number (S-0-0390) is read as keepalive. Thus, a lost
+/// link is detected and restored even if the application does not communicate, and exchanges of the application are
+/// recovered transparently otherwise. If the link cannot be restored, every keepalive tries again.
+///
+/// @code{.cpp}
+/// SISSupervisor supervisor(SISProtocol_ref);
+/// supervisor.start(500);
+/// SISLinkHealth health = SISProtocol_ref->get_link_health();
+/// @endcode
+class SISSupervisor
+{
+public:
+	/// Constructor.
+	///
+	/// @param [in]	_sis	SIS protocol reference to be supervised.
+	SISSupervisor(SISProtocol * _sis);
+	/// Destructor. Stops supervising.
+	virtual ~SISSupervisor();
+
+	/// Starts supervising, and enables the transparent reconnect.
+	///
+	/// @param	_interval	(Optional) Keepalive interval in [ms].
+	void start(DWORD _interval = SISSUPERVISOR_INTERVAL_DEFAULT);
+
+	/// Stops supervising, and disables the transparent reconnect.
+	void stop();
+
+private:
+	void run();
+	void keepalive();
+
+private:
+	SISProtocol * m_sis;
+
+	std::thread m_keeper;
+	std::atomic<bool> m_stop;
+	DWORD m_interval;
+
+	std::mutex mutex_supervisor;
+	std::condition_variable m_wakeup;
+};
+
+#endif /* _SISSUPERVISOR_H_ */
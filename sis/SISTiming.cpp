@@ -0,0 +1,96 @@
+#include "SISTiming.h"
+
+#include <string.h>
+
+
+
+SISLatencyHistogram::SISLatencyHistogram()
+{
+	reset();
+}
+
+
+void SISLatencyHistogram::record(const double _latency)
+{
+	double latency = _latency < 0 ? 0 : _latency;
+
+	m_buckets[get_bucket(latency >= (double)UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(latency))]++;
+
+	m_min = m_count ? (latency < m_min ? latency : m_min) : latency;
+	m_max = m_count ? (latency > m_max ? latency : m_max) : latency;
+	m_sum += latency;
+	m_count++;
+}
+
+
+void SISLatencyHistogram::reset()
+{
+	memset(m_buckets, 0, sizeof(m_buckets));
+	m_count = 0;
+	m_sum = 0;
+	m_min = 0;
+	m_max = 0;
+}
+
+
+SISLatency SISLatencyHistogram::get() const
+{
+	SISLatency latency;
+	latency.Count = m_count;
+	latency.Mean = m_count ? m_sum / m_count : 0;
+	latency.Min = m_min;
+	latency.Max = m_max;
+	latency.P50 = get_percentile(0.50);
+	latency.P90 = get_percentile(0.90);
+	latency.P99 = get_percentile(0.99);
+
+	return latency;
+}
+
+
+size_t SISLatencyHistogram::get_bucket(const uint32_t _latency)
+{
+	if (_latency < SISTIMING_LINEAR) return _latency;
+
+	// Index of the highest bit set (>= 4), and the next 3 bits below as sub-bucket
+	size_t exponent = 4;
+	while (exponent < 31 && (_latency >> (exponent + 1))) exponent++;
+
+	size_t sub = (_latency >> (exponent - 3)) & (SISTIMING_SUBBUCKETS - 1);
+	size_t bucket = SISTIMING_LINEAR + (exponent - 4) * SISTIMING_SUBBUCKETS + sub;
+
+	return bucket < SISTIMING_BUCKETS ? bucket : SISTIMING_BUCKETS - 1;
+}
+
+
+double SISLatencyHistogram::get_bucket_value(const size_t _bucket)
+{
+	if (_bucket < SISTIMING_LINEAR) return static_cast<double>(_bucket);
+
+	size_t exponent = 4 + (_bucket - SISTIMING_LINEAR) / SISTIMING_SUBBUCKETS;
+	size_t sub = (_bucket - SISTIMING_LINEAR) % SISTIMING_SUBBUCKETS;
+
+	// Middle of the bucket
+	return ldexp(1.0 + (sub + 0.5) / SISTIMING_SUBBUCKETS, static_cast<int>(exponent));
+}
+
+
+double SISLatencyHistogram::get_percentile(const double _percentile) const
+{
+	if (!m_count) return 0;
+
+	uint32_t rank = static_cast<uint32_t>(ceil(_percentile * m_count));
+	uint32_t seen = 0;
+
+	for (size_t b = 0; b < SISTIMING_BUCKETS; b++)
+	{
+		seen += m_buckets[b];
+		if (seen < rank) continue;
+
+		// Bucket values are approximations, which are kept within the measured range
+		double value = get_bucket_value(b);
+		return value < m_min ? m_min : (value > m_max ? m_max : value);
+	}
+
+	return m_max;
+}
@@ -0,0 +1,78 @@
+/// @file
+/// Contains the latency histogram that is used to measure the timing of SIS telegram exchanges.
+
+#ifndef _SISTIMING_H_
+#define _SISTIMING_H_
+
+#include <Windows.h>
+#include <stdint.h>
+#include <math.h>
+
+
+/// Number of linear buckets of the latency histogram, 1 us each.
+#define SISTIMING_LINEAR		16
+/// Number of sub-buckets per power of two of the latency histogram.
+#define SISTIMING_SUBBUCKETS	8
+/// Number of buckets of the latency histogram. Covers latencies up to 2^31 us.
+#define SISTIMING_BUCKETS		(SISTIMING_LINEAR + (31 - 4) * SISTIMING_SUBBUCKETS)
+
+
+#pragma pack(push,1)
+/// Latency distribution. All times in [us].
+typedef struct SISLatency
+{
+	/// Number of measurements.
+	uint32_t Count;
+	/// Mean latency.
+	double_t Mean;
+	/// Minimum latency.
+	double_t Min;
+	/// Maximum latency.
+	double_t Max;
+	/// Median latency (50th percentile).
+	double_t P50;
+	/// 90th percentile of the latency.
+	double_t P90;
+	/// 99th percentile of the latency.
+	double_t P99;
+} SISLatency;
+
+/// Timing of the SIS telegram exchanges.
+typedef struct SISLinkTiming
+{
+	/// Baud rate of the serial line.
+	uint32_t Baudrate;
+	/// Time from the request of an exchange until the first byte of the command telegram is handed to the serial
+	/// port. Covers waiting for other exchanges in progress.
+	SISLatency ToFirstByte;
+	/// Time from the request of an exchange until the reaction telegram has been received completely.
+	SISLatency ToAck;
+} SISLinkTiming;
+#pragma pack(pop)
+
+
+/// Latency histogram with logarithmic buckets: Latencies below 16 us are kept exactly, larger latencies with a
+/// relative resolution of 1/8 (12.5%). Recording takes constant time and no allocation.
+class SISLatencyHistogram
+{
+public:
+	SISLatencyHistogram();
+
+	void record(const double _latency);
+	void reset();
+	SISLatency get() const;
+
+private:
+	static size_t get_bucket(const uint32_t _latency);
+	static double get_bucket_value(const size_t _bucket);
+	double get_percentile(const double _percentile) const;
+
+private:
+	uint32_t m_buckets[SISTIMING_BUCKETS];
+	uint32_t m_count;
+	double m_sum;
+	double m_min;
+	double m_max;
+};
+
+#endif /* _SISTIMING_H_ */
@@ -94,7 +94,7 @@ namespace TGM
 			operator<<((_data & 0xFF00000000) >> 32);
 			operator<<((_data & 0xFF0000000000) >> 40);
 			operator<<((_data & 0xFF000000000000) >> 48);
-			operator<<((_data & 0xFF00000000000000) >> 54);
+			operator<<((_data & 0xFF00000000000000) >> 56);
 		}
 
 		/// Ats the given index.
@@ -622,6 +622,39 @@ namespace TGM
 
 		}  SercosList;
 #pragma pack(pop)
+
+#pragma pack(push,1)
+		/// Representation of the PAYLOAD for a sequential command (SIS service 0x04). The payload is a list of
+		/// regular SIS requests, each one prefixed by its length: [n][service][payload head + data of the service],
+		/// whereas n covers the service byte and the service's payload. There is no additional recipient address,
+		/// since it is already part of every single request.
+		typedef struct Sequential
+		{
+			/// Concatenated SIS requests.
+			Data Bytes;
+
+			/// Constructor.
+			///
+			/// @param	_data	(Optional) Concatenated SIS requests.
+			Sequential(Data _data = Data()) :
+				Bytes(_data)
+			{}
+
+			/// Clears this object to its blank/initial state.
+			void clear() { Bytes.clear(); }
+
+			/// Gets size of Payload Header
+			///
+			/// @return	The Payload Header size.
+			size_t get_head_size() { return 0; }
+
+			/// Gets the Payload size including Payload Header size.
+			///
+			/// @return	The Payload size.
+			size_t get_size() { return get_head_size() + Bytes.get_size(); }
+
+		} Sequential;
+#pragma pack(pop)
 	}
 
 
@@ -677,6 +710,11 @@ namespace TGM
 			/// @return	The Payload size.
 			size_t get_size() { return get_head_size() + Bytes.get_size(); }
 
+			/// Query if the reaction reports an error. The error code is then stored in Error.
+			///
+			/// @return	True if error, false if not.
+			bool has_error() { return Status != 0; }
+
 		} Subservice;
 #pragma pack(pop)
 
@@ -731,6 +769,11 @@ namespace TGM
 			/// @return	The Payload size.
 			size_t get_size() { return get_head_size() + Bytes.get_size(); }
 
+			/// Query if the reaction reports an error. The error code is then stored in Error.
+			///
+			/// @return	True if error, false if not.
+			bool has_error() { return Status != 0; }
+
 		} SercosParam;
 #pragma pack(pop)
 
@@ -783,8 +826,61 @@ namespace TGM
 			/// @return	The Payload size.
 			size_t get_size() { return get_head_size() + Bytes.get_size(); }
 
+			/// Query if the reaction reports an error. The error code is then stored in Error.
+			///
+			/// @return	True if error, false if not.
+			bool has_error() { return Status != 0; }
+
 		}  SercosList;
 #pragma pack(pop)
+
+#pragma pack(push,1)
+		/// Representation of the payload for a sequential reaction (SIS service 0x04). The payload starts with an
+		/// overall status byte, followed by the reactions of every single request: [k][service][status][payload head +
+		/// data of the service], whereas k covers all bytes after the length byte.
+		typedef struct Sequential
+		{
+			/// Overall status: 0 if all requests succeeded, 1 if at least one request failed.
+			BYTE Status;
+
+			/// Concatenated SIS reactions, or error code.
+			union
+			{
+				Data	Bytes;
+				USHORT	Error;
+			};
+
+			/// Default constructor.
+			Sequential() :
+				Status(1),
+				Bytes(TGM::Data())
+			{}
+
+			/// Clears this object to its blank/initial state.
+			void clear()
+			{
+				Status = 1;
+				Bytes.clear();
+			}
+
+			/// Gets payload header size.
+			///
+			/// @return	The payload header size.
+			size_t get_head_size() { return 1; }
+
+			/// Gets the Payload size including Payload Header size.
+			///
+			/// @return	The Payload size.
+			size_t get_size() { return get_head_size() + Bytes.get_size(); }
+
+			/// Query if the reaction reports an error. Always false, since the reactions of the single requests are
+			/// delivered even if the overall status is set. Those have to be evaluated one by one.
+			///
+			/// @return	False.
+			bool has_error() { return false; }
+
+		} Sequential;
+#pragma pack(pop)
 	}
 }
 